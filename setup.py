@@ -8,6 +8,10 @@ from distutils.core import setup, Extension
 sources = ['src/llist.c',
            'src/dllist.c',
            'src/sllist.c',
+           'src/ullist.c',
+           'src/llistreduce.c',
+           'src/llistsort.c',
+           'src/lrucache.c',
            ]
 
 setup(name='llist',
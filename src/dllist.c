@@ -5,6 +5,8 @@
 #include <Python.h>
 #include <structmember.h>
 #include "py23macros.h"
+#include "llistreduce.h"
+#include "llistsort.h"
 
 #ifndef PyVarObject_HEAD_INIT
     #define PyVarObject_HEAD_INIT(type, size) \
@@ -15,101 +17,177 @@
 static PyTypeObject DLListType;
 static PyTypeObject DLListNodeType;
 static PyTypeObject DLListIteratorType;
+static PyTypeObject DLListCursorType;
 
+static PyObject* dllistiterator_create(PyTypeObject* type,
+                                       PyObject* owner_list,
+                                       int reverse,
+                                       int nodes);
+
+
+/* DLListCell */
+
+/* Elements of the list are stored in plain C cells. Python node
+ * objects (dllistnode) are created only when requested by user
+ * and cached in the cell, so that a single node object represents
+ * the cell for as long as the node is alive.
+ */
+typedef struct DLListCell
+{
+    PyObject* value;
+    struct DLListCell* prev;
+    struct DLListCell* next;
+    struct DLListNodeObject* node;  /* borrowed reference or NULL */
+} DLListCell;
 
 /* DLListNode */
 
-typedef struct
+typedef struct DLListNodeObject
 {
     PyObject_HEAD
-    PyObject* value;
-    PyObject* prev;
-    PyObject* next;
-    PyObject* list_weakref;
+    DLListCell* cell;
+    PyObject* list;     /* borrowed reference to owner list or NULL */
 } DLListNodeObject;
 
-/* Convenience function for creating list nodes.
- * Automatically update pointers in neigbours.
- */
-static DLListNodeObject* dllistnode_create(PyObject* prev,
-                                           PyObject* next,
-                                           PyObject* value,
-                                           PyObject* owner_list)
+static int dllist_value_index_reassign(PyObject* list,
+                                       DLListCell* cell,
+                                       Py_ssize_t step,
+                                       Py_ssize_t count,
+                                       PyObject** values);
+static int dllist_check_node_list(PyObject* list);
+static int dllist_check_node_value(PyObject* list);
+static PyObject* dllistcursor_create(PyObject* owner_list, DLListCell* cell);
+
+/* Released cells and nodes are kept on free lists (chained through
+ * their next and cell pointers respectively) and reused by later
+ * allocations, so that steady append/pop churn does not hit
+ * the memory allocator. */
+static DLListCell* dllistcell_free_list = NULL;
+static Py_ssize_t dllistcell_num_free = 0;
+static DLListNodeObject* dllistnode_free_list = NULL;
+static Py_ssize_t dllistnode_num_free = 0;
+static Py_ssize_t dllist_max_free = 0;
+
+/* Convenience function for allocating unlinked cells. */
+static DLListCell* dllistcell_new(PyObject* value)
 {
-    DLListNodeObject *node;
-    PyObject* args = NULL;
+    DLListCell* cell;
 
     assert(value != NULL);
-    assert(owner_list != NULL);
-    assert(owner_list != Py_None);
 
-    if (value != Py_None)
+    if (dllistcell_free_list != NULL)
     {
-        args = PyTuple_New(1);
-        if (args == NULL)
-        {
-            PyErr_SetString(PyExc_RuntimeError,
-                "Failed to create argument tuple");
-            return NULL;
-        }
-
-        Py_INCREF(value);
-        if (PyTuple_SetItem(args, 0, value) != 0)
+        cell = dllistcell_free_list;
+        dllistcell_free_list = cell->next;
+        --dllistcell_num_free;
+    }
+    else
+    {
+        cell = (DLListCell*)PyMem_Malloc(sizeof(DLListCell));
+        if (cell == NULL)
         {
-            PyErr_SetString(PyExc_RuntimeError,
-                "Failed to initialize argument tuple");
+            PyErr_NoMemory();
             return NULL;
         }
     }
 
-    node = (DLListNodeObject*)PyObject_CallObject(
-        (PyObject*)&DLListNodeType, args);
+    Py_INCREF(value);
+    cell->value = value;
+    cell->prev = NULL;
+    cell->next = NULL;
+    cell->node = NULL;
+
+    return cell;
+}
+
+/* Convenience function for releasing cells, which are neither
+ * linked into a list nor represented by a node. */
+static void dllistcell_free(DLListCell* cell)
+{
+    assert(cell->node == NULL);
 
-    Py_XDECREF(args);
+    Py_DECREF(cell->value);
 
-    /* prev is initialized to Py_None by default
-     * (by dllistnode_new) */
-    if (prev != NULL && prev != Py_None)
+    if (dllistcell_num_free < dllist_max_free)
     {
-        node->prev = prev;
-        ((DLListNodeObject*)prev)->next = (PyObject*)node;
+        cell->next = dllistcell_free_list;
+        dllistcell_free_list = cell;
+        ++dllistcell_num_free;
+        return;
     }
 
-    /* next is initialized to Py_None by default
-     * (by dllistnode_new) */
-    if (next != NULL && next != Py_None)
+    PyMem_Free(cell);
+}
+
+/* Convenience function for deleting cells unlinked from a list.
+ * If the cell is represented by a node, the node is detached from
+ * its owner list and becomes the owner of the cell.
+ */
+static void dllistcell_delete(DLListCell* cell)
+{
+    cell->prev = NULL;
+    cell->next = NULL;
+
+    if (cell->node != NULL)
+        cell->node->list = NULL;
+    else
+        dllistcell_free(cell);
+}
+
+/* Convenience function for allocating nodes. It bypasses the generic
+ * tp_new/tp_init call machinery, so that no argument tuples need
+ * to be built when nodes are handed out to user. */
+static DLListNodeObject* dllistnode_alloc(PyTypeObject* type)
+{
+    DLListNodeObject* node;
+
+    if (type == &DLListNodeType && dllistnode_free_list != NULL)
+    {
+        /* reuse memory of a previously deallocated node */
+        node = dllistnode_free_list;
+        dllistnode_free_list = (DLListNodeObject*)node->cell;
+        --dllistnode_num_free;
+        PyObject_Init((PyObject*)node, type);
+    }
+    else
     {
-        node->next = next;
-        ((DLListNodeObject*)next)->prev = (PyObject*)node;
+        node = (DLListNodeObject*)type->tp_alloc(type, 0);
+        if (node == NULL)
+            return NULL;
     }
 
-    Py_DECREF(node->list_weakref);
-    node->list_weakref = PyWeakref_NewRef(owner_list, NULL);
+    node->cell = NULL;
+    node->list = NULL;
 
     return node;
 }
 
-/* Convenience function for deleting list nodes.
- * Automatically updates pointers in neigbours.
+/* Convenience function for obtaining a node representing the cell
+ * (as a new reference). The node is created on first request and
+ * cached in the cell afterwards. Returns Py_None if cell is NULL.
  */
-static void dllistnode_delete(DLListNodeObject* node)
+static PyObject* dllistnode_from_cell(PyObject* owner_list, DLListCell* cell)
 {
-    if (node->prev != Py_None)
-    {
-        DLListNodeObject* prev = (DLListNodeObject*)node->prev;
-        prev->next = node->next;
-    }
+    DLListNodeObject* node;
+
+    if (cell == NULL)
+        Py_RETURN_NONE;
 
-    if (node->next != Py_None)
+    if (cell->node != NULL)
     {
-        DLListNodeObject* next = (DLListNodeObject*)node->next;
-        next->prev = node->prev;
+        Py_INCREF((PyObject*)cell->node);
+        return (PyObject*)cell->node;
     }
 
-    node->prev = Py_None;
-    node->next = Py_None;
+    node = dllistnode_alloc(&DLListNodeType);
+    if (node == NULL)
+        return NULL;
 
-    Py_DECREF((PyObject*)node);
+    node->cell = cell;
+    node->list = owner_list;
+    cell->node = node;
+
+    return (PyObject*)node;
 }
 
 /* Convenience function for formatting list node to a string.
@@ -124,11 +202,14 @@ static PyObject* dllistnode_to_string(DLListNodeObject* self,
 
     assert(fmt_func != NULL);
 
+    if (self->list != NULL && !dllist_check_node_value(self->list))
+        return NULL;
+
     str = Py23String_FromString(prefix);
     if (str == NULL)
         goto str_alloc_error;
 
-    tmp_str = fmt_func(self->value);
+    tmp_str = fmt_func(self->cell->value);
     if (tmp_str == NULL)
         goto str_alloc_error;
     Py23String_ConcatAndDel(&str, tmp_str);
@@ -148,43 +229,78 @@ str_alloc_error:
 
 static void dllistnode_dealloc(DLListNodeObject* self)
 {
-    Py_DECREF(self->list_weakref);
-    Py_DECREF(self->value);
-    Py_DECREF(Py_None);
+    if (self->cell != NULL)
+    {
+        self->cell->node = NULL;
+
+        /* cells of detached nodes are owned by the node */
+        if (self->list == NULL)
+            dllistcell_free(self->cell);
+    }
+
+    if (Py_TYPE(self) == &DLListNodeType &&
+        dllistnode_num_free < dllist_max_free)
+    {
+        self->cell = (DLListCell*)dllistnode_free_list;
+        dllistnode_free_list = self;
+        ++dllistnode_num_free;
+        return;
+    }
 
     PyObject_Del((PyObject*)self);
 }
 
-static PyObject* dllistnode_new(PyTypeObject* type,
-                                PyObject* args,
-                                PyObject* kwds)
+/* Convenience function for creating nodes, which are not part
+ * of any list. Such node owns a private cell. */
+static PyObject* dllistnode_create(PyTypeObject* type, PyObject* value)
 {
     DLListNodeObject* self;
 
-    self = (DLListNodeObject*)type->tp_alloc(type, 0);
+    self = dllistnode_alloc(type);
     if (self == NULL)
         return NULL;
 
-    /* A single reference to Py_None is held for the whole
-     * lifetime of a node. */
-    Py_INCREF(Py_None);
-
-    self->value = Py_None;
-    self->prev = Py_None;
-    self->next = Py_None;
-    self->list_weakref = Py_None;
+    self->cell = dllistcell_new(value);
+    if (self->cell == NULL)
+    {
+        Py_DECREF((PyObject*)self);
+        return NULL;
+    }
 
-    Py_INCREF(self->value);
-    Py_INCREF(self->list_weakref);
+    self->cell->node = self;
 
     return (PyObject*)self;
 }
 
+static PyObject* dllistnode_new(PyTypeObject* type,
+                                PyObject* args,
+                                PyObject* kwds)
+{
+    return dllistnode_create(type, Py_None);
+}
+
+#ifdef Py23_HAVE_VECTORCALL
+static PyObject* dllistnode_vectorcall(PyObject* type,
+                                       PyObject* const* args,
+                                       size_t nargsf,
+                                       PyObject* kwnames)
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+
+    if (kwnames != NULL || nargs > 1)
+        return Py23Type_VectorcallFallback(type, args, nargsf, kwnames);
+
+    return dllistnode_create((PyTypeObject*)type,
+                             (nargs == 1) ? args[0] : Py_None);
+}
+#endif
+
 static int dllistnode_init(DLListNodeObject* self,
                            PyObject* args,
                            PyObject* kwds)
 {
     PyObject* value = NULL;
+    PyObject* oldval;
 
     if (!PyArg_UnpackTuple(args, "__init__", 0, 1, &value))
         return -1;
@@ -192,10 +308,17 @@ static int dllistnode_init(DLListNodeObject* self,
     if (value == NULL)
         return 0;
 
+    if (self->list != NULL &&
+        (!dllist_check_node_list(self->list) ||
+         dllist_value_index_reassign(self->list, self->cell,
+                                     1, 1, &value) == -1))
+        return -1;
+
     /* initialize node using passed value */
-    Py_DECREF(self->value);
+    oldval = self->cell->value;
     Py_INCREF(value);
-    self->value = value;
+    self->cell->value = value;
+    Py_DECREF(oldval);
 
     return 0;
 }
@@ -204,8 +327,11 @@ static PyObject* dllistnode_call(DLListNodeObject* self,
                                  PyObject* args,
                                  PyObject* kw)
 {
-    Py_INCREF(self->value);
-    return self->value;
+    if (self->list != NULL && !dllist_check_node_value(self->list))
+        return NULL;
+
+    Py_INCREF(self->cell->value);
+    return self->cell->value;
 }
 
 static PyObject* dllistnode_repr(DLListNodeObject* self)
@@ -218,14 +344,59 @@ static PyObject* dllistnode_str(DLListNodeObject* self)
     return dllistnode_to_string(self, PyObject_Str, "dllistnode(", ")");
 }
 
-static PyMemberDef DLListNodeMembers[] =
+static PyObject* dllistnode_get_value(DLListNodeObject* self, void* closure)
+{
+    if (self->list != NULL && !dllist_check_node_value(self->list))
+        return NULL;
+
+    Py_INCREF(self->cell->value);
+    return self->cell->value;
+}
+
+static int dllistnode_set_value(DLListNodeObject* self,
+                                PyObject* value,
+                                void* closure)
+{
+    PyObject* oldval;
+
+    if (value == NULL)
+    {
+        PyErr_SetString(PyExc_TypeError, "Cannot delete node value");
+        return -1;
+    }
+
+    if (self->list != NULL &&
+        (!dllist_check_node_list(self->list) ||
+         dllist_value_index_reassign(self->list, self->cell,
+                                     1, 1, &value) == -1))
+        return -1;
+
+    oldval = self->cell->value;
+    Py_INCREF(value);
+    self->cell->value = value;
+    Py_DECREF(oldval);
+
+    return 0;
+}
+
+static PyObject* dllistnode_get_prev(DLListNodeObject* self, void* closure)
+{
+    return dllistnode_from_cell(self->list, self->cell->prev);
+}
+
+static PyObject* dllistnode_get_next(DLListNodeObject* self, void* closure)
+{
+    return dllistnode_from_cell(self->list, self->cell->next);
+}
+
+static PyGetSetDef DLListNodeGetSetters[] =
 {
-    { "value", T_OBJECT_EX, offsetof(DLListNodeObject, value), 0,
-      "Value stored in node" },
-    { "prev", T_OBJECT_EX, offsetof(DLListNodeObject, prev), READONLY,
-      "Previous node" },
-    { "next", T_OBJECT_EX, offsetof(DLListNodeObject, next), READONLY,
-      "Next node" },
+    { "value", (getter)dllistnode_get_value, (setter)dllistnode_set_value,
+      "Value stored in node", NULL },
+    { "prev", (getter)dllistnode_get_prev, NULL,
+      "Previous node", NULL },
+    { "next", (getter)dllistnode_get_next, NULL,
+      "Next node", NULL },
     { NULL },   /* sentinel */
 };
 
@@ -259,8 +430,8 @@ static PyTypeObject DLListNodeType =
     0,                              /* tp_iter */
     0,                              /* tp_iternext */
     0,                              /* tp_methods */
-    DLListNodeMembers,              /* tp_members */
-    0,                              /* tp_getset */
+    0,                              /* tp_members */
+    DLListNodeGetSetters,           /* tp_getset */
     0,                              /* tp_base */
     0,                              /* tp_dict */
     0,                              /* tp_descr_get */
@@ -272,990 +443,3239 @@ static PyTypeObject DLListNodeType =
 };
 
 
-/* DLList */
+/* DLListIndex */
+
+/* Lists created with indexed=True maintain an indexable skip list
+ * over their cells, which provides O(log n) positional access.
+ * Cells of such lists are allocated with a tower of links of random
+ * height; a link at level l points to the next cell reaching that
+ * level and stores the number of cells it spans (its width).
+ * Level 0 of the skip list is formed by the cells themselves.
+ */
+#define DLLIST_INDEX_MAX_LEVEL 16
+
+/* Indexed lookups closer than this to a known cell are done by
+ * scanning the list instead of descending the skip list. */
+#define DLLIST_INDEX_SCAN_LIMIT 8
+
+typedef struct DLListIndexLink
+{
+    struct DLListIndexCell* prev;
+    struct DLListIndexCell* next;
+    Py_ssize_t width;   /* distance to next, valid if next is not NULL */
+} DLListIndexLink;
+
+typedef struct DLListIndexCell
+{
+    DLListCell cell;
+    int height;
+    DLListIndexLink links[1];   /* links of levels 1 to height - 1 */
+} DLListIndexCell;
 
 typedef struct
 {
-    PyObject_HEAD
-    PyObject* first;
-    PyObject* last;
-    PyObject* last_accessed_node;
-    Py_ssize_t last_accessed_idx;
-    Py_ssize_t size;
-    PyObject* weakref_list;
-} DLListObject;
+    int levels;
+    DLListIndexLink head[DLLIST_INDEX_MAX_LEVEL - 1];
+} DLListIndex;
 
-static Py_ssize_t py_ssize_t_abs(Py_ssize_t x)
+/* Link of icell at the given level (level > 0). NULL icell stands
+ * for the head of the list. */
+#define DLLISTINDEX_LINK(index, icell, level) \
+    ((icell) != NULL ? &(icell)->links[(level) - 1] : \
+                       &(index)->head[(level) - 1])
+
+static unsigned long dllistindex_random_state = 2463534242UL;
+
+/* Draws tower height from a geometric distribution with p = 1/4. */
+static int dllistindex_random_height(void)
 {
-    return (x >= 0) ? x : -x;
+    unsigned long r = dllistindex_random_state;
+    int height = 1;
+
+    /* xorshift32 */
+    r ^= (r << 13) & 0xffffffffUL;
+    r ^= r >> 17;
+    r ^= (r << 5) & 0xffffffffUL;
+    dllistindex_random_state = r;
+
+    while ((r & 3) == 0 && height < DLLIST_INDEX_MAX_LEVEL)
+    {
+        ++height;
+        r >>= 2;
+    }
+
+    return height;
 }
 
-/* Convenience function for locating list nodes using index. */
-static DLListNodeObject* dllist_get_node_internal(DLListObject* self,
-                                                  Py_ssize_t index)
+static DLListIndex* dllistindex_new(void)
 {
-    Py_ssize_t i;
-    Py_ssize_t middle = self->size / 2;
-    DLListNodeObject* node;
-    Py_ssize_t start_pos;
-    int reverse_dir;
+    DLListIndex* index;
 
-    if (index >= self->size || index < 0)
+    index = (DLListIndex*)PyMem_Malloc(sizeof(DLListIndex));
+    if (index == NULL)
     {
-        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        PyErr_NoMemory();
         return NULL;
     }
 
-    /* pick the closest base node */
-    if (index <= middle)
-    {
-        node = (DLListNodeObject*)self->first;
-        start_pos = 0;
-        reverse_dir = 0;
-    }
-    else
-    {
-        node = (DLListNodeObject*)self->last;
-        start_pos = self->size - 1;
-        reverse_dir = 1;
-    }
+    index->levels = 1;
 
-    /* check if last accessed index is closer */
-    if (self->last_accessed_node != Py_None &&
-        self->last_accessed_idx >= 0 &&
-        py_ssize_t_abs(index - self->last_accessed_idx) < middle)
-    {
-        node = (DLListNodeObject*)self->last_accessed_node;
-        start_pos = self->last_accessed_idx;
-        reverse_dir = (index < self->last_accessed_idx) ? 1 : 0;
-    }
+    return index;
+}
 
-    assert((PyObject*)node != Py_None);
+/* Convenience function for allocating unlinked cells of indexed
+ * lists. Such cells are never taken from the free list, but they are
+ * released with dllistcell_free() as any other cell. */
+static DLListCell* dllistindexcell_new(PyObject* value)
+{
+    DLListIndexCell* icell;
+    int height = dllistindex_random_height();
 
-    if (!reverse_dir)
-    {
-        /* forward scan */
-        for (i = start_pos; i < index; ++i)
-            node = (DLListNodeObject*)node->next;
-    }
-    else
+    assert(value != NULL);
+
+    icell = (DLListIndexCell*)PyMem_Malloc(
+        offsetof(DLListIndexCell, links) +
+        (height - 1) * sizeof(DLListIndexLink));
+    if (icell == NULL)
     {
-        /* backward scan */
-        for (i = start_pos; i > index; --i)
-            node = (DLListNodeObject*)node->prev;
+        PyErr_NoMemory();
+        return NULL;
     }
 
-    return node;
+    Py_INCREF(value);
+    icell->cell.value = value;
+    icell->cell.prev = NULL;
+    icell->cell.next = NULL;
+    icell->cell.node = NULL;
+    icell->height = height;
+
+    return &icell->cell;
 }
 
-/* Convenience function for extending (concatenating in-place)
- * the list with elements from a sequence. */
-static int dllist_extend_internal(DLListObject* self, PyObject* sequence)
+/* Walks back from icell (NULL stands for the head of the list), which
+ * must reach the given level, and finds the closest towers reaching
+ * all higher levels. On return update[l] holds the tower for level l
+ * and dist[l] holds its distance to icell. */
+static void dllistindex_trace(DLListIndex* index,
+                              DLListIndexCell* icell,
+                              int level,
+                              DLListIndexCell** update,
+                              Py_ssize_t* dist)
 {
-    Py_ssize_t i;
-    Py_ssize_t sequence_len;
+    Py_ssize_t d = 0;
 
-    if (PyObject_TypeCheck(sequence, &DLListType))
+    for (;;)
     {
-        /* Special path for extending with a DLList.
-         * It's not strictly required but it will maintain
-         * the last accessed item. */
-        PyObject* iter_node_obj = ((DLListObject*)sequence)->first;
-        PyObject* last_node_obj = self->last;
+        update[level] = icell;
+        dist[level] = d;
 
-        while (iter_node_obj != Py_None)
-        {
-            DLListNodeObject* iter_node = (DLListNodeObject*)iter_node_obj;
-            PyObject* new_node;
-
-            new_node = (PyObject*)dllistnode_create(
-                self->last, NULL, iter_node->value, (PyObject*)self);
+        if (++level >= index->levels)
+            break;
 
-            if (self->first == Py_None)
-                self->first = new_node;
-            self->last = new_node;
+        /* move back along the level below until a tall enough tower */
+        while (icell != NULL && icell->height <= level)
+        {
+            DLListIndexCell* prev;
 
-            if (iter_node_obj == last_node_obj)
+            if (level == 1)
             {
-                /* This is needed to terminate loop if self == sequence. */
-                break;
+                prev = (DLListIndexCell*)icell->cell.prev;
+                d += 1;
+            }
+            else
+            {
+                prev = icell->links[level - 2].prev;
+                d += DLLISTINDEX_LINK(index, prev, level - 1)->width;
             }
 
-            iter_node_obj = iter_node->next;
+            icell = prev;
         }
-
-        self->size += ((DLListObject*)sequence)->size;
-
-        return 1;
     }
+}
+
+/* Adds a cell, which has just been linked into the list, to the index. */
+static void dllistindex_insert(DLListIndex* index, DLListIndexCell* icell)
+{
+    DLListIndexCell* update[DLLIST_INDEX_MAX_LEVEL];
+    Py_ssize_t dist[DLLIST_INDEX_MAX_LEVEL];
+    int level;
 
-    sequence_len = PySequence_Length(sequence);
-    if (sequence_len == -1)
+    while (index->levels < icell->height)
     {
-        PyErr_SetString(PyExc_ValueError, "Invalid sequence");
-        return 0;
+        index->head[index->levels - 1].next = NULL;
+        ++index->levels;
     }
 
-    for (i = 0; i < sequence_len; ++i)
+    dllistindex_trace(index,
+        (DLListIndexCell*)icell->cell.prev, 0, update, dist);
+
+    for (level = 1; level < index->levels; ++level)
     {
-        PyObject* item;
-        PyObject* new_node;
+        DLListIndexLink* pred = DLLISTINDEX_LINK(index, update[level], level);
 
-        item = PySequence_GetItem(sequence, i);
-        if (item == NULL)
+        if (level < icell->height)
         {
-            PyErr_SetString(PyExc_ValueError,
-                "Failed to get element from sequence");
-            return 0;
+            DLListIndexLink* link = &icell->links[level - 1];
+
+            link->prev = update[level];
+            link->next = pred->next;
+            if (link->next != NULL)
+            {
+                link->width = pred->width - dist[level];
+                link->next->links[level - 1].prev = icell;
+            }
+
+            pred->next = icell;
+            pred->width = dist[level] + 1;
         }
+        else if (pred->next != NULL)
+            ++pred->width;
+    }
+}
+
+/* Removes a cell, which is still linked into the list, from the index. */
+static void dllistindex_remove(DLListIndex* index, DLListIndexCell* icell)
+{
+    DLListIndexCell* update[DLLIST_INDEX_MAX_LEVEL];
+    Py_ssize_t dist[DLLIST_INDEX_MAX_LEVEL];
+    int level;
 
-        new_node = (PyObject*)dllistnode_create(
-            self->last, NULL, item, (PyObject*)self);
+    dllistindex_trace(index, icell, icell->height - 1, update, dist);
 
-        if (self->first == Py_None)
-            self->first = new_node;
-        self->last = new_node;
+    for (level = 1; level < index->levels; ++level)
+    {
+        if (level < icell->height)
+        {
+            DLListIndexLink* link = &icell->links[level - 1];
+            DLListIndexLink* pred = DLLISTINDEX_LINK(index, link->prev, level);
 
-        ++self->size;
+            pred->next = link->next;
+            if (link->next != NULL)
+            {
+                pred->width += link->width - 1;
+                link->next->links[level - 1].prev = link->prev;
+            }
+        }
+        else
+        {
+            DLListIndexLink* pred =
+                DLLISTINDEX_LINK(index, update[level], level);
 
-        Py_DECREF(item);
+            if (pred->next != NULL)
+                --pred->width;
+        }
     }
 
-    return 1;
+    /* drop levels, which are no longer reached by any tower */
+    while (index->levels > 1 && index->head[index->levels - 2].next == NULL)
+        --index->levels;
 }
 
-/* Convenience function for formatting list to a string.
- * Pass PyObject_Repr or PyObject_Str in the fmt_func argument. */
-static PyObject* dllist_to_string(DLListObject* self,
-                                  reprfunc fmt_func)
+/* Computes position of a cell linked into the list. */
+static Py_ssize_t dllistindex_position(DLListIndex* index,
+                                       DLListIndexCell* icell)
 {
-    PyObject* str = NULL;
-    PyObject* comma_str = NULL;
-    PyObject* tmp_str;
-    DLListNodeObject* node = (DLListNodeObject*)self->first;
+    DLListIndexCell* update[DLLIST_INDEX_MAX_LEVEL];
+    Py_ssize_t dist[DLLIST_INDEX_MAX_LEVEL];
+    int top = index->levels - 1;
+    Py_ssize_t pos;
 
-    assert(fmt_func != NULL);
+    dllistindex_trace(index, icell, 0, update, dist);
+
+    /* walk the top level back to the head, which is at position -1 */
+    icell = update[top];
+    pos = dist[top] - 1;
 
-    if (self->first == Py_None)
+    while (icell != NULL)
     {
-        str = Py23String_FromString("dllist()");
-        if (str == NULL)
-            goto str_alloc_error;
-        return str;
+        DLListIndexCell* prev;
+
+        if (top == 0)
+        {
+            prev = (DLListIndexCell*)icell->cell.prev;
+            pos += 1;
+        }
+        else
+        {
+            prev = icell->links[top - 1].prev;
+            pos += DLLISTINDEX_LINK(index, prev, top)->width;
+        }
+
+        icell = prev;
     }
 
-    str = Py23String_FromString("dllist([");
-    if (str == NULL)
-        goto str_alloc_error;
+    return pos;
+}
 
-    comma_str = Py23String_FromString(", ");
-    if (comma_str == NULL)
-        goto str_alloc_error;
+/* Locates the cell at position pos of the list starting with first. */
+static DLListCell* dllistindex_select(DLListIndex* index,
+                                      DLListCell* first,
+                                      Py_ssize_t pos)
+{
+    DLListIndexCell* icell = NULL;
+    Py_ssize_t i = -1;
+    DLListCell* cell;
+    int level;
 
-    while ((PyObject*)node != Py_None)
+    for (level = index->levels - 1; level > 0; --level)
     {
-        if (node != (DLListNodeObject*)self->first)
-            Py23String_Concat(&str, comma_str);
-
-        tmp_str = fmt_func(node->value);
-        if (tmp_str == NULL)
-            goto str_alloc_error;
-        Py23String_ConcatAndDel(&str, tmp_str);
+        DLListIndexLink* link = DLLISTINDEX_LINK(index, icell, level);
 
-        node = (DLListNodeObject*)node->next;
+        while (link->next != NULL && i + link->width <= pos)
+        {
+            i += link->width;
+            icell = link->next;
+            link = &icell->links[level - 1];
+        }
     }
 
-    Py_DECREF(comma_str);
-    comma_str = NULL;
-
-    tmp_str = Py23String_FromString("])");
-    if (tmp_str == NULL)
-        goto str_alloc_error;
-    Py23String_ConcatAndDel(&str, tmp_str);
+    if (icell != NULL)
+        cell = &icell->cell;
+    else
+    {
+        cell = first;
+        i = 0;
+    }
 
-    return str;
+    for (; i < pos; ++i)
+        cell = cell->next;
 
-str_alloc_error:
-    Py_XDECREF(str);
-    Py_XDECREF(comma_str);
-    PyErr_SetString(PyExc_RuntimeError, "Failed to create string");
-    return NULL;
+    return cell;
 }
 
-static void dllist_dealloc(DLListObject* self)
+/* Rebuilds all links of the index after cells have been reordered. */
+static void dllistindex_rebuild(DLListIndex* index, DLListCell* first)
 {
-    PyObject* node = self->first;
+    DLListIndexCell* last[DLLIST_INDEX_MAX_LEVEL];
+    Py_ssize_t last_pos[DLLIST_INDEX_MAX_LEVEL];
+    DLListCell* cell;
+    Py_ssize_t pos;
+    int level;
 
-    if (self->weakref_list != NULL)
-        PyObject_ClearWeakRefs((PyObject*)self);
-
-    while (node != Py_None)
+    for (level = 1; level < DLLIST_INDEX_MAX_LEVEL; ++level)
     {
-        PyObject* next_node = ((DLListNodeObject*)node)->next;
-        dllistnode_delete((DLListNodeObject*)node);
-        node = next_node;
+        last[level] = NULL;
+        last_pos[level] = -1;
     }
 
-    Py_DECREF(Py_None);
+    index->levels = 1;
 
-    PyObject_Del((PyObject*)self);
-}
+    for (cell = first, pos = 0; cell != NULL; cell = cell->next, ++pos)
+    {
+        DLListIndexCell* icell = (DLListIndexCell*)cell;
 
-static PyObject* dllist_new(PyTypeObject* type,
-                            PyObject* args,
-                            PyObject* kwds)
-{
-    DLListObject* self;
+        for (level = 1; level < icell->height; ++level)
+        {
+            DLListIndexLink* pred = DLLISTINDEX_LINK(index, last[level], level);
 
-    self = (DLListObject*)type->tp_alloc(type, 0);
-    if (self == NULL)
-        return NULL;
-
-    /* A single reference to Py_None is held for the whole
-     * lifetime of a list. */
-    Py_INCREF(Py_None);
+            pred->next = icell;
+            pred->width = pos - last_pos[level];
+            icell->links[level - 1].prev = last[level];
+            last[level] = icell;
+            last_pos[level] = pos;
+        }
 
-    self->first = Py_None;
-    self->last = Py_None;
-    self->last_accessed_node = Py_None;
-    self->last_accessed_idx = -1;
-    self->size = 0;
-    self->weakref_list = NULL;
+        if (icell->height > index->levels)
+            index->levels = icell->height;
+    }
 
-    return (PyObject*)self;
+    for (level = 1; level < index->levels; ++level)
+        DLLISTINDEX_LINK(index, last[level], level)->next = NULL;
 }
 
-static int dllist_init(DLListObject* self, PyObject* args, PyObject* kwds)
+
+/* DLList */
+
+/* Lists remember positions of a few recently accessed cells (fingers),
+ * which serve as starting points for lookups by index. Fingers are
+ * kept in most recently used order and their positions are adjusted
+ * when elements are inserted or removed. */
+#define DLLIST_NUM_FINGERS 4
+
+typedef struct
 {
-    PyObject* sequence = NULL;
+    DLListCell* cell;
+    Py_ssize_t idx;
+} DLListFinger;
 
-    if (!PyArg_UnpackTuple(args, "__init__", 0, 1, &sequence))
-        return -1;
+typedef struct
+{
+    PyObject_HEAD
+    DLListCell* first;
+    DLListCell* last;
+    DLListFinger fingers[DLLIST_NUM_FINGERS];
+    int num_fingers;
+    Py_ssize_t finger_hits;
+    Py_ssize_t finger_misses;
+    Py_ssize_t size;
+    Py_ssize_t state;       /* incremented when cells are relinked */
+    int sorting;            /* nonzero while sort() keeps cells unlinked */
+    DLListIndex* index;     /* NULL if list is not indexed */
+    PyObject* value_index;  /* dict mapping values to nodes or NULL */
+    PyObject* weakref_list;
+} DLListObject;
 
-    if (sequence == NULL)
-        return 0;
+static Py_ssize_t py_ssize_t_abs(Py_ssize_t x)
+{
+    return (x >= 0) ? x : -x;
+}
 
-    /* initialize list using passed sequence */
-    if (!PySequence_Check(sequence))
-    {
-        PyErr_SetString(PyExc_TypeError, "Argument must be a sequence");
-        return -1;
-    }
+/* Convenience function for extracting values from arguments, which
+ * might be either plain objects or dllistnodes holding the value. */
+static PyObject* dllist_value_arg(PyObject* arg)
+{
+    if (PyObject_TypeCheck(arg, &DLListNodeType))
+        return ((DLListNodeObject*)arg)->cell->value;
 
-    return dllist_extend_internal(self, sequence) ? 0 : -1;
+    return arg;
 }
 
-static PyObject* dllist_node_at(PyObject* self, PyObject* indexObject)
+/* Convenience function for retrieving a cell from a node argument.
+ * Verifies that the node belongs to the list. */
+static DLListCell* dllist_node_arg(DLListObject* self,
+                                   PyObject* arg,
+                                   const char* type_error)
 {
     DLListNodeObject* node;
-    Py_ssize_t index;
 
-    if (!Py23Int_Check(indexObject))
+    if (!PyObject_TypeCheck(arg, &DLListNodeType))
     {
-        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
+        PyErr_SetString(PyExc_TypeError, type_error);
         return NULL;
     }
 
-    index = Py23Int_AsSsize_t(indexObject);
+    node = (DLListNodeObject*)arg;
 
-    if (index < 0)
-        index = ((DLListObject*)self)->size + index;
+    if (node->list == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "dllistnode does not belong to a list");
+        return NULL;
+    }
 
-    node = dllist_get_node_internal((DLListObject*)self, index);
-    if (node != NULL)
+    if (node->list != (PyObject*)self)
     {
-        /* update last accessed node */
-        ((DLListObject*)self)->last_accessed_node = (PyObject*)node;
-        ((DLListObject*)self)->last_accessed_idx = index;
+        PyErr_SetString(PyExc_ValueError,
+            "dllistnode belongs to another list");
+        return NULL;
+    }
 
-        Py_INCREF(node);
+    if (!dllist_check_node_list(node->list))
+        return NULL;
+
+    return node->cell;
+}
+
+/* Cells of a list being sorted are unlinked from it until sort()
+ * returns, while their nodes still refer to the list. Verifies that
+ * list, which owns a node passed by user, is not being sorted, so
+ * that the node may be used to modify it. */
+static int dllist_check_node_list(PyObject* list)
+{
+    if (((DLListObject*)list)->sorting)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "dllist modified during sort()");
+        return 0;
     }
 
-    return (PyObject*)node;
+    return 1;
 }
 
-static PyObject* dllist_repr(DLListObject* self)
+/* Cells of a list sorted with a key function hold sort keys in place
+ * of values until sort() returns. Verifies that list, which owns
+ * a node passed by user, is not being sorted, so that the value of
+ * the node may be read. */
+static int dllist_check_node_value(PyObject* list)
 {
-    return dllist_to_string(self, PyObject_Repr);
+    if (((DLListObject*)list)->sorting)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "dllistnode value is not available during sort()");
+        return 0;
+    }
+
+    return 1;
 }
 
-static PyObject* dllist_str(DLListObject* self)
+/* Convenience function for comparing value of a cell with value.
+ * Identical objects are matched without calling their comparison.
+ * Returns 1 if values are equal, 0 if they are not and -1 on error,
+ * including modification of the list by the comparison. */
+static int dllist_cell_matches(DLListObject* self,
+                               DLListCell* cell,
+                               PyObject* value,
+                               const char* method)
 {
-    return dllist_to_string(self, PyObject_Str);
+    PyObject* cell_value = cell->value;
+    Py_ssize_t state = self->state;
+    int result;
+
+    if (cell_value == value)
+        return 1;
+
+    Py_INCREF(cell_value);
+    result = PyObject_RichCompareBool(cell_value, value, Py_EQ);
+    Py_DECREF(cell_value);
+
+    if (result != -1 && state != self->state)
+    {
+        PyErr_Format(PyExc_RuntimeError,
+            "dllist modified during %s()", method);
+        return -1;
+    }
+
+    return result;
 }
 
-static long dllist_hash(DLListObject* self)
+/* Convenience function for allocating unlinked cells, which fit
+ * the list (indexed lists need cells with skip list links). */
+static DLListCell* dllist_new_cell(DLListObject* self, PyObject* value)
 {
-    long hash = 0;
-    PyObject* iter_node_obj = self->first;
+    if (self->index != NULL)
+        return dllistindexcell_new(value);
+
+    return dllistcell_new(value);
+}
 
-    while (iter_node_obj != Py_None)
+/* Convenience function for recording access to a cell. The finger
+ * slot is moved to the front of the most recently used order. */
+static void dllist_touch_finger(DLListObject* self,
+                                int slot,
+                                DLListCell* cell,
+                                Py_ssize_t idx)
+{
+    if (slot < 0)
     {
-        long obj_hash;
-        DLListNodeObject* iter_node = (DLListNodeObject*)iter_node_obj;
+        /* reuse the slot of the same cell if there is one */
+        for (slot = 0; slot < self->num_fingers; ++slot)
+        {
+            if (self->fingers[slot].cell == cell)
+                break;
+        }
+    }
+    else
+    {
+        /* drop other finger of the same cell if there is one */
+        int i;
 
-        obj_hash = PyObject_Hash(iter_node->value);
-        if (obj_hash == -1)
-            return -1;
+        for (i = 0; i < self->num_fingers; ++i)
+        {
+            if (i != slot && self->fingers[i].cell == cell)
+            {
+                memmove(&self->fingers[i], &self->fingers[i + 1],
+                    (self->num_fingers - i - 1) * sizeof(DLListFinger));
+                --self->num_fingers;
+                if (i < slot)
+                    --slot;
+                break;
+            }
+        }
+    }
 
-        hash ^= obj_hash;
-        iter_node_obj = iter_node->next;
+    if (slot == self->num_fingers)
+    {
+        /* take a new slot, evicting the least recently used one */
+        if (self->num_fingers < DLLIST_NUM_FINGERS)
+            ++self->num_fingers;
+        slot = self->num_fingers - 1;
     }
 
-    return hash;
+    memmove(&self->fingers[1], &self->fingers[0],
+        slot * sizeof(DLListFinger));
+
+    self->fingers[0].cell = cell;
+    self->fingers[0].idx = idx;
 }
 
-static PyObject* dllist_richcompare(DLListObject* self,
-                                    DLListObject* other,
-                                    int op)
+/* Convenience function for finding the position of a linked cell.
+ * Returns -1 if it cannot be determined without scanning the list. */
+static Py_ssize_t dllist_cell_position(DLListObject* self, DLListCell* cell)
 {
-    DLListNodeObject* self_node;
-    DLListNodeObject* other_node;
-    int satisfied = 1;
+    int i;
 
-    if (!PyObject_TypeCheck(other, &DLListType))
+    if (cell == self->first)
+        return 0;
+
+    if (cell == self->last)
+        return self->size - 1;
+
+    for (i = 0; i < self->num_fingers; ++i)
     {
-        Py_INCREF(Py_NotImplemented);
-        return Py_NotImplemented;
+        if (self->fingers[i].cell == cell)
+            return self->fingers[i].idx;
     }
 
-    if (self == other &&
-        (op == Py_EQ || op == Py_LE || op == Py_GE))
-        Py_RETURN_TRUE;
+    if (self->index != NULL)
+        return dllistindex_position(self->index, (DLListIndexCell*)cell);
 
-    if (self->size != other->size)
+    return -1;
+}
+
+/* Convenience function for updating fingers before count cells are
+ * inserted at pos (-1 if position is unknown). */
+static void dllist_fingers_insert(DLListObject* self,
+                                  Py_ssize_t pos,
+                                  Py_ssize_t count)
+{
+    int i;
+
+    if (pos < 0)
     {
-        if (op == Py_EQ)
-            Py_RETURN_FALSE;
-        else if (op == Py_NE)
-            Py_RETURN_TRUE;
+        self->num_fingers = 0;
+        return;
     }
 
-    /* Scan through sequences' items as long as they are equal. */
-    self_node = (DLListNodeObject*)self->first;
-    other_node = (DLListNodeObject*)other->first;
+    for (i = 0; i < self->num_fingers; ++i)
+    {
+        if (self->fingers[i].idx >= pos)
+            self->fingers[i].idx += count;
+    }
+}
+
+/* Convenience function for updating fingers before a cell is removed.
+ * Finger of the removed cell is moved to one of its neighbours. */
+static void dllist_fingers_remove(DLListObject* self, DLListCell* cell)
+{
+    Py_ssize_t pos = dllist_cell_position(self, cell);
+    int i;
+    int j;
+    int n = 0;
 
-    while ((PyObject*)self_node != Py_None &&
-            (PyObject*)other_node != Py_None)
+    if (pos < 0)
     {
-        satisfied = PyObject_RichCompareBool(
-            self_node->value, other_node->value, Py_EQ);
+        self->num_fingers = 0;
+        return;
+    }
 
-        if (satisfied == 0)
-            break;
+    for (i = 0; i < self->num_fingers; ++i)
+    {
+        DLListFinger finger = self->fingers[i];
 
-        if (satisfied == -1)
-            return NULL;
+        if (finger.cell == cell)
+        {
+            if (cell->next != NULL)
+                finger.cell = cell->next;
+            else
+            {
+                finger.cell = cell->prev;
+                --finger.idx;
+            }
+        }
+        else if (finger.idx > pos)
+            --finger.idx;
 
-        self_node = (DLListNodeObject*)self_node->next;
-        other_node = (DLListNodeObject*)other_node->next;
+        /* drop fingers, which ended up on the same cell */
+        for (j = 0; j < n; ++j)
+        {
+            if (self->fingers[j].cell == finger.cell)
+                break;
+        }
+
+        if (finger.cell != NULL && j == n)
+            self->fingers[n++] = finger;
     }
 
-    /* Compare last item */
-    if (satisfied)
+    self->num_fingers = n;
+}
+
+/* Lists with a unique index map values of all their cells to nodes
+ * in a dict, which is also what keeps these nodes alive. Entries
+ * are added before cells are linked into the list (so that duplicate
+ * values are rejected while the list is still intact) and discarded
+ * when cells are unlinked. */
+
+/* Convenience function for removing the entry of a cell from
+ * the unique index. Entries, which already map the value to another
+ * node, are left intact. */
+static void dllist_value_index_discard(DLListObject* self, DLListCell* cell)
+{
+    if (self->value_index == NULL || cell->node == NULL)
+        return;
+
+    if (PyDict_GetItem(self->value_index, cell->value) ==
+        (PyObject*)cell->node)
     {
-        /* At least one of operands has been fully traversed.
-         * Either self_node or other_node is equal to Py_None. */
-        switch (op)
-        {
-        case Py_EQ:
-            satisfied = (self_node == other_node);
-            break;
-        case Py_NE:
-            satisfied = (self_node != other_node);
-            break;
-        case Py_LT:
-            satisfied = ((PyObject*)other_node != Py_None);
-            break;
-        case Py_GT:
-            satisfied = ((PyObject*)self_node != Py_None);
+        /* the value was hashed successfully when it was added */
+        if (PyDict_DelItem(self->value_index, cell->value) == -1)
+            PyErr_Clear();
+    }
+}
+
+/* Convenience function for adding entries of unlinked cells from first
+ * to stop (exclusive) to the unique index. Either all cells are added,
+ * or none of them and an exception is set. */
+static int dllist_value_index_add(DLListObject* self,
+                                  DLListCell* first,
+                                  DLListCell* stop)
+{
+    PyObject* err_type;
+    PyObject* err_value;
+    PyObject* err_traceback;
+    DLListCell* cell;
+
+    if (self->value_index == NULL)
+        return 1;
+
+    for (cell = first; cell != stop; cell = cell->next)
+    {
+        PyObject* node;
+        int found;
+
+        found = PyDict_Contains(self->value_index, cell->value);
+        if (found == 1)
+            PyErr_SetString(PyExc_ValueError, "Value already in list");
+        if (found != 0)
             break;
-        case Py_LE:
-            satisfied = ((PyObject*)self_node == Py_None);
+
+        node = dllistnode_from_cell((PyObject*)self, cell);
+        if (node == NULL)
             break;
-        case Py_GE:
-            satisfied = ((PyObject*)other_node == Py_None);
+
+        found = PyDict_SetItem(self->value_index, cell->value, node);
+        Py_DECREF(node);
+        if (found == -1)
             break;
-        default:
-            assert(0 && "Invalid rich compare operator");
-            PyErr_SetString(PyExc_ValueError, "Invalid rich compare operator");
-            return NULL;
-        }
     }
-    else if (op != Py_EQ)
+
+    if (cell == stop)
+        return 1;
+
+    PyErr_Fetch(&err_type, &err_value, &err_traceback);
+
+    for (; first != cell; first = first->next)
+        dllist_value_index_discard(self, first);
+
+    PyErr_Restore(err_type, err_value, err_traceback);
+
+    return 0;
+}
+
+/* Convenience function for looking up a value in the unique index.
+ * Returns the node holding the value as a borrowed reference, or NULL
+ * if there is no such node. Check PyErr_Occurred() in the latter case. */
+static PyObject* dllist_value_index_lookup(DLListObject* self,
+                                           PyObject* value)
+{
+    /* PyDict_GetItem() would hide errors of unhashable values */
+    if (PyObject_Hash(value) == -1)
+        return NULL;
+
+    return PyDict_GetItem(self->value_index, value);
+}
+
+/* Convenience function for linking cells into the list.
+ * The cell is inserted before next, or at the end of the list
+ * if next is NULL. */
+static void dllist_link_cell(DLListObject* self,
+                             DLListCell* cell,
+                             DLListCell* next)
+{
+    DLListCell* prev = (next != NULL) ? next->prev : self->last;
+
+    if (self->num_fingers > 0 && next != NULL)
+        dllist_fingers_insert(self, dllist_cell_position(self, next), 1);
+
+    cell->prev = prev;
+    cell->next = next;
+
+    if (prev != NULL)
+        prev->next = cell;
+    else
+        self->first = cell;
+
+    if (next != NULL)
+        next->prev = cell;
+    else
+        self->last = cell;
+
+    ++self->size;
+    ++self->state;
+
+    if (self->index != NULL)
+        dllistindex_insert(self->index, (DLListIndexCell*)cell);
+}
+
+/* Convenience function for unlinking cells from the list without
+ * touching the unique index. Automatically updates pointers
+ * in neighbours. The cell itself is not released. */
+static void dllist_detach_cell(DLListObject* self, DLListCell* cell)
+{
+    if (self->num_fingers > 0)
+        dllist_fingers_remove(self, cell);
+
+    if (self->index != NULL)
+        dllistindex_remove(self->index, (DLListIndexCell*)cell);
+
+    if (cell->prev != NULL)
+        cell->prev->next = cell->next;
+    else
+        self->first = cell->next;
+
+    if (cell->next != NULL)
+        cell->next->prev = cell->prev;
+    else
+        self->last = cell->prev;
+
+    cell->prev = NULL;
+    cell->next = NULL;
+
+    --self->size;
+    ++self->state;
+}
+
+/* Convenience function for unlinking cells from the list.
+ * Automatically updates pointers in neighbours. The cell itself
+ * is not released. */
+static void dllist_unlink_cell(DLListObject* self, DLListCell* cell)
+{
+    dllist_detach_cell(self, cell);
+    dllist_value_index_discard(self, cell);
+}
+
+/* Convenience function for unlinking a range of count cells from first
+ * to last (inclusive). Cells keep their links within the range. */
+static void dllist_unlink_range(DLListObject* self,
+                                DLListCell* first,
+                                DLListCell* last,
+                                Py_ssize_t count)
+{
+    DLListIndex* index = self->index;
+    DLListCell* cell;
+
+    /* positions of fingers are not tracked across bulk removal */
+    self->num_fingers = 0;
+
+    if (index != NULL)
     {
-        /* Both nodes are valid, but not equal */
-        satisfied = PyObject_RichCompareBool(
-            self_node->value, other_node->value, op);
+        if (count == self->size)
+            index->levels = 1;
+        else if (count > self->size / 16)
+            self->index = NULL;     /* rebuilt below */
+        else
+        {
+            /* Cells are removed from the index in reverse order, so that
+             * cells preceding the removed one are still indexed. */
+            for (cell = last; cell != first->prev; cell = cell->prev)
+                dllistindex_remove(index, (DLListIndexCell*)cell);
+        }
     }
 
-    if (satisfied)
-        Py_RETURN_TRUE;
+    if (first->prev != NULL)
+        first->prev->next = last->next;
     else
-        Py_RETURN_FALSE;
+        self->first = last->next;
+
+    if (last->next != NULL)
+        last->next->prev = first->prev;
+    else
+        self->last = first->prev;
+
+    first->prev = NULL;
+    last->next = NULL;
+
+    self->size -= count;
+    ++self->state;
+
+    if (index != NULL && self->index == NULL)
+    {
+        self->index = index;
+        dllistindex_rebuild(index, self->first);
+    }
+
+    if (self->value_index != NULL)
+    {
+        for (cell = first; cell != NULL; cell = cell->next)
+            dllist_value_index_discard(self, cell);
+    }
 }
 
-static PyObject* dllist_appendleft(DLListObject* self, PyObject* arg)
+/* Convenience function for linking a range of count unlinked cells
+ * from first to last (inclusive) before next, or at the end of the list
+ * if next is NULL. Nodes of the cells are transferred to the list.
+ * In lists with a unique index, the cells must be added to the index
+ * beforehand. */
+static void dllist_link_range(DLListObject* self,
+                              DLListCell* first,
+                              DLListCell* last,
+                              Py_ssize_t count,
+                              DLListCell* next)
 {
-    DLListNodeObject* new_node;
+    DLListCell* prev = (next != NULL) ? next->prev : self->last;
+    DLListCell* cell;
+    int rebuild_index;
 
-    if (PyObject_TypeCheck(arg, &DLListNodeType))
-        arg = ((DLListNodeObject*)arg)->value;
+    if (self->num_fingers > 0 && next != NULL)
+        dllist_fingers_insert(self, dllist_cell_position(self, next), count);
+
+    first->prev = prev;
+    last->next = next;
+
+    if (prev != NULL)
+        prev->next = first;
+    else
+        self->first = first;
 
-    new_node = dllistnode_create(NULL, self->first, arg, (PyObject*)self);
+    if (next != NULL)
+        next->prev = last;
+    else
+        self->last = last;
 
-    self->first = (PyObject*)new_node;
+    self->size += count;
+    ++self->state;
 
-    if (self->last == Py_None)
-        self->last = (PyObject*)new_node;
+    rebuild_index = (self->index != NULL && count > self->size / 16);
 
-    if (self->last_accessed_idx >= 0)
-        ++self->last_accessed_idx;
+    for (cell = first; cell != next; cell = cell->next)
+    {
+        if (cell->node != NULL)
+            cell->node->list = (PyObject*)self;
 
-    ++self->size;
+        if (self->index != NULL && !rebuild_index)
+            dllistindex_insert(self->index, (DLListIndexCell*)cell);
+    }
 
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
+    if (rebuild_index)
+        dllistindex_rebuild(self->index, self->first);
 }
 
-static PyObject* dllist_appendright(DLListObject* self, PyObject* arg)
+/* Convenience function for inserting values before next (or at
+ * the end of the list if next is NULL). Returns the node of the new
+ * element as a new reference. */
+static PyObject* dllist_insert_value(DLListObject* self,
+                                     PyObject* value,
+                                     DLListCell* next)
 {
-    DLListNodeObject* new_node;
+    DLListCell* cell;
+    PyObject* node;
+
+    cell = dllist_new_cell(self, value);
+    if (cell == NULL)
+        return NULL;
+
+    node = dllistnode_from_cell((PyObject*)self, cell);
+    if (node == NULL)
+    {
+        dllistcell_free(cell);
+        return NULL;
+    }
+
+    if (!dllist_value_index_add(self, cell, NULL))
+    {
+        Py_DECREF(node);
+        dllistcell_free(cell);
+        return NULL;
+    }
+
+    dllist_link_cell(self, cell, next);
+
+    return node;
+}
+
+/* Convenience function for locating list cells using index.
+ * The located cell is recorded in a finger. */
+static DLListCell* dllist_get_cell_internal(DLListObject* self,
+                                            Py_ssize_t index)
+{
+    Py_ssize_t i;
+    DLListCell* cell;
+    Py_ssize_t start_pos;
+    Py_ssize_t distance;
+    int slot = -1;
+
+    if (index >= self->size || index < 0)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        return NULL;
+    }
+
+    /* pick the closest base node */
+    if (index <= self->size / 2)
+    {
+        cell = self->first;
+        start_pos = 0;
+    }
+    else
+    {
+        cell = self->last;
+        start_pos = self->size - 1;
+    }
+
+    distance = py_ssize_t_abs(index - start_pos);
+
+    /* check if any of fingers is closer */
+    for (i = 0; i < self->num_fingers; ++i)
+    {
+        Py_ssize_t finger_distance =
+            py_ssize_t_abs(index - self->fingers[i].idx);
+
+        if (finger_distance <= distance)
+        {
+            slot = (int)i;
+            distance = finger_distance;
+        }
+    }
+
+    if (slot >= 0)
+    {
+        cell = self->fingers[slot].cell;
+        start_pos = self->fingers[slot].idx;
+    }
+
+    assert(cell != NULL);
+
+    if (self->index != NULL && distance > DLLIST_INDEX_SCAN_LIMIT)
+    {
+        /* descend the skip list if no known cell is close enough */
+        cell = dllistindex_select(self->index, self->first, index);
+        slot = -1;
+    }
+    else if (index >= start_pos)
+    {
+        /* forward scan */
+        for (i = start_pos; i < index; ++i)
+            cell = cell->next;
+    }
+    else
+    {
+        /* backward scan */
+        for (i = start_pos; i > index; --i)
+            cell = cell->prev;
+    }
+
+    if (slot >= 0)
+        ++self->finger_hits;
+    else
+        ++self->finger_misses;
+
+    /* A finger is moved along with sequential accesses, but jumps
+     * to distant positions take a new finger, so that a few hot regions
+     * of the list can be tracked at once. */
+    if (slot >= 0 &&
+        distance > self->size / (2 * DLLIST_NUM_FINGERS))
+        slot = -1;
+
+    dllist_touch_finger(self, slot, cell, index);
+
+    return cell;
+}
+
+/* Convenience function for releasing an unlinked chain of cells,
+ * such as one returned by dllist_unlink_slice(). */
+static void dllist_free_cells(DLListCell* cell)
+{
+    while (cell != NULL)
+    {
+        DLListCell* next = cell->next;
+
+        dllistcell_free(cell);
+        cell = next;
+    }
+}
+
+/* Convenience function for adding a new cell to an unlinked chain
+ * of cells, either at its end or at its beginning if left is nonzero. */
+static int dllist_chain_add(DLListObject* self,
+                            DLListCell** first,
+                            DLListCell** last,
+                            PyObject* value,
+                            int left)
+{
+    DLListCell* cell = dllist_new_cell(self, value);
+    if (cell == NULL)
+        return 0;
+
+    if (left)
+    {
+        cell->next = *first;
+        if (*first != NULL)
+            (*first)->prev = cell;
+        else
+            *last = cell;
+        *first = cell;
+    }
+    else
+    {
+        cell->prev = *last;
+        if (*last != NULL)
+            (*last)->next = cell;
+        else
+            *first = cell;
+        *last = cell;
+    }
+
+    return 1;
+}
+
+/* Convenience function for extending the list with elements
+ * from an iterable. Elements are inserted at the end of the list,
+ * or at the beginning (in reversed order) if left is nonzero.
+ *
+ * New cells are collected in a chain, which is linked into the list
+ * at once, so that the list does not change while it is extended with
+ * itself. Lists and tuples are read directly, other iterables are
+ * consumed through the iterator protocol without building a temporary
+ * sequence. As in list.extend(), elements collected before an error
+ * are still added. */
+static int dllist_extend_internal(DLListObject* self,
+                                  PyObject* iterable,
+                                  int left)
+{
+    DLListCell* first = NULL;
+    DLListCell* last = NULL;
+    Py_ssize_t count = 0;
+    int indexed = (self->index != NULL);
+    int unique = (self->value_index != NULL);
+    int ok = 1;
+
+    if (PyObject_TypeCheck(iterable, &DLListType))
+    {
+        DLListCell* iter_cell = ((DLListObject*)iterable)->first;
+
+        for (; iter_cell != NULL; iter_cell = iter_cell->next, ++count)
+        {
+            if (!dllist_chain_add(self, &first, &last, iter_cell->value, left))
+            {
+                ok = 0;
+                break;
+            }
+        }
+    }
+    else if (PyList_Check(iterable) || PyTuple_Check(iterable))
+    {
+        PyObject** items = PySequence_Fast_ITEMS(iterable);
+        Py_ssize_t len = PySequence_Fast_GET_SIZE(iterable);
+
+        for (; count < len; ++count)
+        {
+            if (!dllist_chain_add(self, &first, &last, items[count], left))
+            {
+                ok = 0;
+                break;
+            }
+        }
+    }
+    else
+    {
+        PyObject* iterator;
+        PyObject* item;
+
+        iterator = PyObject_GetIter(iterable);
+        if (iterator == NULL)
+            return 0;
+
+        while ((item = PyIter_Next(iterator)) != NULL)
+        {
+            ok = dllist_chain_add(self, &first, &last, item, left);
+            Py_DECREF(item);
+            if (!ok)
+                break;
+            ++count;
+        }
+
+        Py_DECREF(iterator);
+
+        if (PyErr_Occurred())
+            ok = 0;
+
+        /* iterator code might have reinitialized an empty list */
+        if (indexed != (self->index != NULL) ||
+            unique != (self->value_index != NULL))
+        {
+            dllist_free_cells(first);
+            PyErr_SetString(PyExc_RuntimeError,
+                "List indexing changed during extension");
+            return 0;
+        }
+    }
+
+    if (count > 0 && unique)
+    {
+        PyObject* err_type;
+        PyObject* err_value;
+        PyObject* err_traceback;
+
+        /* Elements are added to the unique index as a whole. An error
+         * raised before still takes precedence over a duplicate value. */
+        PyErr_Fetch(&err_type, &err_value, &err_traceback);
+
+        if (!dllist_value_index_add(self, first, NULL))
+        {
+            dllist_free_cells(first);
+            count = 0;
+            ok = 0;
+        }
+
+        if (err_type != NULL)
+            PyErr_Restore(err_type, err_value, err_traceback);
+    }
+
+    if (count > 0)
+        dllist_link_range(self, first, last, count, left ? self->first : NULL);
+
+    return ok;
+}
+
+/* Convenience function for formatting list to a string.
+ * Pass PyObject_Repr or PyObject_Str in the fmt_func argument. */
+static PyObject* dllist_to_string(DLListObject* self,
+                                  reprfunc fmt_func)
+{
+    PyObject* str = NULL;
+    PyObject* comma_str = NULL;
+    PyObject* tmp_str;
+    DLListCell* cell = self->first;
+
+    assert(fmt_func != NULL);
+
+    if (self->first == NULL)
+    {
+        str = Py23String_FromString("dllist()");
+        if (str == NULL)
+            goto str_alloc_error;
+        return str;
+    }
+
+    str = Py23String_FromString("dllist([");
+    if (str == NULL)
+        goto str_alloc_error;
+
+    comma_str = Py23String_FromString(", ");
+    if (comma_str == NULL)
+        goto str_alloc_error;
+
+    while (cell != NULL)
+    {
+        if (cell != self->first)
+            Py23String_Concat(&str, comma_str);
+
+        tmp_str = fmt_func(cell->value);
+        if (tmp_str == NULL)
+            goto str_alloc_error;
+        Py23String_ConcatAndDel(&str, tmp_str);
+
+        cell = cell->next;
+    }
+
+    Py_DECREF(comma_str);
+    comma_str = NULL;
+
+    tmp_str = Py23String_FromString("])");
+    if (tmp_str == NULL)
+        goto str_alloc_error;
+    Py23String_ConcatAndDel(&str, tmp_str);
+
+    return str;
+
+str_alloc_error:
+    Py_XDECREF(str);
+    Py_XDECREF(comma_str);
+    PyErr_SetString(PyExc_RuntimeError, "Failed to create string");
+    return NULL;
+}
+
+static void dllist_dealloc(DLListObject* self)
+{
+    DLListCell* cell = self->first;
+
+    if (self->weakref_list != NULL)
+        PyObject_ClearWeakRefs((PyObject*)self);
+
+    while (cell != NULL)
+    {
+        DLListCell* next_cell = cell->next;
+        dllistcell_delete(cell);
+        cell = next_cell;
+    }
+
+    /* releases detached nodes along with their cells */
+    Py_XDECREF(self->value_index);
+
+    PyMem_Free(self->index);
+
+    PyObject_Del((PyObject*)self);
+}
+
+static PyObject* dllist_new(PyTypeObject* type,
+                            PyObject* args,
+                            PyObject* kwds)
+{
+    DLListObject* self;
+
+    self = (DLListObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->first = NULL;
+    self->last = NULL;
+    self->num_fingers = 0;
+    self->finger_hits = 0;
+    self->finger_misses = 0;
+    self->size = 0;
+    self->state = 0;
+    self->sorting = 0;
+    self->index = NULL;
+    self->value_index = NULL;
+    self->weakref_list = NULL;
+
+    return (PyObject*)self;
+}
+
+/* Convenience function for turning the index on or off. */
+static int dllist_set_indexed(DLListObject* self, int indexed)
+{
+    if (indexed == (self->index != NULL))
+        return 1;
+
+    if (self->first != NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot change indexing of a non-empty list");
+        return 0;
+    }
+
+    if (indexed)
+    {
+        self->index = dllistindex_new();
+        if (self->index == NULL)
+            return 0;
+    }
+    else
+    {
+        PyMem_Free(self->index);
+        self->index = NULL;
+    }
+
+    return 1;
+}
+
+/* Convenience function for turning the unique index on or off. */
+static int dllist_set_unique_index(DLListObject* self, int unique)
+{
+    if (unique == (self->value_index != NULL))
+        return 1;
+
+    if (self->first != NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot change unique index of a non-empty list");
+        return 0;
+    }
+
+    if (unique)
+    {
+        self->value_index = PyDict_New();
+        if (self->value_index == NULL)
+            return 0;
+    }
+    else
+        Py_CLEAR(self->value_index);
+
+    return 1;
+}
+
+static int dllist_init(DLListObject* self, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = { "iterable", "indexed", "unique_index", NULL };
+    PyObject* sequence = NULL;
+    PyObject* indexed = NULL;
+    PyObject* unique_index = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO:dllist", kwlist,
+                                     &sequence, &indexed, &unique_index))
+        return -1;
+
+    if (unique_index != NULL)
+    {
+        int is_true = PyObject_IsTrue(unique_index);
+        if (is_true == -1)
+            return -1;
+
+        if (!dllist_set_unique_index(self, is_true))
+            return -1;
+    }
+
+    if (indexed != NULL)
+    {
+        int is_true = PyObject_IsTrue(indexed);
+        if (is_true == -1)
+            return -1;
+
+        if (!dllist_set_indexed(self, is_true))
+            return -1;
+    }
+
+    if (sequence == NULL)
+        return 0;
+
+    /* initialize list using passed iterable */
+    return dllist_extend_internal(self, sequence, 0) ? 0 : -1;
+}
+
+#ifdef Py23_HAVE_VECTORCALL
+/* Fast path for constructing lists from positional arguments.
+ * Keyword arguments are handled by dllist_init(). */
+static PyObject* dllist_vectorcall(PyObject* type,
+                                 PyObject* const* args,
+                                 size_t nargsf,
+                                 PyObject* kwnames)
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    PyObject* self;
+
+    if (kwnames != NULL || nargs > 1)
+        return Py23Type_VectorcallFallback(type, args, nargsf, kwnames);
+
+    self = dllist_new((PyTypeObject*)type, NULL, NULL);
+    if (self == NULL)
+        return NULL;
+
+    if (nargs == 1 &&
+        !dllist_extend_internal((DLListObject*)self, args[0], 0))
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+#endif
+
+static PyObject* dllist_node_at(PyObject* self, PyObject* indexObject)
+{
+    DLListCell* cell;
+    Py_ssize_t index;
+
+    if (!Py23Int_Check(indexObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
+        return NULL;
+    }
+
+    index = Py23Int_AsSsize_t(indexObject);
+
+    if (index < 0)
+        index = ((DLListObject*)self)->size + index;
+
+    cell = dllist_get_cell_internal((DLListObject*)self, index);
+    if (cell == NULL)
+        return NULL;
+
+    return dllistnode_from_cell(self, cell);
+}
+
+static PyObject* dllist_repr(DLListObject* self)
+{
+    return dllist_to_string(self, PyObject_Repr);
+}
+
+static PyObject* dllist_str(DLListObject* self)
+{
+    return dllist_to_string(self, PyObject_Str);
+}
+
+static long dllist_hash(DLListObject* self)
+{
+    long hash = 0;
+    DLListCell* iter_cell = self->first;
+
+    while (iter_cell != NULL)
+    {
+        long obj_hash;
+
+        obj_hash = PyObject_Hash(iter_cell->value);
+        if (obj_hash == -1)
+            return -1;
+
+        hash ^= obj_hash;
+        iter_cell = iter_cell->next;
+    }
+
+    return hash;
+}
+
+static PyObject* dllist_richcompare(DLListObject* self,
+                                    DLListObject* other,
+                                    int op)
+{
+    DLListCell* self_cell;
+    DLListCell* other_cell;
+    int satisfied = 1;
+
+    if (!PyObject_TypeCheck(other, &DLListType))
+    {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (self == other &&
+        (op == Py_EQ || op == Py_LE || op == Py_GE))
+        Py_RETURN_TRUE;
+
+    if (self->size != other->size)
+    {
+        if (op == Py_EQ)
+            Py_RETURN_FALSE;
+        else if (op == Py_NE)
+            Py_RETURN_TRUE;
+    }
+
+    /* Scan through sequences' items as long as they are equal. */
+    self_cell = self->first;
+    other_cell = other->first;
+
+    while (self_cell != NULL && other_cell != NULL)
+    {
+        satisfied = PyObject_RichCompareBool(
+            self_cell->value, other_cell->value, Py_EQ);
+
+        if (satisfied == 0)
+            break;
+
+        if (satisfied == -1)
+            return NULL;
+
+        self_cell = self_cell->next;
+        other_cell = other_cell->next;
+    }
+
+    /* Compare last item */
+    if (satisfied)
+    {
+        /* At least one of operands has been fully traversed.
+         * Either self_cell or other_cell is equal to NULL. */
+        switch (op)
+        {
+        case Py_EQ:
+            satisfied = (self_cell == other_cell);
+            break;
+        case Py_NE:
+            satisfied = (self_cell != other_cell);
+            break;
+        case Py_LT:
+            satisfied = (other_cell != NULL);
+            break;
+        case Py_GT:
+            satisfied = (self_cell != NULL);
+            break;
+        case Py_LE:
+            satisfied = (self_cell == NULL);
+            break;
+        case Py_GE:
+            satisfied = (other_cell == NULL);
+            break;
+        default:
+            assert(0 && "Invalid rich compare operator");
+            PyErr_SetString(PyExc_ValueError, "Invalid rich compare operator");
+            return NULL;
+        }
+    }
+    else if (op != Py_EQ)
+    {
+        /* Both nodes are valid, but not equal */
+        satisfied = PyObject_RichCompareBool(
+            self_cell->value, other_cell->value, op);
+    }
+
+    if (satisfied)
+        Py_RETURN_TRUE;
+    else
+        Py_RETURN_FALSE;
+}
+
+static PyObject* dllist_get_first(DLListObject* self, void* closure)
+{
+    return dllistnode_from_cell((PyObject*)self, self->first);
+}
+
+static PyObject* dllist_get_last(DLListObject* self, void* closure)
+{
+    return dllistnode_from_cell((PyObject*)self, self->last);
+}
+
+static PyObject* dllist_get_indexed(DLListObject* self, void* closure)
+{
+    return PyBool_FromLong(self->index != NULL);
+}
+
+static PyObject* dllist_get_unique_index(DLListObject* self, void* closure)
+{
+    return PyBool_FromLong(self->value_index != NULL);
+}
+
+static PyObject* dllist_appendleft(DLListObject* self, PyObject* arg)
+{
+    PyObject* new_node;
+
+    new_node = dllist_insert_value(self, dllist_value_arg(arg), self->first);
+    if (new_node == NULL)
+        return NULL;
+
+    return new_node;
+}
+
+static PyObject* dllist_appendright(DLListObject* self, PyObject* arg)
+{
+    return dllist_insert_value(self, dllist_value_arg(arg), NULL);
+}
+
+static PyObject* dllist_insert(DLListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* val = NULL;
+    PyObject* ref_node = NULL;
+    DLListCell* ref_cell;
+    PyObject* new_node;
+
+    if (!Py23Args_Unpack("insert", Py23_FASTCALL_ARGS,
+                         1, 2, &val, &ref_node))
+        return NULL;
+
+    val = dllist_value_arg(val);
+
+    if (ref_node == NULL || ref_node == Py_None)
+    {
+        /* append item at the end of the list */
+        return dllist_insert_value(self, val, NULL);
+    }
+
+    /* insert item before ref_node */
+    ref_cell = dllist_node_arg(
+        self, ref_node, "ref_node argument must be a dllistnode");
+    if (ref_cell == NULL)
+        return NULL;
+
+    new_node = dllist_insert_value(self, val, ref_cell);
+    if (new_node == NULL)
+        return NULL;
+
+    return new_node;
+}
+
+static PyObject* dllist_extendleft(DLListObject* self, PyObject* arg)
+{
+    if (!dllist_extend_internal(self, arg, 1))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_extendright(DLListObject* self, PyObject* arg)
+{
+    if (!dllist_extend_internal(self, arg, 0))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_clear(DLListObject* self)
+{
+    DLListCell* iter_cell = self->first;
+
+    while (iter_cell != NULL)
+    {
+        DLListCell* cell = iter_cell;
+
+        iter_cell = iter_cell->next;
+        dllistcell_delete(cell);
+    }
+
+    /* invalidate fingers */
+    self->num_fingers = 0;
+
+    self->first = NULL;
+    self->last = NULL;
+    self->size = 0;
+    ++self->state;
+
+    if (self->index != NULL)
+        self->index->levels = 1;
+
+    /* releases detached nodes along with their cells */
+    if (self->value_index != NULL)
+        PyDict_Clear(self->value_index);
+
+    Py_RETURN_NONE;
+}
+
+/* Convenience function for removing cells from the list.
+ * Returns the value stored in the cell as a new reference. */
+static PyObject* dllist_remove_cell(DLListObject* self, DLListCell* del_cell)
+{
+    PyObject* value;
+
+    dllist_unlink_cell(self, del_cell);
+
+    Py_INCREF(del_cell->value);
+    value = del_cell->value;
+
+    dllistcell_delete(del_cell);
+
+    return value;
+}
+
+static PyObject* dllist_popleft(DLListObject* self)
+{
+    if (self->first == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    return dllist_remove_cell(self, self->first);
+}
+
+static PyObject* dllist_popright(DLListObject* self)
+{
+    if (self->last == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    return dllist_remove_cell(self, self->last);
+}
+
+static PyObject* dllist_remove(DLListObject* self, PyObject* arg)
+{
+    DLListCell* del_cell;
+
+    if (!PyObject_TypeCheck(arg, &DLListNodeType))
+    {
+        PyErr_SetString(PyExc_TypeError, "Argument must be a dllistnode");
+        return NULL;
+    }
+
+    /* nodes of a list being sorted are rejected by node argument check */
+    if (self->first == NULL && !self->sorting)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    del_cell = dllist_node_arg(self, arg, "Argument must be a dllistnode");
+    if (del_cell == NULL)
+        return NULL;
+
+    return dllist_remove_cell(self, del_cell);
+}
+
+static PyObject* dllist_remove_value(DLListObject* self, PyObject* value)
+{
+    DLListCell* cell;
+
+    if (self->value_index != NULL)
+    {
+        PyObject* node = dllist_value_index_lookup(self, value);
+        if (node == NULL)
+        {
+            if (!PyErr_Occurred())
+                PyErr_SetString(PyExc_ValueError, "Value not found");
+            return NULL;
+        }
+
+        return dllist_remove_cell(self, ((DLListNodeObject*)node)->cell);
+    }
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        int match = dllist_cell_matches(self, cell, value, "remove_value");
+        if (match == -1)
+            return NULL;
+
+        if (match)
+            return dllist_remove_cell(self, cell);
+    }
+
+    PyErr_SetString(PyExc_ValueError, "Value not found");
+    return NULL;
+}
+
+static PyObject* dllist_remove_if(DLListObject* self, PyObject* predicate)
+{
+    DLListCell* cell = self->first;
+    DLListCell* removed = NULL;
+    Py_ssize_t count = 0;
+
+    /* positions of fingers are not tracked across bulk removal */
+    self->num_fingers = 0;
+
+    while (cell != NULL)
+    {
+        DLListCell* next;
+        PyObject* value = cell->value;
+        PyObject* result;
+        Py_ssize_t state = self->state;
+        int match;
+
+        Py_INCREF(value);
+        result = PyObject_CallFunctionObjArgs(predicate, value, NULL);
+        Py_DECREF(value);
+        if (result == NULL)
+            break;
+
+        match = PyObject_IsTrue(result);
+        Py_DECREF(result);
+        if (match == -1)
+            break;
+
+        if (state != self->state)
+        {
+            PyErr_SetString(PyExc_RuntimeError,
+                "dllist modified during remove_if()");
+            break;
+        }
+
+        next = cell->next;
+
+        if (match)
+        {
+            dllist_unlink_cell(self, cell);
+
+            /* values are released once the traversal is finished */
+            if (cell->node != NULL)
+                dllistcell_delete(cell);
+            else
+            {
+                cell->next = removed;
+                removed = cell;
+            }
+
+            ++count;
+        }
+
+        cell = next;
+    }
+
+    dllist_free_cells(removed);
+
+    if (cell != NULL)
+        return NULL;
+
+    return Py23Int_FromSsize_t(count);
+}
+
+static PyObject* dllist_remove_nodes(DLListObject* self, PyObject* iterable)
+{
+    DLListIndex* index = self->index;
+    PyObject* sequence;
+    PyObject** items;
+    Py_ssize_t len;
+    Py_ssize_t count = 0;
+    Py_ssize_t i;
+
+    sequence = PySequence_Fast(iterable, "Argument must be iterable");
+    if (sequence == NULL)
+        return NULL;
+
+    items = PySequence_Fast_ITEMS(sequence);
+    len = PySequence_Fast_GET_SIZE(sequence);
+
+    /* verify all nodes before removing any of them */
+    for (i = 0; i < len; ++i)
+    {
+        if (dllist_node_arg(self, items[i],
+                            "Argument must contain dllistnodes") == NULL)
+        {
+            Py_DECREF(sequence);
+            return NULL;
+        }
+    }
+
+    /* Positions of fingers are not tracked across bulk removal.
+     * Removing a large part of an indexed list is faster without
+     * maintaining the index and rebuilding it afterwards. */
+    self->num_fingers = 0;
+
+    if (index != NULL && len > self->size / 16)
+        self->index = NULL;
+
+    for (i = 0; i < len; ++i)
+    {
+        DLListNodeObject* node = (DLListNodeObject*)items[i];
+
+        /* skip nodes passed more than once */
+        if (node->list != (PyObject*)self)
+            continue;
+
+        dllist_unlink_cell(self, node->cell);
+        dllistcell_delete(node->cell);
+        ++count;
+    }
+
+    if (index != NULL && self->index == NULL)
+    {
+        self->index = index;
+        dllistindex_rebuild(index, self->first);
+    }
+
+    Py_DECREF(sequence);
+
+    return Py23Int_FromSsize_t(count);
+}
+
+static PyObject* dllist_find(DLListObject* self, PyObject* value)
+{
+    DLListCell* cell;
+
+    if (self->value_index != NULL)
+    {
+        PyObject* node = dllist_value_index_lookup(self, value);
+        if (node == NULL)
+        {
+            if (PyErr_Occurred())
+                return NULL;
+
+            Py_RETURN_NONE;
+        }
+
+        Py_INCREF(node);
+        return node;
+    }
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        int match = dllist_cell_matches(self, cell, value, "find");
+        if (match == -1)
+            return NULL;
+
+        if (match)
+            return dllistnode_from_cell((PyObject*)self, cell);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_index(DLListObject* self, PyObject* args)
+{
+    PyObject* value;
+    DLListCell* cell;
+    Py_ssize_t start = 0;
+    Py_ssize_t stop = PY_SSIZE_T_MAX;
+    Py_ssize_t pos;
+
+    if (!PyArg_ParseTuple(args, "O|nn:index", &value, &start, &stop))
+        return NULL;
+
+    if (start < 0)
+    {
+        start += self->size;
+        if (start < 0)
+            start = 0;
+    }
+
+    if (stop < 0)
+        stop += self->size;
+
+    if (stop > self->size)
+        stop = self->size;
+
+    if (start < stop)
+    {
+        cell = dllist_get_cell_internal(self, start);
+        assert(cell != NULL);
+
+        for (pos = start; pos < stop && cell != NULL; ++pos)
+        {
+            int match = dllist_cell_matches(self, cell, value, "index");
+            if (match == -1)
+                return NULL;
+
+            if (match)
+                return Py23Int_FromSsize_t(pos);
+
+            cell = cell->next;
+        }
+    }
+
+    PyErr_SetString(PyExc_ValueError, "Value not found");
+    return NULL;
+}
+
+static PyObject* dllist_count(DLListObject* self, PyObject* value)
+{
+    DLListCell* cell;
+    Py_ssize_t count = 0;
+
+    if (self->value_index != NULL)
+    {
+        int found = PyDict_Contains(self->value_index, value);
+        if (found == -1)
+            return NULL;
+
+        return Py23Int_FromSsize_t(found);
+    }
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        int match = dllist_cell_matches(self, cell, value, "count");
+        if (match == -1)
+            return NULL;
+
+        count += match;
+    }
+
+    return Py23Int_FromSsize_t(count);
+}
+
+/* Convenience function for raising RuntimeError if the list has been
+ * modified by code run while its elements were reduced. */
+static int dllist_check_reduce_state(DLListObject* self,
+                                     Py_ssize_t state,
+                                     const char* method)
+{
+    if (state == self->state)
+        return 1;
+
+    PyErr_Format(PyExc_RuntimeError,
+        "dllist modified during %s()", method);
+    return 0;
+}
+
+/* Convenience function for summing elements. The method name
+ * is used in error messages. */
+static PyObject* dllist_sum_internal(DLListObject* self, const char* method)
+{
+    DLListCell* cell;
+    Py_ssize_t state = self->state;
+    LListSum sum;
+
+    llist_sum_init(&sum);
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        if (!llist_sum_add(&sum, cell->value) ||
+            !dllist_check_reduce_state(self, state, method))
+        {
+            llist_sum_clear(&sum);
+            return NULL;
+        }
+    }
+
+    return llist_sum_result(&sum);
+}
+
+static PyObject* dllist_sum(DLListObject* self)
+{
+    return dllist_sum_internal(self, "sum");
+}
+
+static PyObject* dllist_mean(DLListObject* self)
+{
+    Py_ssize_t count = self->size;
+
+    return llist_mean(dllist_sum_internal(self, "mean"), count);
+}
+
+/* Convenience function for finding the smallest (op == Py_LT)
+ * or the largest (op == Py_GT) element. */
+static PyObject* dllist_extremum(DLListObject* self,
+                                 int op,
+                                 const char* method)
+{
+    DLListCell* cell;
+    Py_ssize_t state = self->state;
+    LListExtremum ext;
+
+    llist_extremum_init(&ext, op);
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        if (!llist_extremum_update(&ext, cell->value) ||
+            !dllist_check_reduce_state(self, state, method))
+        {
+            llist_extremum_clear(&ext);
+            return NULL;
+        }
+    }
+
+    return llist_extremum_result(&ext);
+}
+
+static PyObject* dllist_min(DLListObject* self)
+{
+    return dllist_extremum(self, Py_LT, "min");
+}
+
+static PyObject* dllist_max(DLListObject* self)
+{
+    return dllist_extremum(self, Py_GT, "max");
+}
+
+static PyObject* dllist_rotate(DLListObject* self, PyObject* nObject)
+{
+    Py_ssize_t n;
+    Py_ssize_t split_idx;
+    Py_ssize_t n_mod;
+    DLListCell* new_first;
+    DLListCell* new_last;
+    int i;
+
+    if (self->size <= 1)
+        Py_RETURN_NONE;
+
+    if (!Py23Int_Check(nObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "n must be an integer");
+        return NULL;
+    }
+
+    n = Py23Int_AsSsize_t(nObject);
+    n_mod = py_ssize_t_abs(n) % self->size;
+
+    if (n_mod == 0)
+        Py_RETURN_NONE; /* no-op */
+
+    if (n > 0)
+        split_idx = self->size - n_mod; /* rotate right */
+    else
+        split_idx = n_mod;  /* rotate left */
+
+    new_last = dllist_get_cell_internal(self, split_idx - 1);
+    assert(new_last != NULL);
+    new_first = new_last->next;
+
+    self->first->prev = self->last;
+    self->last->next = self->first;
+
+    new_first->prev = NULL;
+    new_last->next = NULL;
+
+    self->first = new_first;
+    self->last = new_last;
+    ++self->state;
+
+    if (self->index != NULL)
+        dllistindex_rebuild(self->index, self->first);
+
+    for (i = 0; i < self->num_fingers; ++i)
+    {
+        self->fingers[i].idx =
+            (self->fingers[i].idx + self->size - split_idx) % self->size;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_splice(DLListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* other_arg = NULL;
+    PyObject* before_arg = NULL;
+    PyObject* first_arg = NULL;
+    PyObject* last_arg = NULL;
+    DLListObject* other;
+    DLListCell* next = NULL;
+    DLListCell* first;
+    DLListCell* last;
+    Py_ssize_t count;
+
+    if (!Py23Args_Unpack("splice", Py23_FASTCALL_ARGS, 1, 4,
+                         &other_arg, &before_arg, &first_arg, &last_arg))
+        return NULL;
+
+    if (!PyObject_TypeCheck(other_arg, &DLListType))
+    {
+        PyErr_SetString(PyExc_TypeError, "other argument must be a dllist");
+        return NULL;
+    }
+
+    other = (DLListObject*)other_arg;
+
+    if (other == self)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot splice a list into itself");
+        return NULL;
+    }
+
+    if (before_arg != NULL && before_arg != Py_None)
+    {
+        next = dllist_node_arg(
+            self, before_arg, "before argument must be a dllistnode");
+        if (next == NULL)
+            return NULL;
+    }
+
+    first = other->first;
+    last = other->last;
+
+    if (first_arg != NULL && first_arg != Py_None)
+    {
+        first = dllist_node_arg(
+            other, first_arg, "first argument must be a dllistnode");
+        if (first == NULL)
+            return NULL;
+    }
+
+    if (last_arg != NULL && last_arg != Py_None)
+    {
+        last = dllist_node_arg(
+            other, last_arg, "last argument must be a dllistnode");
+        if (last == NULL)
+            return NULL;
+    }
+
+    if (first == NULL)
+        Py_RETURN_NONE;     /* other list is empty */
+
+    /* cells of non-indexed lists lack skip list links */
+    if (self->index != NULL && other->index == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot splice a non-indexed list into an indexed list");
+        return NULL;
+    }
+
+    if (first == other->first && last == other->last)
+        count = other->size;
+    else
+    {
+        DLListCell* cell = first;
+
+        count = 1;
+        while (cell != last)
+        {
+            cell = cell->next;
+            if (cell == NULL)
+            {
+                PyErr_SetString(PyExc_ValueError,
+                    "last node does not follow first node");
+                return NULL;
+            }
+            ++count;
+        }
+    }
+
+    if (!dllist_value_index_add(self, first, last->next))
+        return NULL;
+
+    dllist_unlink_range(other, first, last, count);
+    dllist_link_range(self, first, last, count, next);
+
+    Py_RETURN_NONE;
+}
+
+/* Convenience function for relinking the cell of a node before next
+ * (or at the end of the list if next is NULL). The node may belong
+ * to this list or to another dllist. */
+static PyObject* dllist_move_node(DLListObject* self,
+                                  PyObject* arg,
+                                  DLListCell* next)
+{
+    DLListNodeObject* node;
+    DLListObject* other;
+    DLListCell* cell;
+
+    if (!PyObject_TypeCheck(arg, &DLListNodeType))
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "node argument must be a dllistnode");
+        return NULL;
+    }
+
+    node = (DLListNodeObject*)arg;
+    other = (DLListObject*)node->list;
+    cell = node->cell;
+
+    if (other == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "dllistnode does not belong to a list");
+        return NULL;
+    }
+
+    if (!dllist_check_node_list((PyObject*)other))
+        return NULL;
+
+    if (other == self)
+    {
+        if (cell == next || cell->next == next)
+            Py_RETURN_NONE;     /* already in place */
+
+        /* the unique index still maps the value to the same node */
+        dllist_detach_cell(self, cell);
+        dllist_link_cell(self, cell, next);
+
+        Py_RETURN_NONE;
+    }
+
+    /* cells of non-indexed lists lack skip list links */
+    if (self->index != NULL && other->index == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot move a node of a non-indexed list into an indexed list");
+        return NULL;
+    }
+
+    if (!dllist_value_index_add(self, cell, cell->next))
+        return NULL;
+
+    dllist_unlink_cell(other, cell);
+    dllist_link_cell(self, cell, next);
+    node->list = (PyObject*)self;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_move_to_front(DLListObject* self, PyObject* arg)
+{
+    return dllist_move_node(self, arg, self->first);
+}
+
+static PyObject* dllist_move_to_back(DLListObject* self, PyObject* arg)
+{
+    return dllist_move_node(self, arg, NULL);
+}
+
+static PyObject* dllist_move_before(DLListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* node_arg;
+    PyObject* ref_arg;
+    DLListCell* ref;
+
+    if (!Py23Args_Unpack("move_before", Py23_FASTCALL_ARGS,
+                         2, 2, &node_arg, &ref_arg))
+        return NULL;
+
+    ref = dllist_node_arg(self, ref_arg, "ref argument must be a dllistnode");
+    if (ref == NULL)
+        return NULL;
+
+    return dllist_move_node(self, node_arg, ref);
+}
+
+static PyObject* dllist_move_after(DLListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* node_arg;
+    PyObject* ref_arg;
+    DLListCell* ref;
+
+    if (!Py23Args_Unpack("move_after", Py23_FASTCALL_ARGS,
+                         2, 2, &node_arg, &ref_arg))
+        return NULL;
+
+    ref = dllist_node_arg(self, ref_arg, "ref argument must be a dllistnode");
+    if (ref == NULL)
+        return NULL;
+
+    /* moving a node after itself leaves it in place */
+    if (PyObject_TypeCheck(node_arg, &DLListNodeType) &&
+        ((DLListNodeObject*)node_arg)->cell == ref)
+        Py_RETURN_NONE;
+
+    return dllist_move_node(self, node_arg, ref->next);
+}
+
+static PyObject* dllist_split(DLListObject* self, PyObject* arg)
+{
+    DLListObject* new_list;
+    DLListCell* first;
+    DLListCell* last = self->last;
+    Py_ssize_t pos;
+    Py_ssize_t count;
+
+    first = dllist_node_arg(self, arg, "Argument must be a dllistnode");
+    if (first == NULL)
+        return NULL;
+
+    new_list = (DLListObject*)dllist_new(&DLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
+
+    if (!dllist_set_indexed(new_list, self->index != NULL) ||
+        !dllist_set_unique_index(new_list, self->value_index != NULL) ||
+        !dllist_value_index_add(new_list, first, NULL))
+    {
+        Py_DECREF(new_list);
+        return NULL;
+    }
+
+    pos = dllist_cell_position(self, first);
+    if (pos < 0)
+    {
+        DLListCell* cell;
+
+        /* count cells of the tail instead */
+        pos = self->size;
+        for (cell = first; cell != NULL; cell = cell->next)
+            --pos;
+    }
+
+    count = self->size - pos;
+
+    dllist_unlink_range(self, first, last, count);
+    dllist_link_range(new_list, first, last, count, NULL);
+
+    return (PyObject*)new_list;
+}
+
+/* Compares values of two cells for sort(). */
+static int dllistcell_less(void* a, void* b)
+{
+    PyObject* x = ((DLListCell*)a)->value;
+    PyObject* y = ((DLListCell*)b)->value;
+
+    /* values need not be protected, since nodes of a list being sorted
+     * cannot replace them */
+    return PyObject_RichCompareBool(x, y, Py_LT);
+}
+
+static PyObject* dllist_sort(DLListObject* self,
+                             PyObject* args,
+                             PyObject* kwds)
+{
+    static char* kwlist[] = { "key", "reverse", NULL };
+    PyObject* key_func = NULL;
+    PyObject* reverse_arg = NULL;
+    PyObject** values = NULL;
+    LListSortChain chain;
+    DLListCell* first = self->first;
+    DLListCell* last = self->last;
+    DLListCell* added;
+    DLListIndex* index = self->index;
+    DLListIndex* added_index;
+    PyObject* value_index = self->value_index;
+    PyObject* added_value_index;
+    DLListCell* cell;
+    DLListCell* prev;
+    void* head;
+    Py_ssize_t state = self->state;
+    Py_ssize_t size = self->size;
+    Py_ssize_t i;
+    int sorting = self->sorting;
+    int reverse = 0;
+    int modified;
+    int result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO:sort", kwlist,
+                                     &key_func, &reverse_arg))
+        return NULL;
+
+    if (key_func == Py_None)
+        key_func = NULL;
+
+    if (reverse_arg != NULL)
+    {
+        reverse = PyObject_IsTrue(reverse_arg);
+        if (reverse == -1)
+            return NULL;
+    }
+
+    if (size < 2)
+        Py_RETURN_NONE;
+
+    if (key_func != NULL)
+    {
+        values = (PyObject**)PyMem_Malloc(size * sizeof(PyObject*));
+        if (values == NULL)
+            return PyErr_NoMemory();
+
+        for (cell = first, i = 0; cell != NULL; cell = cell->next, ++i)
+        {
+            PyObject* value = cell->value;
+            PyObject* key;
+
+            Py_INCREF(value);
+            key = PyObject_CallFunctionObjArgs(key_func, value, NULL);
+            Py_DECREF(value);
+
+            if (key != NULL && state != self->state)
+            {
+                Py_DECREF(key);
+                key = NULL;
+                PyErr_SetString(PyExc_RuntimeError,
+                    "dllist modified during sort()");
+            }
+
+            if (key == NULL)
+            {
+                while (i > 0)
+                    Py_DECREF(values[--i]);
+
+                PyMem_Free(values);
+                return NULL;
+            }
+
+            values[i] = key;
+        }
+
+        /* cells hold keys while they are sorted and values are kept
+         * in the array in the original order */
+        for (cell = first, i = 0; cell != NULL; cell = cell->next, ++i)
+        {
+            PyObject* key = values[i];
+
+            values[i] = cell->value;
+            cell->value = key;
+        }
+    }
+
+    /* Cells are unlinked from the list while they are sorted, so that
+     * the list appears empty to user code run by comparisons. Their
+     * nodes cannot be used to modify the list or read values meanwhile
+     * (see dllist_check_node_list() and dllist_check_node_value()).
+     * Only next links are relinked by the sort; prev links keep
+     * the original order. */
+    self->first = NULL;
+    self->last = NULL;
+    self->size = 0;
+    self->num_fingers = 0;
+    self->index = NULL;
+    self->value_index = NULL;
+    self->sorting = 1;
+    state = ++self->state;
+
+    chain.next_offset = offsetof(DLListCell, next);
+    chain.less = dllistcell_less;
+    chain.reverse = reverse;
+
+    head = first;
+    result = llist_sort_chain(&chain, &head);
+
+    if (values != NULL)
+    {
+        /* put values back into cells, leaving keys in the array */
+        for (cell = last, i = size; cell != NULL; cell = cell->prev)
+        {
+            PyObject* value = values[--i];
+
+            values[i] = cell->value;
+            cell->value = value;
+        }
+    }
+
+    if (result == 0)
+    {
+        first = (DLListCell*)head;
+        for (cell = first, prev = NULL; cell != NULL; cell = cell->next)
+        {
+            cell->prev = prev;
+            prev = cell;
+        }
+
+        last = prev;
+    }
+    else
+    {
+        /* restore the original order */
+        for (cell = last, prev = NULL; cell != NULL; cell = cell->prev)
+        {
+            cell->next = prev;
+            prev = cell;
+        }
+    }
+
+    /* elements added by user code are discarded once the list
+     * is restored */
+    modified = (state != self->state || self->index != NULL ||
+                self->value_index != NULL);
+    added = self->first;
+    added_index = self->index;
+    added_value_index = self->value_index;
+
+    self->first = first;
+    self->last = last;
+    self->size = size;
+    self->num_fingers = 0;
+    self->index = index;
+    self->value_index = value_index;
+    self->sorting = sorting;
+    ++self->state;
+
+    if (index != NULL && result == 0)
+        dllistindex_rebuild(index, first);
+
+    while (added != NULL)
+    {
+        cell = added;
+        added = added->next;
+        dllistcell_delete(cell);
+    }
+
+    PyMem_Free(added_index);
+    Py_XDECREF(added_value_index);
+
+    if (values != NULL)
+    {
+        for (i = 0; i < size; ++i)
+            Py_DECREF(values[i]);
+
+        PyMem_Free(values);
+    }
+
+    if (result == -1)
+        return NULL;
+
+    if (modified)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "dllist modified during sort()");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_reverse(DLListObject* self)
+{
+    DLListCell* cell = self->first;
+    int i;
+
+    if (self->size <= 1)
+        Py_RETURN_NONE;
+
+    while (cell != NULL)
+    {
+        DLListCell* next = cell->next;
+
+        cell->next = cell->prev;
+        cell->prev = next;
+        cell = next;
+    }
+
+    cell = self->first;
+    self->first = self->last;
+    self->last = cell;
+    ++self->state;
+
+    if (self->index != NULL)
+        dllistindex_rebuild(self->index, self->first);
+
+    for (i = 0; i < self->num_fingers; ++i)
+        self->fingers[i].idx = self->size - 1 - self->fingers[i].idx;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* dllist_reversed(PyObject* self)
+{
+    return dllistiterator_create(&DLListIteratorType, self, 1, 0);
+}
+
+static PyObject* dllist_iternodes(PyObject* self)
+{
+    return dllistiterator_create(&DLListIteratorType, self, 0, 1);
+}
+
+static PyObject* dllist_cursor(DLListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* node_arg = NULL;
+    DLListCell* cell = self->first;
+
+    if (!Py23Args_Unpack("cursor", Py23_FASTCALL_ARGS,
+                         0, 1, &node_arg))
+        return NULL;
+
+    if (node_arg != NULL && node_arg != Py_None)
+    {
+        cell = dllist_node_arg(self, node_arg,
+            "node argument must be a dllistnode");
+        if (cell == NULL)
+            return NULL;
+    }
+
+    return dllistcursor_create((PyObject*)self, cell);
+}
+
+static PyObject* dllist_iter(PyObject* self)
+{
+    return dllistiterator_create(&DLListIteratorType, self, 0, 0);
+}
+
+static Py_ssize_t dllist_len(PyObject* self)
+{
+    DLListObject* list = (DLListObject*)self;
+    return list->size;
+}
+
+static int dllist_contains(PyObject* self, PyObject* value)
+{
+    DLListObject* list = (DLListObject*)self;
+    DLListCell* cell;
+
+    if (list->value_index != NULL)
+        return PyDict_Contains(list->value_index, value);
+
+    for (cell = list->first; cell != NULL; cell = cell->next)
+    {
+        int match = dllist_cell_matches(list, cell, value, "__contains__");
+        if (match != 0)
+            return match;
+    }
+
+    return 0;
+}
+
+static PyObject* dllist_concat(PyObject* self, PyObject* other)
+{
+    DLListObject* new_list;
+
+    new_list = (DLListObject*)dllist_new(&DLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
+
+    if (!dllist_set_indexed(new_list,
+                            ((DLListObject*)self)->index != NULL) ||
+        !dllist_extend_internal(new_list, self, 0) ||
+        !dllist_extend_internal(new_list, other, 0))
+    {
+        Py_DECREF(new_list);
+        return NULL;
+    }
+
+    return (PyObject*)new_list;
+}
+
+static PyObject* dllist_inplace_concat(PyObject* self, PyObject* other)
+{
+    if (!dllist_extend_internal((DLListObject*)self, other, 0))
+        return NULL;
+
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject* dllist_repeat(PyObject* self, Py_ssize_t count)
+{
+    DLListObject* new_list;
+    Py_ssize_t i;
+
+    new_list = (DLListObject*)dllist_new(&DLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
+
+    if (!dllist_set_indexed(new_list, ((DLListObject*)self)->index != NULL))
+    {
+        Py_DECREF(new_list);
+        return NULL;
+    }
+
+    for (i = 0; i < count; ++i)
+    {
+        if (!dllist_extend_internal(new_list, self, 0))
+        {
+            Py_DECREF(new_list);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)new_list;
+}
+
+static PyObject* dllist_get_item(PyObject* self, Py_ssize_t index)
+{
+    DLListCell* cell;
+
+    cell = dllist_get_cell_internal((DLListObject*)self, index);
+    if (cell != NULL)
+    {
+        PyObject* value = cell->value;
+
+        Py_XINCREF(value);
+
+        return value;
+    }
+
+    return NULL;
+}
+
+static int dllist_set_item(PyObject* self, Py_ssize_t index, PyObject* val)
+{
+    DLListObject* list = (DLListObject*)self;
+    DLListCell* cell;
+    PyObject* oldval;
+
+    cell = dllist_get_cell_internal(list, index);
+    if (cell == NULL)
+        return -1;
+
+    /* Here is a tricky (and undocumented) part of sequence protocol.
+     * Python will pass NULL as item value when item is deleted with:
+     * del list[index] */
+    if (val == NULL)
+    {
+        Py_DECREF(dllist_remove_cell(list, cell));
+        return 0;
+    }
+
+    /* The rest of this function handles normal assignment:
+     * list[index] = item */
+    val = dllist_value_arg(val);
 
-    if (PyObject_TypeCheck(arg, &DLListNodeType))
-        arg = ((DLListNodeObject*)arg)->value;
+    if (dllist_value_index_reassign(self, cell, 1, 1, &val) == -1)
+        return -1;
 
-    new_node = dllistnode_create(self->last, NULL, arg, (PyObject*)self);
+    oldval = cell->value;
 
-    self->last = (PyObject*)new_node;
+    Py_INCREF(val);
+    cell->value = val;
+    Py_DECREF(oldval);
 
-    if (self->first == Py_None)
-        self->first = (PyObject*)new_node;
+    return 0;
+}
 
-    ++self->size;
+/* Convenience function for moving step cells forward (or backward
+ * if step is negative). */
+static DLListCell* dllist_step_cell(DLListCell* cell, Py_ssize_t step)
+{
+    for (; step > 0 && cell != NULL; --step)
+        cell = cell->next;
 
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
+    for (; step < 0 && cell != NULL; ++step)
+        cell = cell->prev;
+
+    return cell;
 }
 
-static PyObject* dllist_insert(DLListObject* self, PyObject* args)
+/* Convenience function for updating the unique index before count
+ * cells, starting at cell and separated by step, are assigned new
+ * values. Either all entries are updated, or none of them and
+ * an exception is set. */
+static int dllist_value_index_reassign(PyObject* list,
+                                       DLListCell* cell,
+                                       Py_ssize_t step,
+                                       Py_ssize_t count,
+                                       PyObject** values)
 {
-    PyObject* val = NULL;
-    PyObject* ref_node = NULL;
-    DLListNodeObject* new_node;
-
-    if (!PyArg_UnpackTuple(args, "insert", 1, 2, &val, &ref_node))
-        return NULL;
+    DLListObject* self = (DLListObject*)list;
+    PyObject* err_type;
+    PyObject* err_value;
+    PyObject* err_traceback;
+    DLListCell* iter_cell;
+    Py_ssize_t added;
+    Py_ssize_t i;
 
-    if (PyObject_TypeCheck(val, &DLListNodeType))
-        val = ((DLListNodeObject*)val)->value;
+    if (self->value_index == NULL)
+        return 0;
 
-    if (ref_node == NULL || ref_node == Py_None)
+    /* nodes are kept alive while their entries are replaced */
+    for (iter_cell = cell, i = 0; i < count; ++i)
     {
-        /* append item at the end of the list */
-        new_node = dllistnode_create(self->last, NULL, val, (PyObject*)self);
+        Py_INCREF(iter_cell->node);
+        dllist_value_index_discard(self, iter_cell);
+        iter_cell = dllist_step_cell(iter_cell, step);
+    }
 
-        self->last = (PyObject*)new_node;
+    for (iter_cell = cell, added = 0; added < count; ++added)
+    {
+        int found = PyDict_Contains(self->value_index, values[added]);
+        if (found == 1)
+            PyErr_SetString(PyExc_ValueError, "Value already in list");
+        if (found != 0 || PyDict_SetItem(self->value_index, values[added],
+                                         (PyObject*)iter_cell->node) == -1)
+            break;
 
-        if (self->first == Py_None)
-            self->first = (PyObject*)new_node;
+        iter_cell = dllist_step_cell(iter_cell, step);
     }
-    else
+
+    if (added < count)
     {
-        PyObject* list_ref;
+        /* restore entries of old values */
+        PyErr_Fetch(&err_type, &err_value, &err_traceback);
 
-        /* insert item before ref_node */
-        if (!PyObject_TypeCheck(ref_node, &DLListNodeType))
+        for (iter_cell = cell, i = 0; i < count; ++i)
         {
-            PyErr_SetString(PyExc_TypeError,
-                "ref_node argument must be a dllistnode");
-            return NULL;
-        }
+            PyObject* node = (PyObject*)iter_cell->node;
 
-        if (((DLListNodeObject*)ref_node)->list_weakref == Py_None)
-        {
-            PyErr_SetString(PyExc_ValueError,
-                "dllistnode does not belong to a list");
-            return NULL;
+            if (i < added &&
+                PyDict_GetItem(self->value_index, values[i]) == node &&
+                PyDict_DelItem(self->value_index, values[i]) == -1)
+                PyErr_Clear();
+
+            iter_cell = dllist_step_cell(iter_cell, step);
         }
 
-        list_ref = PyWeakref_GetObject(
-            ((DLListNodeObject*)ref_node)->list_weakref);
-        if (list_ref != (PyObject*)self)
+        for (iter_cell = cell, i = 0; i < count; ++i)
         {
-            PyErr_SetString(PyExc_ValueError,
-                "dllistnode belongs to another list");
-            return NULL;
-        }
+            if (PyDict_SetItem(self->value_index, iter_cell->value,
+                               (PyObject*)iter_cell->node) == -1)
+                PyErr_Clear();
 
-        new_node = dllistnode_create(
-            ((DLListNodeObject*)ref_node)->prev,
-            ref_node, val, (PyObject*)self);
+            iter_cell = dllist_step_cell(iter_cell, step);
+        }
 
-        if (ref_node == self->first)
-            self->first = (PyObject*)new_node;
+        PyErr_Restore(err_type, err_value, err_traceback);
+    }
 
-        if (self->last == Py_None)
-            self->last = (PyObject*)new_node;
+    for (iter_cell = cell, i = 0; i < count; ++i)
+    {
+        DLListCell* next_cell = dllist_step_cell(iter_cell, step);
 
-        /* invalidate last accessed item */
-        self->last_accessed_node = Py_None;
-        self->last_accessed_idx = -1;
+        Py_DECREF(iter_cell->node);
+        iter_cell = next_cell;
     }
 
-    ++self->size;
-
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
+    return (added < count) ? -1 : 0;
 }
 
-static PyObject* dllist_extendleft(DLListObject* self, PyObject* sequence)
+static PyObject* dllist_get_slice(DLListObject* self,
+                                  Py_ssize_t start,
+                                  Py_ssize_t step,
+                                  Py_ssize_t slicelength)
 {
+    DLListObject* new_list;
+    DLListCell* cell;
     Py_ssize_t i;
-    Py_ssize_t sequence_len;
-
-    if (PyObject_TypeCheck(sequence, &DLListType))
-    {
-        /* Special path for extending with a DLList.
-         * It's not strictly required but it will maintain
-         * the last accessed item. */
-        PyObject* iter_node_obj = ((DLListObject*)sequence)->first;
-        PyObject* last_node_obj = ((DLListObject*)sequence)->last;
-
-        while (iter_node_obj != Py_None)
-        {
-            DLListNodeObject* iter_node = (DLListNodeObject*)iter_node_obj;
-            PyObject* new_node;
-
-            new_node = (PyObject*)dllistnode_create(
-                NULL, self->first, iter_node->value, (PyObject*)self);
-
-            self->first = new_node;
-            if (self->last == Py_None)
-                self->last = new_node;
-
-            if (iter_node_obj == last_node_obj)
-            {
-                /* This is needed to terminate loop if self == sequence. */
-                break;
-            }
-
-            iter_node_obj = iter_node->next;
-        }
-
-        self->size += ((DLListObject*)sequence)->size;
 
-        /* update index of last accessed item */
-        if (self->last_accessed_idx >= 0)
-            self->last_accessed_idx += ((DLListObject*)sequence)->size;
-
-        Py_RETURN_NONE;
-    }
+    new_list = (DLListObject*)dllist_new(&DLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
 
-    sequence_len = PySequence_Length(sequence);
-    if (sequence_len == -1)
+    if (!dllist_set_indexed(new_list, self->index != NULL))
     {
-        PyErr_SetString(PyExc_ValueError, "Invalid sequence");
+        Py_DECREF(new_list);
         return NULL;
     }
 
-    for (i = 0; i < sequence_len; ++i)
+    if (slicelength == 0)
+        return (PyObject*)new_list;
+
+    /* locate the first cell once and walk the rest of the slice */
+    cell = dllist_get_cell_internal(self, start);
+    assert(cell != NULL);
+
+    for (i = 0; i < slicelength; ++i)
     {
-        PyObject* item;
-        PyObject* new_node;
+        DLListCell* new_cell;
 
-        item = PySequence_GetItem(sequence, i);
-        if (item == NULL)
+        new_cell = dllist_new_cell(new_list, cell->value);
+        if (new_cell == NULL)
         {
-            PyErr_SetString(PyExc_ValueError,
-                "Failed to get element from sequence");
+            Py_DECREF(new_list);
             return NULL;
         }
 
-        new_node = (PyObject*)dllistnode_create(
-            NULL, self->first, item, (PyObject*)self);
-
-        self->first = new_node;
-        if (self->last == Py_None)
-            self->last = new_node;
-
-        ++self->size;
-
-        /* update index of last accessed item */
-        if (self->last_accessed_idx >= 0)
-            ++self->last_accessed_idx;
+        dllist_link_cell(new_list, new_cell, NULL);
 
-        Py_DECREF(item);
+        if (i + 1 < slicelength)
+            cell = dllist_step_cell(cell, step);
     }
 
-    Py_RETURN_NONE;
+    return (PyObject*)new_list;
 }
 
-static PyObject* dllist_extendright(DLListObject* self, PyObject* arg)
+/* Convenience function for unlinking cells of a slice with positive
+ * step. Cells represented by nodes are detached right away, other ones
+ * are chained through their next pointers and returned, so that their
+ * values are released by dllist_free_cells() only after the list is
+ * consistent again. The cell following the last unlinked one (or
+ * the cell at start if the slice is empty) is stored in following. */
+static DLListCell* dllist_unlink_slice(DLListObject* self,
+                                       Py_ssize_t start,
+                                       Py_ssize_t step,
+                                       Py_ssize_t slicelength,
+                                       DLListCell** following)
 {
-    if (!dllist_extend_internal(self, arg))
-        return NULL;
+    DLListIndex* index = self->index;
+    DLListCell* removed = NULL;
+    DLListCell* cell;
+    Py_ssize_t i;
 
-    Py_RETURN_NONE;
-}
+    assert(step > 0);
 
-static PyObject* dllist_clear(DLListObject* self)
-{
-    PyObject* iter_node_obj = self->first;
+    cell = (start < self->size) ?
+        dllist_get_cell_internal(self, start) : NULL;
 
-    while (iter_node_obj != Py_None)
+    if (slicelength > 0)
     {
-        DLListNodeObject* iter_node = (DLListNodeObject*)iter_node_obj;
+        /* Positions of fingers are not tracked across bulk removal.
+         * Removing a large part of an indexed list is faster without
+         * maintaining the index and rebuilding it afterwards. */
+        self->num_fingers = 0;
 
-        iter_node_obj = iter_node->next;
-        dllistnode_delete(iter_node);
+        if (index != NULL && slicelength > self->size / 16)
+            self->index = NULL;
     }
 
-    /* invalidate last accessed item */
-    self->last_accessed_node = Py_None;
-    self->last_accessed_idx = -1;
-
-    self->first = Py_None;
-    self->last = Py_None;
-    self->size = 0;
-
-    Py_RETURN_NONE;
-}
-
-static PyObject* dllist_popleft(DLListObject* self)
-{
-    DLListNodeObject* del_node;
-    PyObject* value;
-
-    if (self->first == Py_None)
+    for (i = 0; i < slicelength; ++i)
     {
-        PyErr_SetString(PyExc_ValueError, "List is empty");
-        return NULL;
-    }
+        DLListCell* next = dllist_step_cell(cell, step);
 
-    del_node = (DLListNodeObject*)self->first;
+        dllist_unlink_cell(self, cell);
 
-    self->first = del_node->next;
-    if (self->last == (PyObject*)del_node)
-        self->last = Py_None;
+        if (cell->node != NULL)
+            dllistcell_delete(cell);
+        else
+        {
+            cell->next = removed;
+            removed = cell;
+        }
 
-    if (self->last_accessed_node != (PyObject*)del_node)
-    {
-        if (self->last_accessed_idx >= 0)
-            --self->last_accessed_idx;
+        cell = next;
     }
-    else
+
+    if (index != NULL && self->index == NULL)
     {
-        /* invalidate last accessed item */
-        self->last_accessed_node = Py_None;
-        self->last_accessed_idx = -1;
+        self->index = index;
+        dllistindex_rebuild(index, self->first);
     }
 
-    --self->size;
-
-    Py_INCREF(del_node->value);
-    value = del_node->value;
-
-    dllistnode_delete(del_node);
+    *following = cell;
 
-    return value;
+    return removed;
 }
 
-static PyObject* dllist_popright(DLListObject* self)
+/* Convenience function for replacing entries of count cells starting
+ * at position start with entries of new cells in the unique index.
+ * Entries of replaced cells are discarded first, so that the slice
+ * might be assigned values it already contains. */
+static int dllist_replace_index_values(DLListObject* self,
+                                       Py_ssize_t start,
+                                       Py_ssize_t count,
+                                       DLListCell* new_cells)
 {
-    DLListNodeObject* del_node;
-    PyObject* value;
-
-    if (self->last == Py_None)
+    PyObject* err_type;
+    PyObject* err_value;
+    PyObject* err_traceback;
+    DLListCell* first = NULL;
+    DLListCell* stop = NULL;
+    DLListCell* cell;
+
+    if (count > 0)
     {
-        PyErr_SetString(PyExc_ValueError, "List is empty");
-        return NULL;
+        first = dllist_get_cell_internal(self, start);
+        assert(first != NULL);
+        stop = dllist_step_cell(first, count);
     }
 
-    del_node = (DLListNodeObject*)self->last;
+    for (cell = first; cell != stop; cell = cell->next)
+        dllist_value_index_discard(self, cell);
 
-    self->last = del_node->prev;
-    if (self->first == (PyObject*)del_node)
-        self->first = Py_None;
-
-    if (self->last_accessed_node == (PyObject*)del_node)
-    {
-        /* invalidate last accessed item */
-        self->last_accessed_node = Py_None;
-        self->last_accessed_idx = -1;
-    }
+    if (dllist_value_index_add(self, new_cells, NULL))
+        return 1;
 
-    --self->size;
+    /* restore entries of replaced cells */
+    PyErr_Fetch(&err_type, &err_value, &err_traceback);
 
-    Py_INCREF(del_node->value);
-    value = del_node->value;
+    if (!dllist_value_index_add(self, first, stop))
+        PyErr_Clear();
 
-    dllistnode_delete(del_node);
+    PyErr_Restore(err_type, err_value, err_traceback);
 
-    return value;
+    return 0;
 }
 
-static PyObject* dllist_remove(DLListObject* self, PyObject* arg)
+/* Convenience function for replacing a slice with step 1 by elements
+ * of a sequence. */
+static int dllist_replace_slice(DLListObject* self,
+                                Py_ssize_t start,
+                                Py_ssize_t slicelength,
+                                PyObject* sequence)
 {
-    DLListNodeObject* del_node;
-    PyObject* list_ref;
-    PyObject* value;
-
-    if (!PyObject_TypeCheck(arg, &DLListNodeType))
-    {
-        PyErr_SetString(PyExc_TypeError, "Argument must be a dllistnode");
-        return NULL;
-    }
+    PyObject** items = PySequence_Fast_ITEMS(sequence);
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(sequence);
+    DLListCell* new_cells = NULL;
+    DLListCell* removed;
+    DLListCell* following;
+    Py_ssize_t i;
 
-    if (self->first == Py_None)
+    /* New cells are allocated up front (in reverse order), so that
+     * the list is left intact if allocation fails. */
+    for (i = n - 1; i >= 0; --i)
     {
-        PyErr_SetString(PyExc_ValueError, "List is empty");
-        return NULL;
-    }
+        DLListCell* new_cell = dllist_new_cell(
+            self, dllist_value_arg(items[i]));
 
-    del_node = (DLListNodeObject*)arg;
+        if (new_cell == NULL)
+        {
+            dllist_free_cells(new_cells);
+            return -1;
+        }
 
-    if (del_node->list_weakref == Py_None)
-    {
-        PyErr_SetString(PyExc_ValueError,
-            "dllistnode does not belong to a list");
-        return NULL;
+        new_cell->next = new_cells;
+        new_cells = new_cell;
     }
 
-    list_ref = PyWeakref_GetObject(del_node->list_weakref);
-    if (list_ref != (PyObject*)self)
+    if (self->value_index != NULL && !dllist_replace_index_values(
+            self, start, slicelength, new_cells))
     {
-        PyErr_SetString(PyExc_ValueError,
-            "dllistnode belongs to another list");
-        return NULL;
+        dllist_free_cells(new_cells);
+        return -1;
     }
 
-    if (self->first == arg)
-        self->first = del_node->next;
-    if (self->last == arg)
-        self->last = del_node->prev;
-    if (self->last_accessed_node == arg)
-        self->last_accessed_node = del_node->prev;
-
-    /* invalidate last accessed item */
-    self->last_accessed_node = Py_None;
-    self->last_accessed_idx = -1;
-
-    --self->size;
+    removed = dllist_unlink_slice(self, start, 1, slicelength, &following);
 
-    Py_INCREF(del_node->value);
-    value = del_node->value;
+    while (new_cells != NULL)
+    {
+        DLListCell* new_cell = new_cells;
 
-    /* unlink from parent list */
-    Py_DECREF(del_node->list_weakref);
-    Py_INCREF(Py_None);
-    del_node->list_weakref = Py_None;
+        new_cells = new_cells->next;
+        dllist_link_cell(self, new_cell, following);
+    }
 
-    dllistnode_delete(del_node);
+    dllist_free_cells(removed);
 
-    return value;
+    return 0;
 }
 
-static PyObject* dllist_rotate(DLListObject* self, PyObject* nObject)
+/* Convenience function for assigning elements of a sequence to
+ * a slice with step other than 1. Sizes must match. */
+static int dllist_assign_extended_slice(DLListObject* self,
+                                        Py_ssize_t start,
+                                        Py_ssize_t step,
+                                        Py_ssize_t slicelength,
+                                        PyObject* sequence)
 {
-    Py_ssize_t n;
-    Py_ssize_t split_idx;
-    Py_ssize_t n_mod;
-    DLListNodeObject* new_first;
-    DLListNodeObject* new_last;
-
-    if (self->size <= 1)
-        Py_RETURN_NONE;
+    PyObject** items = PySequence_Fast_ITEMS(sequence);
+    PyObject** old_values;
+    DLListCell* cell;
+    Py_ssize_t i;
 
-    if (!Py23Int_Check(nObject))
+    if (PySequence_Fast_GET_SIZE(sequence) != slicelength)
     {
-        PyErr_SetString(PyExc_TypeError, "n must be an integer");
-        return NULL;
+        PyErr_Format(PyExc_ValueError,
+            "attempt to assign sequence of size %zd "
+            "to extended slice of size %zd",
+            PySequence_Fast_GET_SIZE(sequence), slicelength);
+        return -1;
     }
 
-    n = Py23Int_AsSsize_t(nObject);
-    n_mod = py_ssize_t_abs(n) % self->size;
-
-    if (n_mod == 0)
-        Py_RETURN_NONE; /* no-op */
-
-    if (n > 0)
-        split_idx = self->size - n_mod; /* rotate right */
-    else
-        split_idx = n_mod;  /* rotate left */
-
-    new_last = dllist_get_node_internal(self, split_idx - 1);
-    assert(new_last != NULL);
-    new_first = (DLListNodeObject*)new_last->next;
-
-    ((DLListNodeObject*)self->first)->prev = self->last;
-    ((DLListNodeObject*)self->last)->next = self->first;
-
-    new_first->prev = Py_None;
-    new_last->next = Py_None;
-
-    self->first = (PyObject*)new_first;
-    self->last = (PyObject*)new_last;
+    if (slicelength == 0)
+        return 0;
 
-    if (self->last_accessed_idx >= 0)
+    old_values = (PyObject**)PyMem_Malloc(slicelength * sizeof(PyObject*));
+    if (old_values == NULL)
     {
-        self->last_accessed_idx =
-            (self->last_accessed_idx + self->size - split_idx) % self->size;
+        PyErr_NoMemory();
+        return -1;
     }
 
-    Py_RETURN_NONE;
-}
+    cell = dllist_get_cell_internal(self, start);
+    assert(cell != NULL);
 
-static PyObject* dllist_iter(PyObject* self)
-{
-    PyObject* args;
-    PyObject* result;
+    /* the array holds new values until the unique index is updated */
+    for (i = 0; i < slicelength; ++i)
+        old_values[i] = dllist_value_arg(items[i]);
 
-    args = PyTuple_New(1);
-    if (args == NULL)
+    if (dllist_value_index_reassign((PyObject*)self, cell, step,
+                                    slicelength, old_values) == -1)
     {
-        PyErr_SetString(PyExc_RuntimeError,
-            "Failed to create argument tuple");
-        return NULL;
+        PyMem_Free(old_values);
+        return -1;
     }
 
-    Py_INCREF(self);
-    if (PyTuple_SetItem(args, 0, self) != 0)
+    for (i = 0; i < slicelength; ++i)
     {
-        PyErr_SetString(PyExc_RuntimeError,
-            "Failed to initialize argument tuple");
-        return NULL;
+        PyObject* value = old_values[i];
+
+        Py_INCREF(value);
+        old_values[i] = cell->value;
+        cell->value = value;
+
+        if (i + 1 < slicelength)
+            cell = dllist_step_cell(cell, step);
     }
 
-    result = PyObject_CallObject((PyObject*)&DLListIteratorType, args);
+    /* release old values once the list is consistent */
+    for (i = 0; i < slicelength; ++i)
+        Py_DECREF(old_values[i]);
 
-    Py_DECREF(args);
+    PyMem_Free(old_values);
 
-    return result;
+    return 0;
 }
 
-static Py_ssize_t dllist_len(PyObject* self)
+static PyObject* dllist_subscript(PyObject* self, PyObject* item)
 {
     DLListObject* list = (DLListObject*)self;
-    return list->size;
-}
+    Py_ssize_t start;
+    Py_ssize_t stop;
+    Py_ssize_t step;
+    Py_ssize_t slicelength;
 
-static PyObject* dllist_concat(PyObject* self, PyObject* other)
-{
-    DLListObject* new_list;
+    if (PyIndex_Check(item))
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred())
+            return NULL;
+
+        if (index < 0)
+            index += list->size;
 
-    new_list = (DLListObject*)PyObject_CallObject(
-        (PyObject*)&DLListType, NULL);
+        return dllist_get_item(self, index);
+    }
 
-    if (!dllist_extend_internal(new_list, self) ||
-        !dllist_extend_internal(new_list, other))
+    if (!PySlice_Check(item))
     {
-        Py_DECREF(new_list);
+        PyErr_SetString(PyExc_TypeError,
+            "Indices must be integers or slices");
         return NULL;
     }
 
-    return (PyObject*)new_list;
-}
-
-static PyObject* dllist_inplace_concat(PyObject* self, PyObject* other)
-{
-    if (!dllist_extend_internal((DLListObject*)self, other))
+    if (Py23Slice_GetIndicesEx(item, list->size,
+                               &start, &stop, &step, &slicelength) != 0)
         return NULL;
 
-    Py_INCREF(self);
-    return self;
+    return dllist_get_slice(list, start, step, slicelength);
 }
 
-static PyObject* dllist_repeat(PyObject* self, Py_ssize_t count)
+static int dllist_ass_subscript(PyObject* self,
+                                PyObject* item,
+                                PyObject* value)
 {
-    DLListObject* new_list;
-    Py_ssize_t i;
-
-    new_list = (DLListObject*)PyObject_CallObject(
-        (PyObject*)&DLListType, NULL);
-
-    for (i = 0; i < count; ++i)
+    DLListObject* list = (DLListObject*)self;
+    Py_ssize_t start;
+    Py_ssize_t stop;
+    Py_ssize_t step;
+    Py_ssize_t slicelength;
+    PyObject* sequence;
+    int result;
+
+    if (PyIndex_Check(item))
     {
-        if (!dllist_extend_internal(new_list, self))
-        {
-            Py_DECREF(new_list);
-            return NULL;
-        }
-    }
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred())
+            return -1;
 
-    return (PyObject*)new_list;
-}
+        if (index < 0)
+            index += list->size;
 
-static PyObject* dllist_get_item(PyObject* self, Py_ssize_t index)
-{
-    DLListNodeObject* node;
+        return dllist_set_item(self, index, value);
+    }
 
-    node = dllist_get_node_internal((DLListObject*)self, index);
-    if (node != NULL)
+    if (!PySlice_Check(item))
     {
-        PyObject* value = node->value;
-
-        Py_XINCREF(value);
-
-        /* update last accessed node */
-        ((DLListObject*)self)->last_accessed_node = (PyObject*)node;
-        ((DLListObject*)self)->last_accessed_idx = index;
-
-        return value;
+        PyErr_SetString(PyExc_TypeError,
+            "Indices must be integers or slices");
+        return -1;
     }
 
-    return NULL;
-}
-
-static int dllist_set_item(PyObject* self, Py_ssize_t index, PyObject* val)
-{
-    DLListObject* list = (DLListObject*)self;
-    DLListNodeObject* node;
-    PyObject* oldval;
-
-    node = dllist_get_node_internal(list, index);
-    if (node == NULL)
+    if (Py23Slice_GetIndicesEx(item, list->size,
+                               &start, &stop, &step, &slicelength) != 0)
         return -1;
 
-    /* Here is a tricky (and undocumented) part of sequence protocol.
-     * Python will pass NULL as item value when item is deleted with:
-     * del list[index] */
-    if (val == NULL)
+    if (value == NULL)
     {
-        PyObject* prev = node->prev;
-        PyObject* result;
+        DLListCell* following;
 
-        result = dllist_remove(list, (PyObject*)node);
+        if (slicelength == 0)
+            return 0;
 
-        if (prev != Py_None && index > 0)
+        /* slices with negative step are deleted in forward direction */
+        if (step < 0)
         {
-            /* Last accessed item was invalidated by dllist_remove.
-             * We restore it here as the preceding node. */
-            list->last_accessed_node = prev;
-            list->last_accessed_idx = index - 1;
+            start += (slicelength - 1) * step;
+            step = -step;
         }
 
-        Py_XDECREF(result);
-
-        return (result != NULL) ? 0 : -1;
+        dllist_free_cells(dllist_unlink_slice(
+            list, start, step, slicelength, &following));
+        return 0;
     }
 
-    /* The rest of this function handles normal assignment:
-     * list[index] = item */
-    if (PyObject_TypeCheck(val, &DLListNodeType))
-        val = ((DLListNodeObject*)val)->value;
-
-    oldval = node->value;
+    /* copying the sequence also handles assignment of list to itself */
+    sequence = PySequence_Fast(value, "can only assign an iterable");
+    if (sequence == NULL)
+        return -1;
 
-    Py_INCREF(val);
-    node->value = val;
-    Py_DECREF(oldval);
+    if (step == 1)
+        result = dllist_replace_slice(list, start, slicelength, sequence);
+    else
+        result = dllist_assign_extended_slice(
+            list, start, step, slicelength, sequence);
 
-    /* update last accessed node */
-    list->last_accessed_node = (PyObject*)node;
-    list->last_accessed_idx = index;
+    Py_DECREF(sequence);
 
-    return 0;
+    return result;
 }
 
 static PyMethodDef DLListMethods[] =
@@ -1268,14 +3688,38 @@ static PyMethodDef DLListMethods[] =
       "Append element at the end of the list" },
     { "clear", (PyCFunction)dllist_clear, METH_NOARGS,
       "Remove all elements from the list" },
+    { "count", (PyCFunction)dllist_count, METH_O,
+      "Return number of occurrences of value" },
+    { "cursor", (PyCFunction)dllist_cursor, Py23_METH_FASTCALL,
+      "Return a cursor positioned at node or at the first node" },
     { "extend", (PyCFunction)dllist_extendright, METH_O,
       "Append elements from iterable at the right side of the list" },
     { "extendleft", (PyCFunction)dllist_extendleft, METH_O,
       "Append elements from iterable at the left side of the list" },
     { "extendright", (PyCFunction)dllist_extendright, METH_O,
       "Append elements from iterable at the right side of the list" },
-    { "insert", (PyCFunction)dllist_insert, METH_VARARGS,
+    { "find", (PyCFunction)dllist_find, METH_O,
+      "Return first node with value" },
+    { "index", (PyCFunction)dllist_index, METH_VARARGS,
+      "Return position of the first occurrence of value" },
+    { "insert", (PyCFunction)dllist_insert, Py23_METH_FASTCALL,
       "Inserts element before node" },
+    { "move_after", (PyCFunction)dllist_move_after, Py23_METH_FASTCALL,
+      "Move node after another node of the list" },
+    { "move_before", (PyCFunction)dllist_move_before, Py23_METH_FASTCALL,
+      "Move node before another node of the list" },
+    { "move_to_back", (PyCFunction)dllist_move_to_back, METH_O,
+      "Move node to the end of the list" },
+    { "move_to_front", (PyCFunction)dllist_move_to_front, METH_O,
+      "Move node to the beginning of the list" },
+    { "iternodes", (PyCFunction)dllist_iternodes, METH_NOARGS,
+      "Return an iterator over nodes of the list" },
+    { "max", (PyCFunction)dllist_max, METH_NOARGS,
+      "Return the largest element of the list" },
+    { "mean", (PyCFunction)dllist_mean, METH_NOARGS,
+      "Return the arithmetic mean of elements of the list" },
+    { "min", (PyCFunction)dllist_min, METH_NOARGS,
+      "Return the smallest element of the list" },
     { "nodeat", (PyCFunction)dllist_node_at, METH_O,
       "Return node at index" },
     { "popleft", (PyCFunction)dllist_popleft, METH_NOARGS,
@@ -1286,19 +3730,50 @@ static PyMethodDef DLListMethods[] =
       "Remove last element from the list and return it" },
     { "remove", (PyCFunction)dllist_remove, METH_O,
       "Remove element from the list" },
+    { "remove_if", (PyCFunction)dllist_remove_if, METH_O,
+      "Remove all elements, for which predicate returns true" },
+    { "remove_nodes", (PyCFunction)dllist_remove_nodes, METH_O,
+      "Remove all nodes from iterable" },
+    { "remove_value", (PyCFunction)dllist_remove_value, METH_O,
+      "Remove the first element equal to value and return it" },
+    { "reverse", (PyCFunction)dllist_reverse, METH_NOARGS,
+      "Reverse the order of elements in place" },
     { "rotate", (PyCFunction)dllist_rotate, METH_O,
       "Rotate the list n steps to the right" },
+    { "sort", (PyCFunction)dllist_sort, METH_VARARGS | METH_KEYWORDS,
+      "Sort the list in place" },
+    { "splice", (PyCFunction)dllist_splice, Py23_METH_FASTCALL,
+      "Move nodes from another list before node" },
+    { "split", (PyCFunction)dllist_split, METH_O,
+      "Move node and all following nodes to a new list" },
+    { "sum", (PyCFunction)dllist_sum, METH_NOARGS,
+      "Return the sum of elements of the list" },
+    { "__reversed__", (PyCFunction)dllist_reversed, METH_NOARGS,
+      "Return a reverse iterator over the list" },
     { NULL },   /* sentinel */
 };
 
 static PyMemberDef DLListMembers[] =
 {
-    { "first", T_OBJECT_EX, offsetof(DLListObject, first), READONLY,
-      "First node" },
-    { "last", T_OBJECT_EX, offsetof(DLListObject, last), READONLY,
-      "Next node" },
     { "size", T_INT, offsetof(DLListObject, size), READONLY,
       "Number of elements in the list" },
+    { "fingerhits", T_PYSSIZET, offsetof(DLListObject, finger_hits),
+      READONLY, "Number of indexed lookups started from a finger" },
+    { "fingermisses", T_PYSSIZET, offsetof(DLListObject, finger_misses),
+      READONLY, "Number of indexed lookups not started from a finger" },
+    { NULL },   /* sentinel */
+};
+
+static PyGetSetDef DLListGetSetters[] =
+{
+    { "first", (getter)dllist_get_first, NULL,
+      "First node", NULL },
+    { "last", (getter)dllist_get_last, NULL,
+      "Next node", NULL },
+    { "indexed", (getter)dllist_get_indexed, NULL,
+      "True if list maintains an index for positional access", NULL },
+    { "unique_index", (getter)dllist_get_unique_index, NULL,
+      "True if list maintains an index of unique values", NULL },
     { NULL },   /* sentinel */
 };
 
@@ -1311,11 +3786,18 @@ static PySequenceMethods DLListSequenceMethods[] =
     0,                          /* sq_slice */
     dllist_set_item,            /* sq_ass_item */
     0,                          /* sq_ass_slice */
-    0,                          /* sq_contains */
+    dllist_contains,            /* sq_contains */
     dllist_inplace_concat,      /* sq_inplace_concat */
     0,                          /* sq_inplace_repeat */
 };
 
+static PyMappingMethods DLListMappingMethods =
+{
+    dllist_len,                 /* mp_length */
+    dllist_subscript,           /* mp_subscript */
+    dllist_ass_subscript,       /* mp_ass_subscript */
+};
+
 static PyTypeObject DLListType =
 {
     PyVarObject_HEAD_INIT(NULL, 0)
@@ -1330,7 +3812,7 @@ static PyTypeObject DLListType =
     (reprfunc)dllist_repr,      /* tp_repr */
     0,                          /* tp_as_number */
     DLListSequenceMethods,      /* tp_as_sequence */
-    0,                          /* tp_as_mapping */
+    &DLListMappingMethods,      /* tp_as_mapping */
     (hashfunc)dllist_hash,      /* tp_hash */
     0,                          /* tp_call */
     (reprfunc)dllist_str,       /* tp_str */
@@ -1349,7 +3831,7 @@ static PyTypeObject DLListType =
     0,                          /* tp_iternext */
     DLListMethods,              /* tp_methods */
     DLListMembers,              /* tp_members */
-    0,                          /* tp_getset */
+    DLListGetSetters,           /* tp_getset */
     0,                          /* tp_base */
     0,                          /* tp_dict */
     0,                          /* tp_descr_get */
@@ -1367,22 +3849,71 @@ typedef struct
 {
     PyObject_HEAD
     DLListObject* list;
-    PyObject* current_node;
+    DLListNodeObject* current_node; /* next node to visit (nodes only) */
+    DLListNodeObject* last_node;    /* node returned last (nodes only) */
+    DLListCell* current_cell;       /* next cell to visit (values only) */
+    Py_ssize_t state;   /* state of the list when iteration started
+                         * (or when the last node was returned) */
+    int reverse;    /* nonzero if iterating from last to first element */
+    int nodes;      /* nonzero if nodes are returned instead of values */
 } DLListIteratorObject;
 
 static void dllistiterator_dealloc(DLListIteratorObject* self)
 {
     Py_XDECREF(self->current_node);
+    Py_XDECREF(self->last_node);
     Py_DECREF(self->list);
 
     PyObject_Del((PyObject*)self);
 }
 
+static PyObject* dllistiterator_create(PyTypeObject* type,
+                                       PyObject* owner_list,
+                                       int reverse,
+                                       int nodes)
+{
+    DLListIteratorObject* self;
+    DLListCell* start_cell;
+
+    self = (DLListIteratorObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->list = (DLListObject*)owner_list;
+    self->current_node = NULL;
+    self->last_node = NULL;
+    self->state = self->list->state;
+    self->reverse = reverse;
+    self->nodes = nodes;
+
+    Py_INCREF(self->list);
+
+    start_cell = reverse ? self->list->last : self->list->first;
+
+    /* Value iterators borrow the cell of the next element to visit,
+     * which stays valid for as long as the list is not modified. */
+    self->current_cell = nodes ? NULL : start_cell;
+
+    /* Node iterators hold a node of the next element to visit,
+     * which keeps the element alive if it is removed from the list. */
+    if (nodes && start_cell != NULL)
+    {
+        self->current_node = (DLListNodeObject*)dllistnode_from_cell(
+            owner_list, start_cell);
+        if (self->current_node == NULL)
+        {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)self;
+}
+
 static PyObject* dllistiterator_new(PyTypeObject* type,
                                     PyObject* args,
                                     PyObject* kwds)
 {
-    DLListIteratorObject* self;
     PyObject* owner_list = NULL;
 
     if (!PyArg_UnpackTuple(args, "__new__", 1, 1, &owner_list))
@@ -1394,42 +3925,96 @@ static PyObject* dllistiterator_new(PyTypeObject* type,
         return NULL;
     }
 
-    self = (DLListIteratorObject*)type->tp_alloc(type, 0);
-    if (self == NULL)
-        return NULL;
+    return dllistiterator_create(type, owner_list, 0, 0);
+}
 
-    self->list = (DLListObject*)owner_list;
-    self->current_node = self->list->first;
+/* Verifies that the list was not modified since the last node was
+ * returned by a node iterator, other than by removing that node.
+ * Otherwise the next node to visit might have been relinked. */
+static int dllistiterator_check_nodes(DLListIteratorObject* self)
+{
+    PyObject* list = (PyObject*)self->list;
 
-    Py_INCREF(self->list);
-    Py_INCREF(self->current_node);
+    if (self->current_node->list == list &&
+        (self->state == self->list->state ||
+         (self->state + 1 == self->list->state &&
+          self->last_node != NULL && self->last_node->list != list)))
+        return 1;
 
-    return (PyObject*)self;
+    Py_CLEAR(self->current_node);
+    PyErr_SetString(PyExc_RuntimeError,
+        "dllist modified during iteration");
+
+    return 0;
 }
 
 static PyObject* dllistiterator_iternext(PyObject* self)
 {
     DLListIteratorObject* iter_self = (DLListIteratorObject*)self;
-    PyObject* value;
-    PyObject* next_node;
+    DLListNodeObject* node;
+    DLListNodeObject* last_node;
+    DLListCell* cell;
+    DLListCell* next_cell;
+
+    if (!iter_self->nodes)
+    {
+        cell = iter_self->current_cell;
+        if (cell == NULL)
+        {
+            PyErr_SetNone(PyExc_StopIteration);
+            return NULL;
+        }
+
+        if (iter_self->state != iter_self->list->state)
+        {
+            /* the borrowed cell may have been released */
+            iter_self->current_cell = NULL;
+            PyErr_SetString(PyExc_RuntimeError,
+                "dllist modified during iteration");
+            return NULL;
+        }
+
+        iter_self->current_cell = iter_self->reverse ? cell->prev : cell->next;
+
+        Py_INCREF(cell->value);
+        return cell->value;
+    }
 
-    if (iter_self->current_node == NULL || iter_self->current_node == Py_None)
+    node = iter_self->current_node;
+    if (node == NULL)
     {
-        Py_XDECREF(iter_self->current_node);
-        iter_self->current_node = NULL;
         PyErr_SetNone(PyExc_StopIteration);
         return NULL;
     }
 
-    value = ((DLListNodeObject*)iter_self->current_node)->value;
-    Py_INCREF(value);
+    if (!dllistiterator_check_nodes(iter_self))
+        return NULL;
 
-    next_node = ((DLListNodeObject*)iter_self->current_node)->next;
-    Py_INCREF(next_node);
-    Py_DECREF(iter_self->current_node);
-    iter_self->current_node = next_node;
+    next_cell = iter_self->reverse ? node->cell->prev : node->cell->next;
 
-    return value;
+    /* reference to the current node is passed over to the caller */
+    iter_self->current_node = NULL;
+
+    if (next_cell != NULL)
+    {
+        iter_self->current_node =
+            (DLListNodeObject*)dllistnode_from_cell(node->list, next_cell);
+        if (iter_self->current_node == NULL)
+        {
+            Py_DECREF(node);
+            return NULL;
+        }
+    }
+
+    /* the returned node is kept, so that its removal can be told
+     * apart from other modifications */
+    last_node = iter_self->last_node;
+    Py_INCREF(node);
+    iter_self->last_node = node;
+    iter_self->state = iter_self->list->state;
+    Py_XDECREF(last_node);
+
+    return (PyObject*)node;
 }
 
 static PyTypeObject DLListIteratorType =
@@ -1459,7 +4044,7 @@ static PyTypeObject DLListIteratorType =
     0,                                  /* tp_clear */
     0,                                  /* tp_richcompare */
     0,                                  /* tp_weaklistoffset */
-    0,                                  /* tp_iter */
+    PyObject_SelfIter,                  /* tp_iter */
     dllistiterator_iternext,            /* tp_iternext */
     0,                                  /* tp_methods */
     0,                                  /* tp_members */
@@ -1475,12 +4060,351 @@ static PyTypeObject DLListIteratorType =
 };
 
 
+/* DLListCursor */
+
+/* A cursor points at a node of the list, or at no element, which is
+ * a position between the last and the first node. Moving the cursor
+ * past either end of the list brings it to this position and moving
+ * it again wraps around to the other end. */
+typedef struct
+{
+    PyObject_HEAD
+    DLListObject* list;
+    DLListNodeObject* node;     /* node under cursor or NULL */
+} DLListCursorObject;
+
+static void dllistcursor_dealloc(DLListCursorObject* self)
+{
+    Py_XDECREF(self->node);
+    Py_DECREF(self->list);
+
+    PyObject_Del((PyObject*)self);
+}
+
+static PyObject* dllistcursor_create(PyObject* owner_list, DLListCell* cell)
+{
+    DLListCursorObject* self;
+
+    self = PyObject_New(DLListCursorObject, &DLListCursorType);
+    if (self == NULL)
+        return NULL;
+
+    self->list = (DLListObject*)owner_list;
+    self->node = NULL;
+
+    Py_INCREF(self->list);
+
+    if (cell != NULL)
+    {
+        self->node = (DLListNodeObject*)dllistnode_from_cell(owner_list, cell);
+        if (self->node == NULL)
+        {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)self;
+}
+
+static PyObject* dllistcursor_new(PyTypeObject* type,
+                                  PyObject* args,
+                                  PyObject* kwds)
+{
+    PyObject* owner_list = NULL;
+
+    if (!PyArg_UnpackTuple(args, "__new__", 1, 1, &owner_list))
+        return NULL;
+
+    if (!PyObject_TypeCheck(owner_list, &DLListType))
+    {
+        PyErr_SetString(PyExc_TypeError, "dllist argument expected");
+        return NULL;
+    }
+
+    return dllistcursor_create(owner_list,
+                               ((DLListObject*)owner_list)->first);
+}
+
+/* Convenience function for verifying that the node under cursor
+ * was not removed from the list by other means than the cursor. */
+static int dllistcursor_check(DLListCursorObject* self)
+{
+    if (self->node != NULL && self->node->list != (PyObject*)self->list)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "Node under cursor was removed from the list");
+        return 0;
+    }
+
+    if (self->node != NULL && !dllist_check_node_list(self->node->list))
+        return 0;
+
+    return 1;
+}
+
+/* Convenience function for finding the cell, which follows (or
+ * precedes if backward is nonzero) the cursor position. */
+static DLListCell* dllistcursor_neighbour(DLListCursorObject* self,
+                                          int backward)
+{
+    if (self->node == NULL)
+        return backward ? self->list->last : self->list->first;
+
+    return backward ? self->node->cell->prev : self->node->cell->next;
+}
+
+/* Convenience function for moving the cursor to cell (or to no element
+ * if cell is NULL). Returns the new node under cursor. */
+static PyObject* dllistcursor_move_to(DLListCursorObject* self,
+                                      DLListCell* cell)
+{
+    DLListNodeObject* node = NULL;
+
+    if (cell != NULL)
+    {
+        node = (DLListNodeObject*)dllistnode_from_cell(
+            (PyObject*)self->list, cell);
+        if (node == NULL)
+            return NULL;
+    }
+
+    Py_XDECREF(self->node);
+    self->node = node;
+
+    return dllistnode_from_cell((PyObject*)self->list, cell);
+}
+
+static PyObject* dllistcursor_next(DLListCursorObject* self)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    return dllistcursor_move_to(self, dllistcursor_neighbour(self, 0));
+}
+
+static PyObject* dllistcursor_prev(DLListCursorObject* self)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    return dllistcursor_move_to(self, dllistcursor_neighbour(self, 1));
+}
+
+static PyObject* dllistcursor_peek(DLListCursorObject* self)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    return dllistnode_from_cell(
+        (PyObject*)self->list, dllistcursor_neighbour(self, 0));
+}
+
+static PyObject* dllistcursor_insert_before(DLListCursorObject* self,
+                                            PyObject* arg)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    return dllist_insert_value(self->list, dllist_value_arg(arg),
+        (self->node != NULL) ? self->node->cell : NULL);
+}
+
+static PyObject* dllistcursor_insert_after(DLListCursorObject* self,
+                                           PyObject* arg)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    return dllist_insert_value(self->list, dllist_value_arg(arg),
+        dllistcursor_neighbour(self, 0));
+}
+
+static PyObject* dllistcursor_remove(DLListCursorObject* self)
+{
+    DLListNodeObject* node = self->node;
+    DLListNodeObject* next_node = NULL;
+    DLListCell* next_cell;
+    PyObject* value;
+
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    if (node == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cursor does not point to a node");
+        return NULL;
+    }
+
+    /* the cursor advances to the following node */
+    next_cell = node->cell->next;
+    if (next_cell != NULL)
+    {
+        next_node = (DLListNodeObject*)dllistnode_from_cell(
+            (PyObject*)self->list, next_cell);
+        if (next_node == NULL)
+            return NULL;
+    }
+
+    value = dllist_remove_cell(self->list, node->cell);
+
+    self->node = next_node;
+    Py_DECREF(node);
+
+    return value;
+}
+
+static PyObject* dllistcursor_get_node(DLListCursorObject* self,
+                                       void* closure)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    if (self->node == NULL)
+        Py_RETURN_NONE;
+
+    Py_INCREF(self->node);
+    return (PyObject*)self->node;
+}
+
+static PyObject* dllistcursor_get_value(DLListCursorObject* self,
+                                        void* closure)
+{
+    if (!dllistcursor_check(self))
+        return NULL;
+
+    if (self->node == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cursor does not point to a node");
+        return NULL;
+    }
+
+    Py_INCREF(self->node->cell->value);
+    return self->node->cell->value;
+}
+
+static PyMethodDef DLListCursorMethods[] =
+{
+    { "insert_after", (PyCFunction)dllistcursor_insert_after, METH_O,
+      "Insert element after the cursor" },
+    { "insert_before", (PyCFunction)dllistcursor_insert_before, METH_O,
+      "Insert element before the cursor" },
+    { "next", (PyCFunction)dllistcursor_next, METH_NOARGS,
+      "Move cursor to the next node and return it" },
+    { "peek", (PyCFunction)dllistcursor_peek, METH_NOARGS,
+      "Return the next node without moving the cursor" },
+    { "prev", (PyCFunction)dllistcursor_prev, METH_NOARGS,
+      "Move cursor to the previous node and return it" },
+    { "remove", (PyCFunction)dllistcursor_remove, METH_NOARGS,
+      "Remove element under cursor and move to the next node" },
+    { NULL },   /* sentinel */
+};
+
+static PyGetSetDef DLListCursorGetSetters[] =
+{
+    { "node", (getter)dllistcursor_get_node, NULL,
+      "Node under cursor", NULL },
+    { "value", (getter)dllistcursor_get_value, NULL,
+      "Value of node under cursor", NULL },
+    { NULL },   /* sentinel */
+};
+
+static PyTypeObject DLListCursorType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "llist.dllistcursor",               /* tp_name */
+    sizeof(DLListCursorObject),         /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)dllistcursor_dealloc,   /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_compare */
+    0,                                  /* tp_repr */
+    0,                                  /* tp_as_number */
+    0,                                  /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "Doubly linked list cursor",        /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    0,                                  /* tp_iter */
+    0,                                  /* tp_iternext */
+    DLListCursorMethods,                /* tp_methods */
+    0,                                  /* tp_members */
+    DLListCursorGetSetters,             /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    dllistcursor_new,                   /* tp_new */
+};
+
+
+/* Releases cells and nodes above given number from the free lists. */
+static void dllist_shrink_freelist(Py_ssize_t max_free)
+{
+    while (dllistcell_num_free > max_free)
+    {
+        DLListCell* cell = dllistcell_free_list;
+
+        dllistcell_free_list = cell->next;
+        --dllistcell_num_free;
+        PyMem_Free(cell);
+    }
+
+    while (dllistnode_num_free > max_free)
+    {
+        DLListNodeObject* node = dllistnode_free_list;
+
+        dllistnode_free_list = (DLListNodeObject*)node->cell;
+        --dllistnode_num_free;
+        PyObject_Del((PyObject*)node);
+    }
+}
+
+Py_ssize_t dllist_trim_freelist(void)
+{
+    Py_ssize_t count = dllistcell_num_free + dllistnode_num_free;
+
+    dllist_shrink_freelist(0);
+
+    return count;
+}
+
+void dllist_set_freelist_limit(Py_ssize_t limit)
+{
+    dllist_max_free = limit;
+
+    /* release cells and nodes above the new high-water mark */
+    dllist_shrink_freelist(dllist_max_free);
+}
+
 int dllist_init_type(void)
 {
+#ifdef Py23_HAVE_VECTORCALL
+    DLListType.tp_vectorcall = dllist_vectorcall;
+    DLListNodeType.tp_vectorcall = dllistnode_vectorcall;
+#endif
+
     return
         ((PyType_Ready(&DLListType) == 0) &&
          (PyType_Ready(&DLListNodeType) == 0) &&
-         (PyType_Ready(&DLListIteratorType) == 0))
+         (PyType_Ready(&DLListIteratorType) == 0) &&
+         (PyType_Ready(&DLListCursorType) == 0))
         ? 1 : 0;
 }
 
@@ -1489,8 +4413,10 @@ void dllist_register(PyObject* module)
     Py_INCREF(&DLListType);
     Py_INCREF(&DLListNodeType);
     Py_INCREF(&DLListIteratorType);
+    Py_INCREF(&DLListCursorType);
 
     PyModule_AddObject(module, "dllist", (PyObject*)&DLListType);
     PyModule_AddObject(module, "dllistnode", (PyObject*)&DLListNodeType);
     PyModule_AddObject(module, "dllistiterator", (PyObject*)&DLListIteratorType);
+    PyModule_AddObject(module, "dllistcursor", (PyObject*)&DLListCursorType);
 }
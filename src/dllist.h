@@ -5,7 +5,10 @@
 #ifndef DLLIST_H
 #define DLLIST_H
 
-int  dllist_init_type(void);
-void dllist_register(PyObject* module);
+int        dllist_init_type(void);
+void       dllist_register(PyObject* module);
+
+Py_ssize_t dllist_trim_freelist(void);
+void       dllist_set_freelist_limit(Py_ssize_t limit);
 
 #endif /* DLLIST_H */
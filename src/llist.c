@@ -4,11 +4,64 @@
 
 #include <Python.h>
 
+#include "py23macros.h"
 #include "sllist.h"
 #include "dllist.h"
+#include "ullist.h"
+#include "lrucache.h"
+
+/* Default number of released nodes cached by each node type */
+#define DEFAULT_FREELIST_LIMIT  1024
+
+static Py_ssize_t freelist_limit = DEFAULT_FREELIST_LIMIT;
+
+static PyObject* llist_getfreelistlimit(PyObject* self)
+{
+    return Py23Int_FromSsize_t(freelist_limit);
+}
+
+static PyObject* llist_setfreelistlimit(PyObject* self, PyObject* limitObject)
+{
+    Py_ssize_t limit;
+
+    if (!Py23Int_Check(limitObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "Limit must be an integer");
+        return NULL;
+    }
+
+    limit = Py23Int_AsSsize_t(limitObject);
+    if (limit == -1 && PyErr_Occurred())
+        return NULL;
+
+    if (limit < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "Limit must not be negative");
+        return NULL;
+    }
+
+    freelist_limit = limit;
+    sllist_set_freelist_limit(limit);
+    dllist_set_freelist_limit(limit);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* llist_trimfreelists(PyObject* self)
+{
+    Py_ssize_t count = sllist_trim_freelist() + dllist_trim_freelist();
+
+    return Py23Int_FromSsize_t(count);
+}
 
 static PyMethodDef llist_methods[] =
 {
+    { "getfreelistlimit", (PyCFunction)llist_getfreelistlimit, METH_NOARGS,
+      "Return maximum number of released nodes cached per node type" },
+    { "setfreelistlimit", (PyCFunction)llist_setfreelistlimit, METH_O,
+      "Set maximum number of released nodes cached per node type" },
+    { "trimfreelists", (PyCFunction)llist_trimfreelists, METH_NOARGS,
+      "Free all cached nodes and return their number" },
     { NULL }    /* sentinel */
 };
 
@@ -39,11 +92,20 @@ PyInit_llist(void)
         return NULL;
     if (!dllist_init_type())
         return NULL;
+    if (!ullist_init_type())
+        return NULL;
+    if (!lrucache_init_type())
+        return NULL;
+
+    sllist_set_freelist_limit(freelist_limit);
+    dllist_set_freelist_limit(freelist_limit);
 
     m = PyModule_Create(&llist_moduledef);
 
     sllist_register(m);
     dllist_register(m);
+    ullist_register(m);
+    lrucache_register(m);
 
     return m;
 }
@@ -59,12 +121,21 @@ initllist(void)
         return;
     if (!dllist_init_type())
         return;
+    if (!ullist_init_type())
+        return;
+    if (!lrucache_init_type())
+        return;
+
+    sllist_set_freelist_limit(freelist_limit);
+    dllist_set_freelist_limit(freelist_limit);
 
     m = Py_InitModule3("llist", llist_methods,
                        "Singly and doubly linked lists.");
 
     sllist_register(m);
     dllist_register(m);
+    ullist_register(m);
+    lrucache_register(m);
 }
 
 #endif /* PY_MAJOR_VERSION >= 3 */
@@ -0,0 +1,311 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#include <Python.h>
+
+#include "llistreduce.h"
+
+/* Returns 1 and stores the value in result if value is an exact int
+ * which fits in a C long long, 0 otherwise. */
+Py_LOCAL_INLINE(int) llistreduce_as_int64(PyObject* value,
+                                          PY_LONG_LONG* result)
+{
+    int overflow;
+
+#if PY_MAJOR_VERSION < 3
+    if (PyInt_CheckExact(value))
+    {
+        *result = PyInt_AS_LONG(value);
+        return 1;
+    }
+#endif
+
+    if (!PyLong_CheckExact(value))
+        return 0;
+
+#if PY_VERSION_HEX >= 0x030C0000
+    /* small ints are read directly from the object */
+    if (PyUnstable_Long_IsCompact((PyLongObject*)value))
+    {
+        *result = PyUnstable_Long_CompactValue((PyLongObject*)value);
+        return 1;
+    }
+#endif
+
+    *result = PyLong_AsLongLongAndOverflow(value, &overflow);
+
+    return !overflow;
+}
+
+/* Converts C accumulator of the sum to an object, so that following
+ * values can be added with PyNumber_Add(). */
+static int llistreduce_sum_to_object(LListSum* sum)
+{
+    if (sum->kind == LLIST_SUM_INT)
+        sum->sum = llist_int64_to_object(sum->int_sum);
+    else
+        sum->sum = PyFloat_FromDouble(sum->float_sum);
+
+    if (sum->sum == NULL)
+        return 0;
+
+    sum->kind = LLIST_SUM_OBJECT;
+
+    return 1;
+}
+
+/* Adds value to the object accumulator. */
+static int llistreduce_sum_add_object(LListSum* sum, PyObject* value)
+{
+    PyObject* new_sum;
+
+    if (sum->kind != LLIST_SUM_OBJECT && !llistreduce_sum_to_object(sum))
+        return 0;
+
+    /* value is borrowed from a list, which may be modified by
+     * the addition */
+    Py_INCREF(value);
+    new_sum = PyNumber_Add(sum->sum, value);
+    Py_DECREF(value);
+
+    if (new_sum == NULL)
+        return 0;
+
+    Py_DECREF(sum->sum);
+    sum->sum = new_sum;
+
+    return 1;
+}
+
+void llist_sum_init(LListSum* sum)
+{
+    sum->kind = LLIST_SUM_INT;
+    sum->int_sum = 0;
+    sum->float_sum = 0.0;
+    sum->sum = NULL;
+}
+
+int llist_sum_add(LListSum* sum, PyObject* value)
+{
+    PY_LONG_LONG int_value;
+
+    if (sum->kind != LLIST_SUM_OBJECT)
+    {
+        if (PyFloat_CheckExact(value))
+            return llist_sum_add_double(sum, PyFloat_AS_DOUBLE(value));
+
+        if (llistreduce_as_int64(value, &int_value))
+            return llist_sum_add_int64(sum, int_value);
+    }
+
+    return llistreduce_sum_add_object(sum, value);
+}
+
+int llist_sum_add_int64(LListSum* sum, PY_LONG_LONG value)
+{
+    PyObject* value_obj;
+    int result;
+
+    if (sum->kind == LLIST_SUM_INT)
+    {
+        if ((value > 0 && sum->int_sum <= PY_LLONG_MAX - value) ||
+            (value <= 0 && sum->int_sum >= PY_LLONG_MIN - value))
+        {
+            sum->int_sum += value;
+            return 1;
+        }
+    }
+    else if (sum->kind == LLIST_SUM_FLOAT)
+    {
+        sum->float_sum += (double)value;
+        return 1;
+    }
+
+    /* int sum overflowed */
+    value_obj = llist_int64_to_object(value);
+    if (value_obj == NULL)
+        return 0;
+
+    result = llistreduce_sum_add_object(sum, value_obj);
+    Py_DECREF(value_obj);
+
+    return result;
+}
+
+int llist_sum_add_double(LListSum* sum, double value)
+{
+    PyObject* value_obj;
+    int result;
+
+    if (sum->kind == LLIST_SUM_INT)
+    {
+        sum->float_sum = (double)sum->int_sum + value;
+        sum->kind = LLIST_SUM_FLOAT;
+        return 1;
+    }
+    else if (sum->kind == LLIST_SUM_FLOAT)
+    {
+        sum->float_sum += value;
+        return 1;
+    }
+
+    value_obj = PyFloat_FromDouble(value);
+    if (value_obj == NULL)
+        return 0;
+
+    result = llistreduce_sum_add_object(sum, value_obj);
+    Py_DECREF(value_obj);
+
+    return result;
+}
+
+/* Returns the sum (new reference) and releases the accumulator. */
+PyObject* llist_sum_result(LListSum* sum)
+{
+    PyObject* result;
+
+    switch (sum->kind)
+    {
+    case LLIST_SUM_INT:
+        return llist_int64_to_object(sum->int_sum);
+    case LLIST_SUM_FLOAT:
+        return PyFloat_FromDouble(sum->float_sum);
+    default:
+        result = sum->sum;
+        sum->sum = NULL;
+        return result;
+    }
+}
+
+void llist_sum_clear(LListSum* sum)
+{
+    Py_CLEAR(sum->sum);
+}
+
+void llist_extremum_init(LListExtremum* ext, int op)
+{
+    assert(op == Py_LT || op == Py_GT);
+
+    ext->op = op;
+    ext->value = NULL;
+}
+
+int llist_extremum_update(LListExtremum* ext, PyObject* value)
+{
+    PY_LONG_LONG a;
+    PY_LONG_LONG b;
+    int replace;
+
+    if (ext->value == NULL)
+    {
+        Py_INCREF(value);
+        ext->value = value;
+        return 1;
+    }
+
+    if (PyFloat_CheckExact(value) && PyFloat_CheckExact(ext->value))
+    {
+        double x = PyFloat_AS_DOUBLE(value);
+        double y = PyFloat_AS_DOUBLE(ext->value);
+
+        replace = (ext->op == Py_LT) ? (x < y) : (x > y);
+    }
+    else if (llistreduce_as_int64(value, &a) &&
+             llistreduce_as_int64(ext->value, &b))
+    {
+        replace = (ext->op == Py_LT) ? (a < b) : (a > b);
+    }
+    else
+    {
+        /* value is borrowed from a list, which may be modified by
+         * the comparison */
+        Py_INCREF(value);
+        replace = PyObject_RichCompareBool(value, ext->value, ext->op);
+        Py_DECREF(value);
+
+        if (replace == -1)
+            return 0;
+    }
+
+    if (replace)
+    {
+        Py_INCREF(value);
+        Py_DECREF(ext->value);
+        ext->value = value;
+    }
+
+    return 1;
+}
+
+/* Returns the extremum (new reference) and releases the accumulator.
+ * Raises ValueError if no values were passed. */
+PyObject* llist_extremum_result(LListExtremum* ext)
+{
+    PyObject* result = ext->value;
+
+    if (result == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    ext->value = NULL;
+
+    return result;
+}
+
+void llist_extremum_clear(LListExtremum* ext)
+{
+    Py_CLEAR(ext->value);
+}
+
+/* Divides sum by count (true division). Reference to sum is stolen;
+ * NULL sum is passed through, so that errors raised while computing
+ * the sum are propagated. */
+PyObject* llist_mean(PyObject* sum, Py_ssize_t count)
+{
+    PyObject* count_obj;
+    PyObject* result;
+
+    if (sum == NULL)
+        return NULL;
+
+    if (count == 0)
+    {
+        Py_DECREF(sum);
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    if (PyFloat_CheckExact(sum))
+    {
+        result = PyFloat_FromDouble(PyFloat_AS_DOUBLE(sum) / count);
+        Py_DECREF(sum);
+        return result;
+    }
+
+    count_obj = PyLong_FromSsize_t(count);
+    if (count_obj == NULL)
+    {
+        Py_DECREF(sum);
+        return NULL;
+    }
+
+    result = PyNumber_TrueDivide(sum, count_obj);
+    Py_DECREF(count_obj);
+    Py_DECREF(sum);
+
+    return result;
+}
+
+/* Converts C integer to an int object (new reference). */
+PyObject* llist_int64_to_object(PY_LONG_LONG value)
+{
+#if PY_MAJOR_VERSION < 3
+    if (value >= LONG_MIN && value <= LONG_MAX)
+        return PyInt_FromLong((long)value);
+#endif
+
+    return PyLong_FromLongLong(value);
+}
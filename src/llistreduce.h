@@ -0,0 +1,48 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#ifndef LLISTREDUCE_H
+#define LLISTREDUCE_H
+
+#define LLIST_SUM_INT       0
+#define LLIST_SUM_FLOAT     1
+#define LLIST_SUM_OBJECT    2
+
+/* Running sum of list elements. Exact ints and floats are added
+ * as C values; other values (and ints which overflow) are added
+ * with PyNumber_Add(). Values are borrowed from the caller. */
+typedef struct
+{
+    int kind;               /* one of LLIST_SUM_* */
+    PY_LONG_LONG int_sum;   /* LLIST_SUM_INT */
+    double float_sum;       /* LLIST_SUM_FLOAT */
+    PyObject* sum;          /* owned reference (LLIST_SUM_OBJECT) */
+} LListSum;
+
+/* Running minimum (op == Py_LT) or maximum (op == Py_GT) of list
+ * elements. Only values comparing strictly smaller (greater) than
+ * the current extremum replace it, as in builtin min() and max(). */
+typedef struct
+{
+    int op;
+    PyObject* value;        /* owned reference or NULL */
+} LListExtremum;
+
+void       llist_sum_init(LListSum* sum);
+int        llist_sum_add(LListSum* sum, PyObject* value);
+int        llist_sum_add_int64(LListSum* sum, PY_LONG_LONG value);
+int        llist_sum_add_double(LListSum* sum, double value);
+PyObject*  llist_sum_result(LListSum* sum);
+void       llist_sum_clear(LListSum* sum);
+
+void       llist_extremum_init(LListExtremum* ext, int op);
+int        llist_extremum_update(LListExtremum* ext, PyObject* value);
+PyObject*  llist_extremum_result(LListExtremum* ext);
+void       llist_extremum_clear(LListExtremum* ext);
+
+PyObject*  llist_mean(PyObject* sum, Py_ssize_t count);
+
+PyObject*  llist_int64_to_object(PY_LONG_LONG value);
+
+#endif /* LLISTREDUCE_H */
@@ -0,0 +1,206 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#include <Python.h>
+
+#include "llistsort.h"
+
+/* Ordered runs found in the chain are kept on a stack along with their
+ * levels (the number of merges each run went through). A new run is
+ * merged with runs of the same level on top of the stack, so levels
+ * decrease from the bottom to the top like bits of a binary counter.
+ * A run of level k holds at least 2^k cells, so the stack never needs
+ * more entries than there are bits in Py_ssize_t, and each cell takes
+ * part in O(log n) merges. */
+#define LLISTSORT_MAX_RUNS  (8 * sizeof(Py_ssize_t))
+
+#define LLISTSORT_NEXT(chain, cell) \
+    (*(void**)((char*)(cell) + (chain)->next_offset))
+
+typedef struct
+{
+    void* head;
+    void* tail;
+    int level;
+} LListSortRun;
+
+/* Returns 1 if cell a must be placed before cell b, 0 if it need not
+ * be (so that equal cells keep their order) and -1 on error. */
+static int llistsort_precedes(const LListSortChain* chain, void* a, void* b)
+{
+    if (chain->reverse)
+        return chain->less(b, a);
+
+    return chain->less(a, b);
+}
+
+/* Detaches the longest ordered run from the front of the chain
+ * at *rest. Strictly descending runs are reversed. On error, run
+ * still holds all cells detached from the chain. */
+static int llistsort_take_run(const LListSortChain* chain,
+                              LListSortRun* run,
+                              void** rest)
+{
+    void* next = LLISTSORT_NEXT(chain, *rest);
+    int r = 0;
+
+    run->head = *rest;
+    run->tail = *rest;
+    run->level = 0;
+
+    if (next != NULL)
+        r = llistsort_precedes(chain, next, run->tail);
+
+    if (r == 1)
+    {
+        /* prepend following cells, which reverses the run */
+        LLISTSORT_NEXT(chain, run->tail) = NULL;
+
+        do
+        {
+            void* following = LLISTSORT_NEXT(chain, next);
+
+            LLISTSORT_NEXT(chain, next) = run->head;
+            run->head = next;
+            next = following;
+            if (next == NULL)
+                break;
+
+            r = llistsort_precedes(chain, next, run->head);
+        } while (r == 1);
+    }
+    else
+    {
+        while (r == 0 && next != NULL)
+        {
+            run->tail = next;
+            next = LLISTSORT_NEXT(chain, next);
+            if (next != NULL)
+                r = llistsort_precedes(chain, next, run->tail);
+        }
+
+        LLISTSORT_NEXT(chain, run->tail) = NULL;
+    }
+
+    *rest = next;
+
+    return (r == -1) ? -1 : 0;
+}
+
+/* Merges run b, which follows run a in the chain, into run a.
+ * On error, run a still holds cells of both runs. */
+static int llistsort_merge(const LListSortChain* chain,
+                           LListSortRun* a,
+                           LListSortRun* b)
+{
+    void* x = a->head;
+    void* y = b->head;
+    void* head;
+    void** link = &head;
+    int r;
+
+    /* runs might already be in order */
+    r = llistsort_precedes(chain, y, a->tail);
+    if (r != 1)
+    {
+        LLISTSORT_NEXT(chain, a->tail) = y;
+        a->tail = b->tail;
+        return r;
+    }
+
+    while (x != NULL && y != NULL)
+    {
+        r = llistsort_precedes(chain, y, x);
+        if (r == -1)
+            break;
+
+        if (r)
+        {
+            *link = y;
+            link = &LLISTSORT_NEXT(chain, y);
+            y = *link;
+        }
+        else
+        {
+            *link = x;
+            link = &LLISTSORT_NEXT(chain, x);
+            x = *link;
+        }
+    }
+
+    /* append what is left of both runs */
+    if (x != NULL)
+    {
+        *link = x;
+        link = &LLISTSORT_NEXT(chain, a->tail);
+    }
+
+    *link = y;
+
+    if (y != NULL)
+        a->tail = b->tail;
+
+    a->head = head;
+
+    return (r == -1) ? -1 : 0;
+}
+
+/* Sorts the chain of cells starting at *head using a stable natural
+ * merge sort, which takes advantage of already ordered runs. Cells
+ * are relinked in place and no memory is allocated. If reverse is
+ * nonzero, cells are sorted in descending order (equal cells still
+ * keep their order). Returns 0 on success, or -1 with an exception
+ * set if keys could not be compared; *head is then set to a chain
+ * of all cells in unspecified order. */
+int llist_sort_chain(const LListSortChain* chain, void** head)
+{
+    LListSortRun runs[LLISTSORT_MAX_RUNS];
+    LListSortRun run;
+    void* rest = *head;
+    int num_runs = 0;
+    int result = 0;
+
+    if (rest == NULL)
+        return 0;
+
+    while (result == 0 && rest != NULL)
+    {
+        result = llistsort_take_run(chain, &run, &rest);
+
+        while (result == 0 && num_runs > 0 &&
+               runs[num_runs - 1].level == run.level)
+        {
+            --num_runs;
+            result = llistsort_merge(chain, &runs[num_runs], &run);
+            runs[num_runs].level = run.level + 1;
+            run = runs[num_runs];
+        }
+
+        assert(num_runs < (int)LLISTSORT_MAX_RUNS);
+        runs[num_runs++] = run;
+    }
+
+    /* merge remaining runs, or just join them after an error */
+    run = runs[--num_runs];
+
+    while (num_runs > 0)
+    {
+        LListSortRun* prev_run = &runs[--num_runs];
+
+        if (result == 0)
+            result = llistsort_merge(chain, prev_run, &run);
+        else
+        {
+            LLISTSORT_NEXT(chain, prev_run->tail) = run.head;
+            prev_run->tail = run.tail;
+        }
+
+        run = *prev_run;
+    }
+
+    LLISTSORT_NEXT(chain, run.tail) = rest;
+    *head = run.head;
+
+    return result;
+}
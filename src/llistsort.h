@@ -0,0 +1,23 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#ifndef LLISTSORT_H
+#define LLISTSORT_H
+
+/* Compares sort keys of two cells. Returns 1 if key of cell a is
+ * smaller than key of cell b, 0 if it is not and -1 on error. */
+typedef int (*LListSortLess)(void* a, void* b);
+
+/* Describes a chain of cells being sorted. Cells are linked through
+ * the pointer found at next_offset and the chain ends with NULL. */
+typedef struct
+{
+    size_t next_offset;
+    LListSortLess less;
+    int reverse;
+} LListSortChain;
+
+int        llist_sort_chain(const LListSortChain* chain, void** head);
+
+#endif /* LLISTSORT_H */
@@ -0,0 +1,836 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#include <Python.h>
+#include <structmember.h>
+#include "py23macros.h"
+
+#ifndef PyVarObject_HEAD_INIT
+    #define PyVarObject_HEAD_INIT(type, size) \
+        PyObject_HEAD_INIT(type) size,
+#endif
+
+/* Default maximum number of entries held by a cache */
+#define LRUCACHE_DEFAULT_MAXSIZE    128
+
+/* Minimum number of slots in the hash table (a power of 2) */
+#define LRUCACHE_MIN_TABLE_SIZE     8
+
+
+static PyTypeObject LRUCacheType;
+
+
+/* LRUCacheEntry */
+
+/* Entries are plain C structures linked into a doubly linked list
+ * in most recently used order, like cells of dllist. They are also
+ * referenced from an open addressing hash table, which stores their
+ * hashes, so that the table can be resized without calling back
+ * into Python code.
+ */
+typedef struct LRUCacheEntry
+{
+    PyObject* key;
+    PyObject* value;
+    Py_hash_t hash;
+    struct LRUCacheEntry* prev;     /* more recently used entry */
+    struct LRUCacheEntry* next;     /* less recently used entry */
+} LRUCacheEntry;
+
+/* Marker of hash table slots, from which entries were removed */
+static LRUCacheEntry lrucache_dummy_entry;
+
+#define LRUCACHE_DUMMY  (&lrucache_dummy_entry)
+
+
+/* LRUCache */
+
+typedef struct
+{
+    PyObject_HEAD
+    LRUCacheEntry* first;       /* most recently used entry */
+    LRUCacheEntry* last;        /* least recently used entry */
+    LRUCacheEntry** table;
+    size_t mask;                /* number of table slots - 1 */
+    Py_ssize_t fill;            /* number of entries and dummy slots */
+    Py_ssize_t size;
+    Py_ssize_t maxsize;
+    Py_ssize_t hits;
+    Py_ssize_t misses;
+    Py_ssize_t state;           /* incremented when entries are moved */
+    PyObject* callback;         /* called with evicted entries or NULL */
+    PyObject* weakref_list;
+} LRUCacheObject;
+
+/* Convenience function for unlinking entries from the list. */
+static void lrucache_unlink_entry(LRUCacheObject* self, LRUCacheEntry* entry)
+{
+    if (entry->prev != NULL)
+        entry->prev->next = entry->next;
+    else
+        self->first = entry->next;
+
+    if (entry->next != NULL)
+        entry->next->prev = entry->prev;
+    else
+        self->last = entry->prev;
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+/* Convenience function for linking entries at the front of the list
+ * (as the most recently used ones). */
+static void lrucache_link_entry(LRUCacheObject* self, LRUCacheEntry* entry)
+{
+    entry->prev = NULL;
+    entry->next = self->first;
+
+    if (self->first != NULL)
+        self->first->prev = entry;
+    else
+        self->last = entry;
+
+    self->first = entry;
+}
+
+/* Convenience function for marking entries as most recently used. */
+static void lrucache_touch_entry(LRUCacheObject* self, LRUCacheEntry* entry)
+{
+    if (entry == self->first)
+        return;
+
+    lrucache_unlink_entry(self, entry);
+    lrucache_link_entry(self, entry);
+}
+
+/* Convenience function for looking up keys in the hash table.
+ * Returns 1 and stores the slot of the entry in *slot if the key is
+ * present, 0 and stores a free slot suitable for inserting the key if it
+ * is not, or -1 on error (including modification of the cache by
+ * comparison of keys). */
+static int lrucache_lookup(LRUCacheObject* self,
+                           PyObject* key,
+                           Py_hash_t hash,
+                           size_t* slot)
+{
+    size_t perturb = (size_t)hash;
+    size_t i = (size_t)hash & self->mask;
+    int free_found = 0;
+
+    for (;;)
+    {
+        LRUCacheEntry* entry = self->table[i];
+
+        if (entry == NULL)
+        {
+            if (!free_found)
+                *slot = i;
+            return 0;
+        }
+
+        if (entry == LRUCACHE_DUMMY)
+        {
+            if (!free_found)
+            {
+                *slot = i;
+                free_found = 1;
+            }
+        }
+        else if (entry->key == key)
+        {
+            *slot = i;
+            return 1;
+        }
+        else if (entry->hash == hash)
+        {
+            PyObject* entry_key = entry->key;
+            Py_ssize_t state = self->state;
+            int equal;
+
+            Py_INCREF(entry_key);
+            equal = PyObject_RichCompareBool(entry_key, key, Py_EQ);
+            Py_DECREF(entry_key);
+            if (equal == -1)
+                return -1;
+
+            if (state != self->state)
+            {
+                PyErr_SetString(PyExc_RuntimeError,
+                    "lrucache modified during key lookup");
+                return -1;
+            }
+
+            if (equal)
+            {
+                *slot = i;
+                return 1;
+            }
+        }
+
+        perturb >>= 5;
+        i = (i * 5 + perturb + 1) & self->mask;
+    }
+}
+
+/* Convenience function for locating the table slot of an entry.
+ * Entries are matched by identity, so no keys are compared. */
+static size_t lrucache_entry_slot(LRUCacheObject* self, LRUCacheEntry* entry)
+{
+    size_t perturb = (size_t)entry->hash;
+    size_t i = (size_t)entry->hash & self->mask;
+
+    while (self->table[i] != entry)
+    {
+        assert(self->table[i] != NULL);
+
+        perturb >>= 5;
+        i = (i * 5 + perturb + 1) & self->mask;
+    }
+
+    return i;
+}
+
+/* Convenience function for reallocating the hash table, so that it has
+ * room for at least min_used entries. Dummy slots are dropped. */
+static int lrucache_resize(LRUCacheObject* self, Py_ssize_t min_used)
+{
+    LRUCacheEntry** new_table;
+    LRUCacheEntry* entry;
+    size_t new_size = LRUCACHE_MIN_TABLE_SIZE;
+
+    /* keep the table at most half full */
+    while (new_size <= (size_t)min_used * 2)
+        new_size <<= 1;
+
+    new_table = (LRUCacheEntry**)PyMem_Malloc(
+        new_size * sizeof(LRUCacheEntry*));
+    if (new_table == NULL)
+    {
+        PyErr_NoMemory();
+        return 0;
+    }
+
+    memset(new_table, 0, new_size * sizeof(LRUCacheEntry*));
+
+    PyMem_Free(self->table);
+    self->table = new_table;
+    self->mask = new_size - 1;
+    self->fill = self->size;
+    ++self->state;
+
+    for (entry = self->first; entry != NULL; entry = entry->next)
+    {
+        size_t perturb = (size_t)entry->hash;
+        size_t i = (size_t)entry->hash & self->mask;
+
+        while (self->table[i] != NULL)
+        {
+            perturb >>= 5;
+            i = (i * 5 + perturb + 1) & self->mask;
+        }
+
+        self->table[i] = entry;
+    }
+
+    return 1;
+}
+
+/* Convenience function for removing entries from the cache.
+ * The entry itself is not released. */
+static void lrucache_remove_entry(LRUCacheObject* self,
+                                  LRUCacheEntry* entry,
+                                  size_t slot)
+{
+    self->table[slot] = LRUCACHE_DUMMY;
+    lrucache_unlink_entry(self, entry);
+    --self->size;
+    ++self->state;
+}
+
+/* Convenience function for releasing entries removed from the cache. */
+static void lrucache_free_entry(LRUCacheEntry* entry)
+{
+    Py_DECREF(entry->key);
+    Py_DECREF(entry->value);
+    PyMem_Free(entry);
+}
+
+/* Convenience function for locating the entry of a key.
+ * Returns 1 and stores the entry if the key is present, 0 if not
+ * and -1 on error. */
+static int lrucache_find(LRUCacheObject* self,
+                         PyObject* key,
+                         LRUCacheEntry** entry,
+                         size_t* slot)
+{
+    Py_hash_t hash;
+    size_t entry_slot;
+    int found;
+
+    hash = PyObject_Hash(key);
+    if (hash == -1)
+        return -1;
+
+    found = lrucache_lookup(self, key, hash, &entry_slot);
+    if (found == 1)
+    {
+        *entry = self->table[entry_slot];
+        if (slot != NULL)
+            *slot = entry_slot;
+    }
+
+    return found;
+}
+
+/* Convenience function for removing all entries from the cache.
+ * Values are released once the cache is consistent again. */
+static void lrucache_clear_internal(LRUCacheObject* self)
+{
+    LRUCacheEntry* entry = self->first;
+
+    if (self->table != NULL)
+        memset(self->table, 0, (self->mask + 1) * sizeof(LRUCacheEntry*));
+
+    self->first = NULL;
+    self->last = NULL;
+    self->fill = 0;
+    self->size = 0;
+    ++self->state;
+
+    while (entry != NULL)
+    {
+        LRUCacheEntry* next = entry->next;
+
+        lrucache_free_entry(entry);
+        entry = next;
+    }
+}
+
+static int lrucache_traverse(LRUCacheObject* self, visitproc visit, void* arg)
+{
+    LRUCacheEntry* entry = NULL;
+
+    for (entry = self->first; entry != NULL; entry = entry->next)
+    {
+        Py_VISIT(entry->key);
+        Py_VISIT(entry->value);
+    }
+
+    Py_VISIT(self->callback);
+
+    return 0;
+}
+
+static int lrucache_tp_clear(LRUCacheObject* self)
+{
+    lrucache_clear_internal(self);
+    Py_CLEAR(self->callback);
+
+    return 0;
+}
+
+static void lrucache_dealloc(LRUCacheObject* self)
+{
+    PyObject_GC_UnTrack(self);
+
+    if (self->weakref_list != NULL)
+        PyObject_ClearWeakRefs((PyObject*)self);
+
+    lrucache_tp_clear(self);
+    PyMem_Free(self->table);
+
+    Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* lrucache_new(PyTypeObject* type,
+                              PyObject* args,
+                              PyObject* kwds)
+{
+    LRUCacheObject* self;
+
+    self = (LRUCacheObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->first = NULL;
+    self->last = NULL;
+    self->table = NULL;
+    self->mask = 0;
+    self->fill = 0;
+    self->size = 0;
+    self->maxsize = LRUCACHE_DEFAULT_MAXSIZE;
+    self->hits = 0;
+    self->misses = 0;
+    self->state = 0;
+    self->callback = NULL;
+    self->weakref_list = NULL;
+
+    if (!lrucache_resize(self, 0))
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return (PyObject*)self;
+}
+
+static int lrucache_init(LRUCacheObject* self,
+                         PyObject* args,
+                         PyObject* kwds)
+{
+    static char* kwlist[] = { "maxsize", "callback", NULL };
+    Py_ssize_t maxsize = LRUCACHE_DEFAULT_MAXSIZE;
+    PyObject* callback = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|nO:lrucache", kwlist,
+                                     &maxsize, &callback))
+        return -1;
+
+    if (maxsize < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "Maximum size must be at least 1");
+        return -1;
+    }
+
+    if (callback == Py_None)
+        callback = NULL;
+
+    if (callback != NULL && !PyCallable_Check(callback))
+    {
+        PyErr_SetString(PyExc_TypeError, "Callback must be callable");
+        return -1;
+    }
+
+    if (self->size > maxsize)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot shrink a cache below its current size");
+        return -1;
+    }
+
+    self->maxsize = maxsize;
+
+    Py_XINCREF(callback);
+    Py_XDECREF(self->callback);
+    self->callback = callback;
+
+    return 0;
+}
+
+static PyObject* lrucache_get(LRUCacheObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* key;
+    PyObject* default_value = Py_None;
+    LRUCacheEntry* entry = NULL;
+    int found;
+
+    if (!Py23Args_Unpack("get", Py23_FASTCALL_ARGS,
+                         1, 2, &key, &default_value))
+        return NULL;
+
+    found = lrucache_find(self, key, &entry, NULL);
+    if (found == -1)
+        return NULL;
+
+    if (!found)
+    {
+        ++self->misses;
+        Py_INCREF(default_value);
+        return default_value;
+    }
+
+    ++self->hits;
+    lrucache_touch_entry(self, entry);
+
+    Py_INCREF(entry->value);
+    return entry->value;
+}
+
+static PyObject* lrucache_peek(LRUCacheObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* key;
+    PyObject* default_value = Py_None;
+    LRUCacheEntry* entry = NULL;
+    int found;
+
+    if (!Py23Args_Unpack("peek", Py23_FASTCALL_ARGS,
+                         1, 2, &key, &default_value))
+        return NULL;
+
+    found = lrucache_find(self, key, &entry, NULL);
+    if (found == -1)
+        return NULL;
+
+    if (!found)
+    {
+        Py_INCREF(default_value);
+        return default_value;
+    }
+
+    Py_INCREF(entry->value);
+    return entry->value;
+}
+
+/* Convenience function for storing values in the cache. If the cache
+ * is full, the least recently used entry is evicted and passed to
+ * the callback. Returns 0 on success and -1 on error. */
+static int lrucache_put_internal(LRUCacheObject* self,
+                                 PyObject* key,
+                                 PyObject* value)
+{
+    LRUCacheEntry* entry = NULL;
+    PyObject* old_key = NULL;
+    PyObject* old_value;
+    Py_hash_t hash;
+    size_t slot;
+    int found;
+
+    hash = PyObject_Hash(key);
+    if (hash == -1)
+        return -1;
+
+    /* make sure that a free slot remains after insertion */
+    if ((size_t)(self->fill + 1) * 3 >= (self->mask + 1) * 2 &&
+        !lrucache_resize(self, self->size + 1))
+        return -1;
+
+    found = lrucache_lookup(self, key, hash, &slot);
+    if (found == -1)
+        return -1;
+
+    if (found)
+    {
+        entry = self->table[slot];
+        old_value = entry->value;
+        Py_INCREF(value);
+        entry->value = value;
+        lrucache_touch_entry(self, entry);
+        Py_DECREF(old_value);
+        return 0;
+    }
+
+    if (self->size >= self->maxsize)
+    {
+        /* reuse the least recently used entry */
+        entry = self->last;
+        old_key = entry->key;
+        old_value = entry->value;
+        lrucache_remove_entry(self, entry, lrucache_entry_slot(self, entry));
+    }
+    else
+    {
+        entry = (LRUCacheEntry*)PyMem_Malloc(sizeof(LRUCacheEntry));
+        if (entry == NULL)
+        {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+
+    Py_INCREF(key);
+    Py_INCREF(value);
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+
+    if (self->table[slot] == NULL)
+        ++self->fill;
+
+    self->table[slot] = entry;
+    lrucache_link_entry(self, entry);
+    ++self->size;
+    ++self->state;
+
+    if (old_key != NULL)
+    {
+        PyObject* result = NULL;
+
+        /* the cache is consistent again, so Python code may run */
+        if (self->callback != NULL)
+        {
+            result = PyObject_CallFunctionObjArgs(
+                self->callback, old_key, old_value, NULL);
+        }
+
+        Py_DECREF(old_key);
+        Py_DECREF(old_value);
+
+        if (self->callback != NULL)
+        {
+            if (result == NULL)
+                return -1;
+
+            Py_DECREF(result);
+        }
+    }
+
+    return 0;
+}
+
+static PyObject* lrucache_put(LRUCacheObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* key;
+    PyObject* value;
+
+    if (!Py23Args_Unpack("put", Py23_FASTCALL_ARGS,
+                         2, 2, &key, &value))
+        return NULL;
+
+    if (lrucache_put_internal(self, key, value) == -1)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+/* Convenience function for removing keys from the cache.
+ * Returns the value of removed entry as a new reference, or NULL
+ * if the key is not present. Check PyErr_Occurred() in the latter case. */
+static PyObject* lrucache_pop_internal(LRUCacheObject* self, PyObject* key)
+{
+    LRUCacheEntry* entry = NULL;
+    PyObject* value;
+    size_t slot;
+    int found;
+
+    found = lrucache_find(self, key, &entry, &slot);
+    if (found != 1)
+        return NULL;
+
+    lrucache_remove_entry(self, entry, slot);
+
+    value = entry->value;
+    Py_DECREF(entry->key);
+    PyMem_Free(entry);
+
+    return value;
+}
+
+static PyObject* lrucache_pop(LRUCacheObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* key;
+    PyObject* default_value = NULL;
+    PyObject* value;
+
+    if (!Py23Args_Unpack("pop", Py23_FASTCALL_ARGS,
+                         1, 2, &key, &default_value))
+        return NULL;
+
+    value = lrucache_pop_internal(self, key);
+    if (value != NULL || PyErr_Occurred())
+        return value;
+
+    if (default_value == NULL)
+    {
+        PyErr_SetObject(PyExc_KeyError, key);
+        return NULL;
+    }
+
+    Py_INCREF(default_value);
+    return default_value;
+}
+
+static PyObject* lrucache_clear(LRUCacheObject* self)
+{
+    lrucache_clear_internal(self);
+
+    if (!lrucache_resize(self, 0))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* lrucache_items(LRUCacheObject* self)
+{
+    LRUCacheEntry* entry = NULL;
+    PyObject* items;
+    Py_ssize_t i = 0;
+
+    items = PyList_New(self->size);
+    if (items == NULL)
+        return NULL;
+
+    for (entry = self->first; entry != NULL; entry = entry->next, ++i)
+    {
+        PyObject* item = PyTuple_Pack(2, entry->key, entry->value);
+        if (item == NULL)
+        {
+            Py_DECREF(items);
+            return NULL;
+        }
+
+        PyList_SET_ITEM(items, i, item);
+    }
+
+    return items;
+}
+
+static Py_ssize_t lrucache_len(PyObject* self)
+{
+    return ((LRUCacheObject*)self)->size;
+}
+
+static int lrucache_contains(PyObject* self, PyObject* key)
+{
+    LRUCacheEntry* entry = NULL;
+
+    return lrucache_find((LRUCacheObject*)self, key, &entry, NULL);
+}
+
+static PyObject* lrucache_subscript(PyObject* self, PyObject* key)
+{
+    LRUCacheObject* cache = (LRUCacheObject*)self;
+    LRUCacheEntry* entry = NULL;
+    int found;
+
+    found = lrucache_find(cache, key, &entry, NULL);
+    if (found == -1)
+        return NULL;
+
+    if (!found)
+    {
+        ++cache->misses;
+        PyErr_SetObject(PyExc_KeyError, key);
+        return NULL;
+    }
+
+    ++cache->hits;
+    lrucache_touch_entry(cache, entry);
+
+    Py_INCREF(entry->value);
+    return entry->value;
+}
+
+static int lrucache_ass_subscript(PyObject* self,
+                                  PyObject* key,
+                                  PyObject* value)
+{
+    PyObject* old_value;
+
+    if (value != NULL)
+        return lrucache_put_internal((LRUCacheObject*)self, key, value);
+
+    old_value = lrucache_pop_internal((LRUCacheObject*)self, key);
+    if (old_value == NULL)
+    {
+        if (!PyErr_Occurred())
+            PyErr_SetObject(PyExc_KeyError, key);
+        return -1;
+    }
+
+    Py_DECREF(old_value);
+
+    return 0;
+}
+
+static PyMethodDef LRUCacheMethods[] =
+{
+    { "clear", (PyCFunction)lrucache_clear, METH_NOARGS,
+      "Remove all entries from the cache" },
+    { "get", (PyCFunction)lrucache_get, Py23_METH_FASTCALL,
+      "Return value of key and mark it as most recently used" },
+    { "items", (PyCFunction)lrucache_items, METH_NOARGS,
+      "Return list of (key, value) pairs from most recently used" },
+    { "peek", (PyCFunction)lrucache_peek, Py23_METH_FASTCALL,
+      "Return value of key without marking it as used" },
+    { "pop", (PyCFunction)lrucache_pop, Py23_METH_FASTCALL,
+      "Remove key from the cache and return its value" },
+    { "put", (PyCFunction)lrucache_put, Py23_METH_FASTCALL,
+      "Store value of key, evicting least recently used entry if full" },
+    { NULL },   /* sentinel */
+};
+
+static PyMemberDef LRUCacheMembers[] =
+{
+    { "maxsize", T_PYSSIZET, offsetof(LRUCacheObject, maxsize), READONLY,
+      "Maximum number of entries in the cache" },
+    { "hits", T_PYSSIZET, offsetof(LRUCacheObject, hits), READONLY,
+      "Number of lookups, which found their key" },
+    { "misses", T_PYSSIZET, offsetof(LRUCacheObject, misses), READONLY,
+      "Number of lookups, which did not find their key" },
+    { "size", T_PYSSIZET, offsetof(LRUCacheObject, size), READONLY,
+      "Number of entries in the cache" },
+    { NULL },   /* sentinel */
+};
+
+static PySequenceMethods LRUCacheSequenceMethods =
+{
+    lrucache_len,               /* sq_length */
+    0,                          /* sq_concat */
+    0,                          /* sq_repeat */
+    0,                          /* sq_item */
+    0,                          /* sq_slice */
+    0,                          /* sq_ass_item */
+    0,                          /* sq_ass_slice */
+    lrucache_contains,          /* sq_contains */
+    0,                          /* sq_inplace_concat */
+    0,                          /* sq_inplace_repeat */
+};
+
+static PyMappingMethods LRUCacheMappingMethods =
+{
+    lrucache_len,               /* mp_length */
+    lrucache_subscript,         /* mp_subscript */
+    lrucache_ass_subscript,     /* mp_ass_subscript */
+};
+
+static PyTypeObject LRUCacheType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "llist.lrucache",           /* tp_name */
+    sizeof(LRUCacheObject),     /* tp_basicsize */
+    0,                          /* tp_itemsize */
+    (destructor)lrucache_dealloc,
+                                /* tp_dealloc */
+    0,                          /* tp_print */
+    0,                          /* tp_getattr */
+    0,                          /* tp_setattr */
+    0,                          /* tp_compare */
+    0,                          /* tp_repr */
+    0,                          /* tp_as_number */
+    &LRUCacheSequenceMethods,   /* tp_as_sequence */
+    &LRUCacheMappingMethods,    /* tp_as_mapping */
+    0,                          /* tp_hash */
+    0,                          /* tp_call */
+    0,                          /* tp_str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+    0,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+                                /* tp_flags */
+    "Least recently used cache",
+                                /* tp_doc */
+    (traverseproc)lrucache_traverse,
+                                /* tp_traverse */
+    (inquiry)lrucache_tp_clear, /* tp_clear */
+    0,                          /* tp_richcompare */
+    offsetof(LRUCacheObject, weakref_list),
+                                /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    LRUCacheMethods,            /* tp_methods */
+    LRUCacheMembers,            /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    (initproc)lrucache_init,    /* tp_init */
+    0,                          /* tp_alloc */
+    lrucache_new,               /* tp_new */
+};
+
+
+int lrucache_init_type(void)
+{
+    return (PyType_Ready(&LRUCacheType) == 0) ? 1 : 0;
+}
+
+void lrucache_register(PyObject* module)
+{
+    Py_INCREF(&LRUCacheType);
+
+    PyModule_AddObject(module, "lrucache", (PyObject*)&LRUCacheType);
+}
@@ -0,0 +1,11 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+int        lrucache_init_type(void);
+void       lrucache_register(PyObject* module);
+
+#endif /* LRUCACHE_H */
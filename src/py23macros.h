@@ -29,8 +29,11 @@
         *left = tmpConcatString;                            \
     } while (0)
 
-#define Py23Int_Check       PyLong_Check
-#define Py23Int_AsSsize_t   PyLong_AsSsize_t
+#define Py23Int_Check           PyLong_Check
+#define Py23Int_AsSsize_t       PyLong_AsSsize_t
+#define Py23Int_FromSsize_t     PyLong_FromSsize_t
+
+#define Py23Slice_GetIndicesEx  PySlice_GetIndicesEx
 
 #else
 
@@ -38,9 +41,123 @@
 #define Py23String_Concat           PyString_Concat
 #define Py23String_ConcatAndDel     PyString_ConcatAndDel
 
-#define Py23Int_Check       PyInt_Check
-#define Py23Int_AsSsize_t   PyInt_AsSsize_t
+#define Py23Int_Check           PyInt_Check
+#define Py23Int_AsSsize_t       PyInt_AsSsize_t
+#define Py23Int_FromSsize_t     PyInt_FromSsize_t
+
+typedef long Py_hash_t;
+
+#define Py23Slice_GetIndicesEx(slice, length, start, stop, step, slicelength) \
+    PySlice_GetIndicesEx((PySliceObject*)(slice), length,                     \
+                         start, stop, step, slicelength)
 
 #endif /* PY_MAJOR_VERSION >= 3 */
 
+
+/* Methods taking positional arguments are declared with
+ * Py23_FASTCALL_PARAMS and registered with Py23_METH_FASTCALL.
+ * Python 3.7+ passes arguments as a C array (METH_FASTCALL),
+ * older versions pass an argument tuple (METH_VARARGS). Arguments
+ * are unpacked with Py23Args_Unpack(name, Py23_FASTCALL_ARGS, ...). */
+#if PY_VERSION_HEX >= 0x03070000
+
+#define Py23_METH_FASTCALL      METH_FASTCALL
+#define Py23_FASTCALL_PARAMS    PyObject* const* args, Py_ssize_t nargs
+#define Py23_FASTCALL_ARGS      args, nargs
+
+#else
+
+#define Py23_METH_FASTCALL      METH_VARARGS
+#define Py23_FASTCALL_PARAMS    PyObject* args
+#define Py23_FASTCALL_ARGS      \
+    &PyTuple_GET_ITEM(args, 0), PyTuple_GET_SIZE(args)
+
+#endif /* PY_VERSION_HEX >= 0x03070000 */
+
+/* Counterpart of PyArg_UnpackTuple() for argument arrays. Stores
+ * borrowed references to arguments in PyObject** pointers passed
+ * after max. Pointers of omitted optional arguments are left intact. */
+Py_LOCAL_INLINE(int) Py23Args_Unpack(const char* name,
+                                     PyObject* const* args,
+                                     Py_ssize_t nargs,
+                                     Py_ssize_t min,
+                                     Py_ssize_t max,
+                                     ...)
+{
+    va_list vargs;
+    Py_ssize_t i;
+
+    if (nargs < min || nargs > max)
+    {
+        Py_ssize_t expected = (nargs < min) ? min : max;
+
+        PyErr_Format(PyExc_TypeError, "%s expected %s%zd argument%s, got %zd",
+            name,
+            (min == max) ? "" : (nargs < min) ? "at least " : "at most ",
+            expected, (expected == 1) ? "" : "s", nargs);
+        return 0;
+    }
+
+    va_start(vargs, max);
+    for (i = 0; i < nargs; ++i)
+        *va_arg(vargs, PyObject**) = args[i];
+    va_end(vargs);
+
+    return 1;
+}
+
+/* Python 3.9+ calls types through their tp_vectorcall slot, which
+ * lets constructors skip building argument tuples. */
+#if PY_VERSION_HEX >= 0x03090000
+
+#define Py23_HAVE_VECTORCALL
+
+/* Fallback for vectorcall constructors, which do not handle given
+ * arguments themselves. Calls the type through tp_new and tp_init. */
+Py_LOCAL_INLINE(PyObject*) Py23Type_VectorcallFallback(PyObject* type,
+                                                       PyObject* const* args,
+                                                       size_t nargsf,
+                                                       PyObject* kwnames)
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    PyObject* arg_tuple;
+    PyObject* kwds = NULL;
+    PyObject* result = NULL;
+    Py_ssize_t i;
+
+    arg_tuple = PyTuple_New(nargs);
+    if (arg_tuple == NULL)
+        return NULL;
+
+    for (i = 0; i < nargs; ++i)
+    {
+        Py_INCREF(args[i]);
+        PyTuple_SET_ITEM(arg_tuple, i, args[i]);
+    }
+
+    if (kwnames != NULL && PyTuple_GET_SIZE(kwnames) > 0)
+    {
+        kwds = PyDict_New();
+        if (kwds == NULL)
+            goto done;
+
+        for (i = 0; i < PyTuple_GET_SIZE(kwnames); ++i)
+        {
+            if (PyDict_SetItem(kwds, PyTuple_GET_ITEM(kwnames, i),
+                               args[nargs + i]) == -1)
+                goto done;
+        }
+    }
+
+    result = PyType_Type.tp_call(type, arg_tuple, kwds);
+
+done:
+    Py_DECREF(arg_tuple);
+    Py_XDECREF(kwds);
+
+    return result;
+}
+
+#endif /* PY_VERSION_HEX >= 0x03090000 */
+
 #endif /* MACROS_H */
@@ -5,6 +5,8 @@
 #include <Python.h>
 #include <structmember.h>
 #include "py23macros.h"
+#include "llistreduce.h"
+#include "llistsort.h"
 
 #ifndef PyVarObject_HEAD_INIT
     #define PyVarObject_HEAD_INIT(type, size) \
@@ -16,70 +18,188 @@ static PyTypeObject SLListType;
 static PyTypeObject SLListNodeType;
 static PyTypeObject SLListIteratorType;
 
+static PyObject* sllistiterator_create(PyTypeObject* type,
+                                       PyObject* owner_list,
+                                       int nodes);
+static int sllist_check_node_list(PyObject* list);
+static int sllist_check_node_value(PyObject* list);
+
+
+/* SLListCell */
+
+/* Elements of the list are stored in plain C cells. Python node
+ * objects (sllistnode) are created only when requested by user
+ * and cached in the cell, so that a single node object represents
+ * the cell for as long as the node is alive.
+ */
+typedef struct SLListCell
+{
+    PyObject* value;
+    struct SLListCell* next;
+    struct SLListNodeObject* node;  /* borrowed reference or NULL */
+    Py_ssize_t spine_pos;   /* slot in the list's spine, if recorded */
+} SLListCell;
 
 /* SLListNode */
 
-typedef struct
+typedef struct SLListNodeObject
 {
     PyObject_HEAD
-    PyObject* value;
-    PyObject* next;
-    PyObject* list_weakref;
+    SLListCell* cell;
+    PyObject* list;     /* borrowed reference to owner list or NULL */
 } SLListNodeObject;
 
-
-static SLListNodeObject* sllistnode_create(PyObject* next,
-                                           PyObject* value,
-                                           PyObject* owner_list)
+/* Released cells and nodes are kept on free lists (chained through
+ * their next and cell pointers respectively) and reused by later
+ * allocations, so that steady append/pop churn does not hit
+ * the memory allocator. */
+static SLListCell* sllistcell_free_list = NULL;
+static Py_ssize_t sllistcell_num_free = 0;
+static SLListNodeObject* sllistnode_free_list = NULL;
+static Py_ssize_t sllistnode_num_free = 0;
+static Py_ssize_t sllist_max_free = 0;
+
+/* Convenience function for allocating unlinked cells. */
+static SLListCell* sllistcell_new(PyObject* value)
 {
-    SLListNodeObject *node;
-    PyObject* args = NULL;
+    SLListCell* cell;
 
     assert(value != NULL);
-    assert(owner_list != NULL);
-    assert(owner_list != Py_None);
 
-    if (value != Py_None)
+    if (sllistcell_free_list != NULL)
+    {
+        cell = sllistcell_free_list;
+        sllistcell_free_list = cell->next;
+        --sllistcell_num_free;
+    }
+    else
     {
-        args = PyTuple_New(1);
-        if (args == NULL)
+        cell = (SLListCell*)PyMem_Malloc(sizeof(SLListCell));
+        if (cell == NULL)
         {
-            PyErr_SetString(PyExc_RuntimeError,
-                "Failed to create argument tuple");
+            PyErr_NoMemory();
             return NULL;
         }
+    }
 
-        Py_INCREF(value);
-        if (PyTuple_SetItem(args, 0, value) != 0)
-        {
-            PyErr_SetString(PyExc_RuntimeError,
-                "Failed to initialize argument tuple");
-            return NULL;
-        }
+    Py_INCREF(value);
+    cell->value = value;
+    cell->next = NULL;
+    cell->node = NULL;
+    cell->spine_pos = -1;
+
+    return cell;
+}
+
+/* Convenience function for releasing cells, which are neither
+ * linked into a list nor represented by a node. */
+static void sllistcell_free(SLListCell* cell)
+{
+    assert(cell->node == NULL);
+
+    Py_DECREF(cell->value);
+
+    if (sllistcell_num_free < sllist_max_free)
+    {
+        cell->next = sllistcell_free_list;
+        sllistcell_free_list = cell;
+        ++sllistcell_num_free;
+        return;
     }
 
-    node = (SLListNodeObject*)PyObject_CallObject(
-        (PyObject*)&SLListNodeType, args);
+    PyMem_Free(cell);
+}
+
+/* Convenience function for deleting cells unlinked from a list.
+ * If the cell is represented by a node, the node is detached from
+ * its owner list and becomes the owner of the cell. Pointers
+ * in neighbours must be updated by caller.
+ */
+static void sllistcell_delete(SLListCell* cell)
+{
+    cell->next = NULL;
+
+    if (cell->node != NULL)
+        cell->node->list = NULL;
+    else
+        sllistcell_free(cell);
+}
 
-    Py_XDECREF(args);
+/* Convenience function for allocating nodes. It bypasses the generic
+ * tp_new/tp_init call machinery, so that no argument tuples need
+ * to be built when nodes are handed out to user. */
+static SLListNodeObject* sllistnode_alloc(PyTypeObject* type)
+{
+    SLListNodeObject* node;
 
-    /* next is initialized to Py_None by default
-     * (by sllistnode_new) */
-    if (next != NULL && next != Py_None)
-        node->next = next;
+    if (type == &SLListNodeType && sllistnode_free_list != NULL)
+    {
+        /* reuse memory of a previously deallocated node */
+        node = sllistnode_free_list;
+        sllistnode_free_list = (SLListNodeObject*)node->cell;
+        --sllistnode_num_free;
+        PyObject_Init((PyObject*)node, type);
+    }
+    else
+    {
+        node = (SLListNodeObject*)type->tp_alloc(type, 0);
+        if (node == NULL)
+            return NULL;
+    }
 
-    Py_DECREF(node->list_weakref);
-    node->list_weakref = PyWeakref_NewRef(owner_list, NULL);
+    node->cell = NULL;
+    node->list = NULL;
 
     return node;
 }
 
+/* Convenience function for obtaining a node representing the cell
+ * (as a new reference). The node is created on first request and
+ * cached in the cell afterwards. Returns Py_None if cell is NULL.
+ */
+static PyObject* sllistnode_from_cell(PyObject* owner_list, SLListCell* cell)
+{
+    SLListNodeObject* node;
+
+    if (cell == NULL)
+        Py_RETURN_NONE;
+
+    if (cell->node != NULL)
+    {
+        Py_INCREF((PyObject*)cell->node);
+        return (PyObject*)cell->node;
+    }
+
+    node = sllistnode_alloc(&SLListNodeType);
+    if (node == NULL)
+        return NULL;
+
+    node->cell = cell;
+    node->list = owner_list;
+    cell->node = node;
+
+    return (PyObject*)node;
+}
 
 static void sllistnode_dealloc(SLListNodeObject* self)
 {
-    Py_DECREF(self->list_weakref);
-    Py_DECREF(self->value);
-    Py_DECREF(Py_None);
+    if (self->cell != NULL)
+    {
+        self->cell->node = NULL;
+
+        /* cells of detached nodes are owned by the node */
+        if (self->list == NULL)
+            sllistcell_free(self->cell);
+    }
+
+    if (Py_TYPE(self) == &SLListNodeType &&
+        sllistnode_num_free < sllist_max_free)
+    {
+        self->cell = (SLListCell*)sllistnode_free_list;
+        sllistnode_free_list = self;
+        ++sllistnode_num_free;
+        return;
+    }
 
     PyObject_Del((PyObject*)self);
 }
@@ -89,6 +209,7 @@ static int sllistnode_init(SLListNodeObject* self,
                            PyObject* kwds)
 {
     PyObject* value = NULL;
+    PyObject* oldval;
 
     if (!PyArg_UnpackTuple(args, "__init__", 0, 1, &value))
         return -1;
@@ -96,40 +217,65 @@ static int sllistnode_init(SLListNodeObject* self,
     if (value == NULL)
         return 0;
 
+    if (self->list != NULL && !sllist_check_node_list(self->list))
+        return -1;
+
     /* initialize node using passed value */
-    Py_DECREF(self->value);
+    oldval = self->cell->value;
     Py_INCREF(value);
-    self->value = value;
+    self->cell->value = value;
+    Py_DECREF(oldval);
 
     return 0;
 }
 
 
 
-static PyObject* sllistnode_new(PyTypeObject* type,
-                                PyObject* args,
-                                PyObject* kwds)
+/* Convenience function for creating nodes, which are not part
+ * of any list. Such node owns a private cell. */
+static PyObject* sllistnode_create(PyTypeObject* type, PyObject* value)
 {
     SLListNodeObject* self;
 
-    self = (SLListNodeObject*)type->tp_alloc(type, 0);
+    self = sllistnode_alloc(type);
     if (self == NULL)
         return NULL;
 
-    /* A single reference to Py_None is held for the whole
-     * lifetime of a node. */
-    Py_INCREF(Py_None);
-
-    self->next = Py_None;
-    self->value = Py_None;
-    self->list_weakref = Py_None;
+    self->cell = sllistcell_new(value);
+    if (self->cell == NULL)
+    {
+        Py_DECREF((PyObject*)self);
+        return NULL;
+    }
 
-    Py_INCREF(self->value);
-    Py_INCREF(self->list_weakref);
+    self->cell->node = self;
 
     return (PyObject*)self;
 }
 
+static PyObject* sllistnode_new(PyTypeObject* type,
+                                PyObject* args,
+                                PyObject* kwds)
+{
+    return sllistnode_create(type, Py_None);
+}
+
+#ifdef Py23_HAVE_VECTORCALL
+static PyObject* sllistnode_vectorcall(PyObject* type,
+                                       PyObject* const* args,
+                                       size_t nargsf,
+                                       PyObject* kwnames)
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+
+    if (kwnames != NULL || nargs > 1)
+        return Py23Type_VectorcallFallback(type, args, nargsf, kwnames);
+
+    return sllistnode_create((PyTypeObject*)type,
+                             (nargs == 1) ? args[0] : Py_None);
+}
+#endif
+
 
 
 static PyObject* sllistnode_repr(SLListNodeObject* self)
@@ -137,11 +283,14 @@ static PyObject* sllistnode_repr(SLListNodeObject* self)
     PyObject* str = NULL;
     PyObject* tmp_str;
 
+    if (self->list != NULL && !sllist_check_node_value(self->list))
+        return NULL;
+
     str = Py23String_FromString("<sllistnode(");
     if (str == NULL)
         goto str_alloc_error;
 
-    tmp_str = PyObject_Repr(self->value);
+    tmp_str = PyObject_Repr(self->cell->value);
     if (tmp_str == NULL)
         goto str_alloc_error;
     Py23String_ConcatAndDel(&str, tmp_str);
@@ -164,11 +313,14 @@ static PyObject* sllistnode_str(SLListNodeObject* self)
     PyObject* str = NULL;
     PyObject* tmp_str;
 
+    if (self->list != NULL && !sllist_check_node_value(self->list))
+        return NULL;
+
     str = Py23String_FromString("sllistnode(");
     if (str == NULL)
         goto str_alloc_error;
 
-    tmp_str = PyObject_Str(self->value);
+    tmp_str = PyObject_Str(self->cell->value);
     if (tmp_str == NULL)
         goto str_alloc_error;
     Py23String_ConcatAndDel(&str, tmp_str);
@@ -194,19 +346,59 @@ static PyObject* sllistnode_call(PyObject* self,
                                  PyObject* kw)
 {
     SLListNodeObject* node = (SLListNodeObject*)self;
-    Py_INCREF(node->value);
-    return node->value;
+
+    if (node->list != NULL && !sllist_check_node_value(node->list))
+        return NULL;
+
+    Py_INCREF(node->cell->value);
+    return node->cell->value;
+}
+
+
+static PyObject* sllistnode_get_value(SLListNodeObject* self, void* closure)
+{
+    if (self->list != NULL && !sllist_check_node_value(self->list))
+        return NULL;
+
+    Py_INCREF(self->cell->value);
+    return self->cell->value;
 }
 
+static int sllistnode_set_value(SLListNodeObject* self,
+                                PyObject* value,
+                                void* closure)
+{
+    PyObject* oldval;
+
+    if (value == NULL)
+    {
+        PyErr_SetString(PyExc_TypeError, "Cannot delete node value");
+        return -1;
+    }
+
+    if (self->list != NULL && !sllist_check_node_list(self->list))
+        return -1;
+
+    oldval = self->cell->value;
+    Py_INCREF(value);
+    self->cell->value = value;
+    Py_DECREF(oldval);
+
+    return 0;
+}
 
+static PyObject* sllistnode_get_next(SLListNodeObject* self, void* closure)
+{
+    return sllistnode_from_cell(self->list, self->cell->next);
+}
 
 
-static PyMemberDef SLListNodeMembers[] =
+static PyGetSetDef SLListNodeGetSetters[] =
 {
-    { "value", T_OBJECT_EX, offsetof(SLListNodeObject, value), 0,
-      "value" },
-    { "next", T_OBJECT_EX, offsetof(SLListNodeObject, next), READONLY,
-      "next node" },
+    { "value", (getter)sllistnode_get_value, (setter)sllistnode_set_value,
+      "value", NULL },
+    { "next", (getter)sllistnode_get_next, NULL,
+      "next node", NULL },
     { NULL },   /* sentinel */
 };
 
@@ -241,8 +433,8 @@ static PyTypeObject SLListNodeType =
     0,                              /* tp_iter           */
     0,                              /* tp_iternext       */
     0,                              /* tp_methods        */
-    SLListNodeMembers,              /* tp_members        */
-    0,                              /* tp_getset         */
+    0,                              /* tp_members        */
+    SLListNodeGetSetters,           /* tp_getset         */
     0,                              /* tp_base           */
     0,                              /* tp_dict           */
     0,                              /* tp_descr_get      */
@@ -259,234 +451,705 @@ static PyTypeObject SLListNodeType =
 /*                                      SLLIST                                    */
 /* ****************************************************************************** */
 
+/* Finding the predecessor of the last cell would require scanning
+ * the whole list. Instead lists lazily record every SLLIST_SPINE_STEP-th
+ * cell passed by such scans in an array (the spine), so that subsequent
+ * scans start from the closest recorded cell. The spine holds a subset
+ * of list cells in list order, possibly with NULL slots left by removed
+ * cells. Cells remember their slot, so that removing a cell from
+ * the middle of the list updates a single slot. The spine is emptied
+ * only when cells are reordered. */
+#define SLLIST_SPINE_STEP 16
+
 typedef struct
 {
     PyObject_HEAD
-    PyObject* first;
-    PyObject* last;
+    SLListCell* first;
+    SLListCell* last;
+    SLListCell* last_accessed_cell;
+    Py_ssize_t last_accessed_idx;
     Py_ssize_t size;
+    Py_ssize_t state;       /* incremented when cells are relinked */
+    int sorting;            /* nonzero while sort() keeps cells unlinked */
+    SLListCell** spine;
+    Py_ssize_t spine_start;
+    Py_ssize_t spine_end;
+    Py_ssize_t spine_capacity;
     PyObject* weakref_list;
 } SLListObject;
 
 
-static void sllist_dealloc(SLListObject* self)
+/* Convenience function for appending cells to the spine. The spine
+ * is only an optimization, so that allocation failures are ignored. */
+static void sllist_spine_push(SLListObject* self, SLListCell* cell)
 {
-    PyObject* node = self->first;
+    if (self->spine_end == self->spine_capacity)
+    {
+        Py_ssize_t used = self->spine_end - self->spine_start;
 
-    if (self->weakref_list != NULL)
-        PyObject_ClearWeakRefs((PyObject*)self);
+        if (self->spine_start > used)
+        {
+            Py_ssize_t i;
 
-    while (node != Py_None)
-    {
-        PyObject* next_node = ((SLListNodeObject*)node)->next;
-        ((SLListNodeObject*)node)->next = Py_None;
-        Py_DECREF(node);
-        node = next_node;
-    }
+            /* reclaim space left by cells removed from the front */
+            memmove(self->spine, self->spine + self->spine_start,
+                used * sizeof(SLListCell*));
+            self->spine_start = 0;
+            self->spine_end = used;
+
+            for (i = 0; i < used; ++i)
+            {
+                if (self->spine[i] != NULL)
+                    self->spine[i]->spine_pos = i;
+            }
+        }
+        else
+        {
+            Py_ssize_t new_capacity = (self->spine_capacity > 0) ?
+                self->spine_capacity * 2 : 16;
+            SLListCell** new_spine = (SLListCell**)PyMem_Realloc(
+                self->spine, new_capacity * sizeof(SLListCell*));
 
-    Py_DECREF(Py_None);
+            if (new_spine == NULL)
+                return;
 
-    PyObject_Del((PyObject*)self);
+            self->spine = new_spine;
+            self->spine_capacity = new_capacity;
+        }
+    }
+
+    cell->spine_pos = self->spine_end;
+    self->spine[self->spine_end++] = cell;
 }
 
 
-static PyObject* sllist_new(PyTypeObject* type,
-                            PyObject* args,
-                            PyObject* kwds)
+/* Returns nonzero if cell is recorded in the spine. Slots of cells
+ * are not reset when the spine is emptied, so they are verified. */
+static int sllist_spine_contains(SLListObject* self, SLListCell* cell)
 {
-    SLListObject* self;
+    return cell->spine_pos >= self->spine_start &&
+           cell->spine_pos < self->spine_end &&
+           self->spine[cell->spine_pos] == cell;
+}
 
-    self = (SLListObject*)type->tp_alloc(type, 0);
-    if (self == NULL)
-        return NULL;
 
-    /* A single reference to Py_None is held for the whole
-     * lifetime of a list. */
-    Py_INCREF(Py_None);
+/* Returns the cell preceding the last one, or NULL if the list has
+ * less than two elements. The scan starts from the last cell recorded
+ * in the spine and records passed cells. */
+static SLListCell* sllist_get_prev_of_last(SLListObject* self)
+{
+    SLListCell* cell;
+    Py_ssize_t steps = 0;
 
-    self->first = Py_None;
-    self->last = Py_None;
-    self->weakref_list = NULL;
-    self->size = 0;
+    if (self->first == self->last)
+        return NULL;
 
-    return (PyObject*)self;
-}
+    while (self->spine_end > self->spine_start &&
+           (self->spine[self->spine_end - 1] == NULL ||
+            self->spine[self->spine_end - 1] == self->last))
+        --self->spine_end;
 
-static int sllist_extend_internal(SLListObject* self, PyObject* sequence)
-{
-    Py_ssize_t i;
-    Py_ssize_t sequence_len;
+    if (self->spine_end > self->spine_start)
+        cell = self->spine[self->spine_end - 1];
+    else
+        cell = self->first;
 
-    if (PyObject_TypeCheck(sequence, &SLListType))
+    while (cell->next != self->last)
     {
-        /* Special path for extending with a SLList.
-         * It's not strictly required but it will maintain
-         * the last accessed item. */
-        PyObject* iter_node_obj = ((SLListObject *)sequence)->first;
-        PyObject* last_node_obj = self->last;
+        cell = cell->next;
 
-        while (iter_node_obj != Py_None)
+        if (++steps == SLLIST_SPINE_STEP)
         {
-            SLListNodeObject* iter_node = (SLListNodeObject*)iter_node_obj;
-            PyObject* new_node;
+            sllist_spine_push(self, cell);
+            steps = 0;
+        }
+    }
 
-            new_node = (PyObject*)sllistnode_create(
-                Py_None, iter_node->value, (PyObject*)self);
+    return cell;
+}
 
-            if (self->last != Py_None)
-                ((SLListNodeObject*)self->last)->next = new_node;
 
-            if (self->first == Py_None)
-                self->first = new_node;
-            self->last = new_node;
+/* Convenience function for extracting values from arguments, which
+ * might be either plain objects or sllistnodes holding the value. */
+static PyObject* sllist_value_arg(PyObject* arg)
+{
+    if (PyObject_TypeCheck(arg, &SLListNodeType))
+        return ((SLListNodeObject*)arg)->cell->value;
 
-            if (iter_node_obj == last_node_obj)
-            {
-                /* This is needed to terminate loop if self == sequence. */
-                break;
-            }
+    return arg;
+}
 
-            iter_node_obj = iter_node->next;
-        }
 
-        self->size += ((SLListObject*)sequence)->size;
+/* Convenience function for retrieving a cell from a node argument.
+ * Verifies that the node belongs to the list. */
+static SLListCell* sllist_node_arg(SLListObject* self, PyObject* arg)
+{
+    SLListNodeObject* node;
 
-        return 1;
+    if (!PyObject_TypeCheck(arg, &SLListNodeType))
+    {
+        PyErr_SetString(PyExc_TypeError, "Argument is not an sllistnode");
+        return NULL;
     }
 
-    sequence_len = PySequence_Length(sequence);
-    if (sequence_len == -1)
+    node = (SLListNodeObject*)arg;
+
+    if (node->list == NULL)
     {
-        PyErr_SetString(PyExc_ValueError, "Invalid sequence");
-        return 0;
+        PyErr_SetString(PyExc_ValueError,
+            "sllistnode does not belong to a list");
+        return NULL;
     }
 
-    for (i = 0; i < sequence_len; ++i)
+    if (node->list != (PyObject*)self)
     {
-        PyObject* item;
-        PyObject* new_node;
-
-        item = PySequence_GetItem(sequence, i);
-        if (item == NULL)
-        {
-            PyErr_SetString(PyExc_ValueError,
-                            "Failed to get element from sequence");
-            return 0;
-        }
-
-        new_node = (PyObject*)sllistnode_create(Py_None,
-                                                item,
-                                                (PyObject*)self);
+        PyErr_SetString(PyExc_ValueError,
+            "sllistnode belongs to another list");
+        return NULL;
+    }
 
+    if (!sllist_check_node_list(node->list))
+        return NULL;
 
-        if(self->first == Py_None)
-            self->first = new_node;
-        else
-            ((SLListNodeObject*)self->last)->next = new_node;
+    return node->cell;
+}
 
-        self->last = new_node;
+/* Cells of a list being sorted are unlinked from it until sort()
+ * returns, while their nodes still refer to the list. Verifies that
+ * list, which owns a node passed by user, is not being sorted, so
+ * that the node may be used to modify it. */
+static int sllist_check_node_list(PyObject* list)
+{
+    if (((SLListObject*)list)->sorting)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "sllist modified during sort()");
+        return 0;
+    }
 
-        ++self->size;
+    return 1;
+}
 
-        Py_DECREF(item);
+/* Cells of a list sorted with a key function hold sort keys in place
+ * of values until sort() returns. Verifies that list, which owns
+ * a node passed by user, is not being sorted, so that the value of
+ * the node may be read. */
+static int sllist_check_node_value(PyObject* list)
+{
+    if (((SLListObject*)list)->sorting)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "sllistnode value is not available during sort()");
+        return 0;
     }
 
     return 1;
 }
 
 
-
-static int sllist_init(SLListObject* self, PyObject* args, PyObject* kwds)
+/* Convenience function for comparing value of a cell with value.
+ * Identical objects are matched without calling their comparison.
+ * Returns 1 if values are equal, 0 if they are not and -1 on error,
+ * including modification of the list by the comparison. */
+static int sllist_cell_matches(SLListObject* self,
+                               SLListCell* cell,
+                               PyObject* value,
+                               const char* method)
 {
-    PyObject* sequence = NULL;
+    PyObject* cell_value = cell->value;
+    Py_ssize_t state = self->state;
+    int result;
 
-    if (!PyArg_UnpackTuple(args, "__init__", 0, 1, &sequence))
-        return -1;
+    if (cell_value == value)
+        return 1;
 
-    if (sequence == NULL)
-        return 0;
+    Py_INCREF(cell_value);
+    result = PyObject_RichCompareBool(cell_value, value, Py_EQ);
+    Py_DECREF(cell_value);
 
-    /* initialize list using passed sequence */
-    if (!PySequence_Check(sequence))
+    if (result != -1 && state != self->state)
     {
-        PyErr_SetString(PyExc_TypeError, "Argument must be a sequence");
+        PyErr_Format(PyExc_RuntimeError,
+            "sllist modified during %s()", method);
         return -1;
     }
 
-    return sllist_extend_internal(self, sequence) ? 0 : -1;
+    return result;
 }
 
 
-static PyObject* sllist_richcompare(SLListObject* self,
-                                    SLListObject* other,
-                                    int op)
+/* Convenience function for linking cells into the list.
+ * The cell is inserted after prev, or at the beginning of the list
+ * if prev is NULL. */
+static void sllist_link_cell(SLListObject* self,
+                             SLListCell* cell,
+                             SLListCell* prev)
 {
-    SLListNodeObject* self_node;
-    SLListNodeObject* other_node;
-    int satisfied = 1;
-
-    if (!PyObject_TypeCheck(other, &SLListType))
+    /* Keep last accessed cell valid. Its index changes only if the new
+     * cell goes in front of it, which is known for sure when inserting
+     * at either end or right after the last accessed cell. */
+    if (self->last_accessed_cell != NULL &&
+        prev != self->last && prev != self->last_accessed_cell)
     {
-        Py_INCREF(Py_NotImplemented);
-        return Py_NotImplemented;
+        if (prev == NULL)
+            ++self->last_accessed_idx;
+        else
+        {
+            self->last_accessed_cell = NULL;
+            self->last_accessed_idx = -1;
+        }
     }
 
-    if (self == other &&
-        (op == Py_EQ || op == Py_LE || op == Py_GE))
-        Py_RETURN_TRUE;
-
-    if (self->size != other->size)
+    if (prev != NULL)
     {
-        if (op == Py_EQ)
-            Py_RETURN_FALSE;
-        else if (op == Py_NE)
-            Py_RETURN_TRUE;
+        cell->next = prev->next;
+        prev->next = cell;
+    }
+    else
+    {
+        cell->next = self->first;
+        self->first = cell;
     }
 
-    /* Scan through sequences' items as long as they are equal. */
-    self_node = (SLListNodeObject*)self->first;
-    other_node = (SLListNodeObject*)other->first;
+    if (self->last == prev)
+        self->last = cell;
 
-    while ((PyObject*)self_node != Py_None &&
-            (PyObject*)other_node != Py_None)
-    {
-        satisfied = PyObject_RichCompareBool(
-            self_node->value, other_node->value, Py_EQ);
+    ++self->size;
+    ++self->state;
+}
 
-        if (satisfied == 0)
-            break;
 
-        if (satisfied == -1)
-            return NULL;
+/* Convenience function for unlinking cells from the list.
+ * The preceding cell (or NULL for the first one) must be passed
+ * in prev. The cell itself is not released. */
+static void sllist_unlink_cell(SLListObject* self,
+                               SLListCell* cell,
+                               SLListCell* prev)
+{
+    /* keep last accessed cell valid, see sllist_link_cell() */
+    if (self->last_accessed_cell == cell)
+    {
+        if (prev != NULL)
+        {
+            self->last_accessed_cell = prev;
+            --self->last_accessed_idx;
+        }
+        else
+            self->last_accessed_cell = cell->next;
 
-        self_node = (SLListNodeObject*)self_node->next;
-        other_node = (SLListNodeObject*)other_node->next;
+        if (self->last_accessed_cell == NULL)
+            self->last_accessed_idx = -1;
+    }
+    else if (self->last_accessed_cell != NULL &&
+             cell != self->last && prev != self->last_accessed_cell)
+    {
+        if (prev == NULL)
+            --self->last_accessed_idx;
+        else
+        {
+            self->last_accessed_cell = NULL;
+            self->last_accessed_idx = -1;
+        }
     }
 
-    /* Compare last item */
-    if (satisfied)
+    /* Keep spine a subset of list cells. The slot of the cell is taken
+     * over by its predecessor, unless the predecessor is recorded
+     * already. */
+    if (sllist_spine_contains(self, cell))
     {
-        /* At least one of operands has been fully traversed.
-         * Either self_node or other_node is equal to Py_None. */
-        switch (op)
+        Py_ssize_t pos = cell->spine_pos;
+
+        if (prev != NULL && !sllist_spine_contains(self, prev))
         {
-        case Py_EQ:
-            satisfied = (self_node == other_node);
-            break;
-        case Py_NE:
-            satisfied = (self_node != other_node);
+            self->spine[pos] = prev;
+            prev->spine_pos = pos;
+        }
+        else if (pos == self->spine_start)
+            ++self->spine_start;
+        else if (pos == self->spine_end - 1)
+            --self->spine_end;
+        else
+            self->spine[pos] = NULL;
+
+        cell->spine_pos = -1;
+    }
+
+    if (prev != NULL)
+        prev->next = cell->next;
+    else
+        self->first = cell->next;
+
+    if (self->last == cell)
+        self->last = prev;
+
+    cell->next = NULL;
+
+    --self->size;
+    ++self->state;
+}
+
+
+/* Convenience function for inserting values after prev (or at
+ * the beginning of the list if prev is NULL). Returns the node
+ * of the new element as a new reference. */
+static PyObject* sllist_insert_value(SLListObject* self,
+                                     PyObject* value,
+                                     SLListCell* prev)
+{
+    SLListCell* cell;
+    PyObject* node;
+
+    cell = sllistcell_new(value);
+    if (cell == NULL)
+        return NULL;
+
+    node = sllistnode_from_cell((PyObject*)self, cell);
+    if (node == NULL)
+    {
+        sllistcell_free(cell);
+        return NULL;
+    }
+
+    sllist_link_cell(self, cell, prev);
+
+    return node;
+}
+
+
+/* Convenience function for inserting values before next in O(1) time.
+ * A new cell is linked after next and takes over its contents (value
+ * and node), while the inserted value is stored in next. Returns
+ * the node of the new element as a new reference. */
+static PyObject* sllist_insert_value_before(SLListObject* self,
+                                            PyObject* value,
+                                            SLListCell* next)
+{
+    SLListCell* cell;
+    SLListNodeObject* node;
+
+    if (next == self->first)
+        return sllist_insert_value(self, value, NULL);
+
+    cell = sllistcell_new(next->value);
+    if (cell == NULL)
+        return NULL;
+
+    node = sllistnode_alloc(&SLListNodeType);
+    if (node == NULL)
+    {
+        sllistcell_free(cell);
+        return NULL;
+    }
+
+    cell->node = next->node;
+    if (cell->node != NULL)
+        cell->node->cell = cell;
+
+    /* the new cell holds a reference to the old value */
+    Py_INCREF(value);
+    Py_DECREF(next->value);
+    next->value = value;
+
+    node->cell = next;
+    node->list = (PyObject*)self;
+    next->node = node;
+
+    sllist_link_cell(self, cell, next);
+
+    return (PyObject*)node;
+}
+
+
+static void sllist_dealloc(SLListObject* self)
+{
+    SLListCell* cell = self->first;
+
+    if (self->weakref_list != NULL)
+        PyObject_ClearWeakRefs((PyObject*)self);
+
+    while (cell != NULL)
+    {
+        SLListCell* next_cell = cell->next;
+        sllistcell_delete(cell);
+        cell = next_cell;
+    }
+
+    PyMem_Free(self->spine);
+
+    PyObject_Del((PyObject*)self);
+}
+
+
+static PyObject* sllist_new(PyTypeObject* type,
+                            PyObject* args,
+                            PyObject* kwds)
+{
+    SLListObject* self;
+
+    self = (SLListObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->first = NULL;
+    self->last = NULL;
+    self->last_accessed_cell = NULL;
+    self->last_accessed_idx = -1;
+    self->spine = NULL;
+    self->spine_start = 0;
+    self->spine_end = 0;
+    self->spine_capacity = 0;
+    self->sorting = 0;
+    self->weakref_list = NULL;
+    self->size = 0;
+    self->state = 0;
+
+    return (PyObject*)self;
+}
+
+/* Convenience function for adding a new cell to an unlinked chain
+ * of cells, either at its end or at its beginning if left is nonzero. */
+static int sllist_chain_add(SLListCell** first,
+                            SLListCell** last,
+                            PyObject* value,
+                            int left)
+{
+    SLListCell* cell = sllistcell_new(value);
+    if (cell == NULL)
+        return 0;
+
+    if (left)
+    {
+        cell->next = *first;
+        if (*first == NULL)
+            *last = cell;
+        *first = cell;
+    }
+    else
+    {
+        if (*last != NULL)
+            (*last)->next = cell;
+        else
+            *first = cell;
+        *last = cell;
+    }
+
+    return 1;
+}
+
+
+/* Convenience function for extending the list with elements
+ * from an iterable. Elements are inserted at the end of the list,
+ * or at the beginning (in reversed order) if left is nonzero.
+ *
+ * New cells are collected in a chain, which is linked into the list
+ * at once, so that the list does not change while it is extended with
+ * itself. Lists and tuples are read directly, other iterables are
+ * consumed through the iterator protocol without building a temporary
+ * sequence. As in list.extend(), elements collected before an error
+ * are still added. */
+static int sllist_extend_internal(SLListObject* self,
+                                  PyObject* iterable,
+                                  int left)
+{
+    SLListCell* first = NULL;
+    SLListCell* last = NULL;
+    Py_ssize_t count = 0;
+    int ok = 1;
+
+    if (PyObject_TypeCheck(iterable, &SLListType))
+    {
+        SLListCell* iter_cell = ((SLListObject*)iterable)->first;
+
+        for (; iter_cell != NULL; iter_cell = iter_cell->next, ++count)
+        {
+            if (!sllist_chain_add(&first, &last, iter_cell->value, left))
+            {
+                ok = 0;
+                break;
+            }
+        }
+    }
+    else if (PyList_Check(iterable) || PyTuple_Check(iterable))
+    {
+        PyObject** items = PySequence_Fast_ITEMS(iterable);
+        Py_ssize_t len = PySequence_Fast_GET_SIZE(iterable);
+
+        for (; count < len; ++count)
+        {
+            if (!sllist_chain_add(&first, &last, items[count], left))
+            {
+                ok = 0;
+                break;
+            }
+        }
+    }
+    else
+    {
+        PyObject* iterator;
+        PyObject* item;
+
+        iterator = PyObject_GetIter(iterable);
+        if (iterator == NULL)
+            return 0;
+
+        while ((item = PyIter_Next(iterator)) != NULL)
+        {
+            ok = sllist_chain_add(&first, &last, item, left);
+            Py_DECREF(item);
+            if (!ok)
+                break;
+            ++count;
+        }
+
+        Py_DECREF(iterator);
+
+        if (PyErr_Occurred())
+            ok = 0;
+    }
+
+    if (count == 0)
+        return ok;
+
+    if (left)
+    {
+        last->next = self->first;
+        self->first = first;
+        if (self->last == NULL)
+            self->last = last;
+
+        if (self->last_accessed_cell != NULL)
+            self->last_accessed_idx += count;
+    }
+    else
+    {
+        if (self->last != NULL)
+            self->last->next = first;
+        else
+            self->first = first;
+        self->last = last;
+    }
+
+    self->size += count;
+    ++self->state;
+
+    return ok;
+}
+
+
+
+static int sllist_init(SLListObject* self, PyObject* args, PyObject* kwds)
+{
+    PyObject* sequence = NULL;
+
+    if (!PyArg_UnpackTuple(args, "__init__", 0, 1, &sequence))
+        return -1;
+
+    if (sequence == NULL)
+        return 0;
+
+    /* initialize list using passed iterable */
+    return sllist_extend_internal(self, sequence, 0) ? 0 : -1;
+}
+
+#ifdef Py23_HAVE_VECTORCALL
+/* Fast path for constructing lists from positional arguments.
+ * Keyword arguments are handled by sllist_init(). */
+static PyObject* sllist_vectorcall(PyObject* type,
+                                 PyObject* const* args,
+                                 size_t nargsf,
+                                 PyObject* kwnames)
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    PyObject* self;
+
+    if (kwnames != NULL || nargs > 1)
+        return Py23Type_VectorcallFallback(type, args, nargsf, kwnames);
+
+    self = sllist_new((PyTypeObject*)type, NULL, NULL);
+    if (self == NULL)
+        return NULL;
+
+    if (nargs == 1 &&
+        !sllist_extend_internal((SLListObject*)self, args[0], 0))
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+#endif
+
+
+static PyObject* sllist_richcompare(SLListObject* self,
+                                    SLListObject* other,
+                                    int op)
+{
+    SLListCell* self_cell;
+    SLListCell* other_cell;
+    int satisfied = 1;
+
+    if (!PyObject_TypeCheck(other, &SLListType))
+    {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (self == other &&
+        (op == Py_EQ || op == Py_LE || op == Py_GE))
+        Py_RETURN_TRUE;
+
+    if (self->size != other->size)
+    {
+        if (op == Py_EQ)
+            Py_RETURN_FALSE;
+        else if (op == Py_NE)
+            Py_RETURN_TRUE;
+    }
+
+    /* Scan through sequences' items as long as they are equal. */
+    self_cell = self->first;
+    other_cell = other->first;
+
+    while (self_cell != NULL && other_cell != NULL)
+    {
+        satisfied = PyObject_RichCompareBool(
+            self_cell->value, other_cell->value, Py_EQ);
+
+        if (satisfied == 0)
+            break;
+
+        if (satisfied == -1)
+            return NULL;
+
+        self_cell = self_cell->next;
+        other_cell = other_cell->next;
+    }
+
+    /* Compare last item */
+    if (satisfied)
+    {
+        /* At least one of operands has been fully traversed.
+         * Either self_cell or other_cell is equal to NULL. */
+        switch (op)
+        {
+        case Py_EQ:
+            satisfied = (self_cell == other_cell);
+            break;
+        case Py_NE:
+            satisfied = (self_cell != other_cell);
             break;
         case Py_LT:
-            satisfied = ((PyObject*)other_node != Py_None);
+            satisfied = (other_cell != NULL);
             break;
         case Py_GT:
-            satisfied = ((PyObject*)self_node != Py_None);
+            satisfied = (self_cell != NULL);
             break;
         case Py_LE:
-            satisfied = ((PyObject*)self_node == Py_None);
+            satisfied = (self_cell == NULL);
             break;
         case Py_GE:
-            satisfied = ((PyObject*)other_node == Py_None);
+            satisfied = (other_cell == NULL);
             break;
         default:
             assert(0 && "Invalid rich compare operator");
@@ -498,7 +1161,7 @@ static PyObject* sllist_richcompare(SLListObject* self,
     {
         /* Both nodes are valid, but not equal */
         satisfied = PyObject_RichCompareBool(
-            self_node->value, other_node->value, op);
+            self_cell->value, other_cell->value, op);
     }
 
     if (satisfied)
@@ -509,462 +1172,999 @@ static PyObject* sllist_richcompare(SLListObject* self,
 
 
 
-static SLListNodeObject* sllist_get_prev(SLListObject* self,
-                                         SLListNodeObject* next)
+static PyObject* sllist_get_first(SLListObject* self, void* closure)
+{
+    return sllistnode_from_cell((PyObject*)self, self->first);
+}
+
+
+static PyObject* sllist_get_last(SLListObject* self, void* closure)
+{
+    return sllistnode_from_cell((PyObject*)self, self->last);
+}
+
+
+static PyObject* sllist_appendleft(SLListObject* self, PyObject* arg)
+{
+    /* setting head as new node */
+    return sllist_insert_value(self, sllist_value_arg(arg), NULL);
+}
+
+static PyObject* sllist_appendright(SLListObject* self, PyObject* arg)
+{
+    /* setting next of last element as new node */
+    return sllist_insert_value(self, sllist_value_arg(arg), self->last);
+}
+
+static PyObject* sllist_insertafter(SLListObject* self, Py23_FASTCALL_PARAMS)
+{
+
+    PyObject* value = NULL;
+    PyObject* before = NULL;
+    SLListCell* before_cell;
+
+    if (!Py23Args_Unpack("insertafter", Py23_FASTCALL_ARGS,
+                         2, 2, &value, &before))
+        return NULL;
+
+    before_cell = sllist_node_arg(self, before);
+    if (before_cell == NULL)
+        return NULL;
+
+    /* putting new node in created gap */
+    return sllist_insert_value(self, sllist_value_arg(value), before_cell);
+}
+
+static PyObject* sllist_insertbefore(SLListObject* self, Py23_FASTCALL_PARAMS)
+{
+
+    PyObject* value = NULL;
+    PyObject* after = NULL;
+    SLListCell* after_cell;
+
+    if (!Py23Args_Unpack("insertbefore", Py23_FASTCALL_ARGS,
+                         2, 2, &value, &after))
+        return NULL;
+
+    after_cell = sllist_node_arg(self, after);
+    if (after_cell == NULL)
+        return NULL;
+
+    return sllist_insert_value_before(self,
+                                      sllist_value_arg(value),
+                                      after_cell);
+}
+
+
+static PyObject* sllist_extendleft(SLListObject* self, PyObject* arg)
+{
+    if (!sllist_extend_internal(self, arg, 1))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+static PyObject* sllist_extendright(SLListObject* self, PyObject* arg)
+{
+    if (!sllist_extend_internal(self, arg, 0))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+/* Convenience function for locating list cells using index.
+ * The list can only be scanned forward, so that the scan starts
+ * from the last accessed cell if it is not past the index. */
+static SLListCell* sllist_get_cell_internal(SLListObject* self,
+                                            Py_ssize_t pos)
+{
+    SLListCell* cell;
+    Py_ssize_t counter;
+
+    if (pos < 0 || pos >= self->size)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        return NULL;
+    }
+
+    if (pos == self->size - 1)
+        return self->last;
+
+    if (self->last_accessed_cell != NULL && self->last_accessed_idx <= pos)
+    {
+        cell = self->last_accessed_cell;
+        counter = self->last_accessed_idx;
+    }
+    else
+    {
+        /* taking head */
+        cell = self->first;
+        counter = 0;
+    }
+
+    assert(cell != NULL);
+
+    /* iterate to given index */
+    for (; counter < pos; ++counter)
+        cell = cell->next;
+
+    /* update last accessed cell */
+    self->last_accessed_cell = cell;
+    self->last_accessed_idx = pos;
+
+    return cell;
+}
+
+
+static PyObject* sllist_node_at(PyObject* self, PyObject* indexObject)
+{
+    SLListCell* cell;
+    Py_ssize_t index;
+
+    if (!Py23Int_Check(indexObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
+        return NULL;
+    }
+
+    index = Py23Int_AsSsize_t(indexObject);
+
+    if (index < 0)
+        index = ((SLListObject*)self)->size + index;
+
+    cell = sllist_get_cell_internal((SLListObject*)self, index);
+    if (cell == NULL)
+        return NULL;
+
+    return sllistnode_from_cell(self, cell);
+}
+
+
+/* Convenience function for removing cells from the list.
+ * Returns the value stored in the cell as a new reference. */
+static PyObject* sllist_remove_cell(SLListObject* self,
+                                    SLListCell* del_cell,
+                                    SLListCell* prev)
+{
+    PyObject* value;
+
+    sllist_unlink_cell(self, del_cell, prev);
+
+    value = del_cell->value;
+    Py_INCREF(value);
+
+    sllistcell_delete(del_cell);
+
+    return value;
+}
+
+
+/* Convenience function for exchanging contents (values and nodes)
+ * of two cells. */
+static void sllist_swap_contents(SLListCell* a, SLListCell* b)
+{
+    PyObject* value;
+    SLListNodeObject* node;
+
+    value = a->value;
+    a->value = b->value;
+    b->value = value;
+
+    node = a->node;
+    a->node = b->node;
+    b->node = node;
+
+    if (a->node != NULL)
+        a->node->cell = a;
+    if (b->node != NULL)
+        b->node->cell = b;
+}
+
+
+/* Convenience function for removing cells from the list in O(1) time.
+ * A cell in the middle of the list takes over contents (value and node)
+ * of its successor, which is removed instead. Returns the value stored
+ * in the cell as a new reference. */
+static PyObject* sllist_remove_cell_fast(SLListObject* self,
+                                         SLListCell* del_cell)
 {
-    SLListNodeObject* prev = NULL;
+    SLListCell* next = del_cell->next;
 
-    SLListNodeObject* node = (SLListNodeObject*)self->first;
+    if (del_cell == self->first)
+        return sllist_remove_cell(self, del_cell, NULL);
+
+    if (next == NULL)
+        return sllist_remove_cell(self, del_cell,
+                                  sllist_get_prev_of_last(self));
+
+    sllist_swap_contents(del_cell, next);
+
+    return sllist_remove_cell(self, next, del_cell);
+}
+
+
+static PyObject* sllist_remove(SLListObject* self, PyObject* arg)
+{
+    SLListCell* del_cell;
 
-    if (!PyObject_TypeCheck(next, &SLListNodeType))
+    if (!PyObject_TypeCheck(arg, &SLListNodeType))
     {
         PyErr_SetString(PyExc_TypeError, "Argument is not an sllistnode");
         return NULL;
     }
 
-    if (self->first == Py_None)
+    /* nodes of a list being sorted are rejected by node argument check */
+    if (self->first == NULL && !self->sorting)
     {
-        PyErr_SetString(PyExc_RuntimeError, "List is empty");
+        PyErr_SetString(PyExc_ValueError, "List is empty");
         return NULL;
     }
 
+    del_cell = sllist_node_arg(self, arg);
+    if (del_cell == NULL)
+        return NULL;
+
+    return sllist_remove_cell_fast(self, del_cell);
+}
+
 
-    /* TODO: Think this over once more */
-    if (self->first == (PyObject*)next)
+/* Convenience function for releasing an unlinked chain of cells,
+ * such as one returned by sllist_unlink_slice(). */
+static void sllist_free_cells(SLListCell* cell)
+{
+    while (cell != NULL)
     {
-        return NULL;
+        SLListCell* next = cell->next;
+
+        sllistcell_free(cell);
+        cell = next;
     }
+}
+
+
+static PyObject* sllist_remove_if(SLListObject* self, PyObject* predicate)
+{
+    SLListCell* prev = NULL;
+    SLListCell* cell = self->first;
+    SLListCell* removed = NULL;
+    Py_ssize_t count = 0;
 
-    if(self->first != Py_None)
+    while (cell != NULL)
     {
-        while((PyObject*)node != Py_None && node != next)
+        SLListCell* next;
+        PyObject* value = cell->value;
+        PyObject* result;
+        Py_ssize_t state = self->state;
+        int match;
+
+        Py_INCREF(value);
+        result = PyObject_CallFunctionObjArgs(predicate, value, NULL);
+        Py_DECREF(value);
+        if (result == NULL)
+            break;
+
+        match = PyObject_IsTrue(result);
+        Py_DECREF(result);
+        if (match == -1)
+            break;
+
+        if (state != self->state)
+        {
+            PyErr_SetString(PyExc_RuntimeError,
+                "sllist modified during remove_if()");
+            break;
+        }
+
+        next = cell->next;
+
+        if (match)
         {
-            prev = node;
-            node = (SLListNodeObject*)node->next;
+            sllist_unlink_cell(self, cell, prev);
+
+            /* values are released once the traversal is finished */
+            if (cell->node != NULL)
+                sllistcell_delete(cell);
+            else
+            {
+                cell->next = removed;
+                removed = cell;
+            }
+
+            ++count;
         }
-        return (SLListNodeObject*)prev;
+        else
+            prev = cell;
+
+        cell = next;
     }
-    return NULL;
 
+    sllist_free_cells(removed);
+
+    if (cell != NULL)
+        return NULL;
+
+    return Py23Int_FromSsize_t(count);
 }
 
 
-static PyObject* sllist_appendleft(SLListObject* self, PyObject* arg)
+static PyObject* sllist_remove_nodes(SLListObject* self, PyObject* iterable)
 {
-    SLListNodeObject* new_node;
+    PyObject* sequence;
+    PyObject** items;
+    Py_ssize_t len;
+    Py_ssize_t marked = 0;
+    Py_ssize_t count = 0;
+    Py_ssize_t i;
+    SLListCell* prev = NULL;
+    SLListCell* cell;
 
-    if (PyObject_TypeCheck(arg, &SLListNodeType))
-        arg = ((SLListNodeObject*)arg)->value;
+    sequence = PySequence_Fast(iterable, "Argument must be iterable");
+    if (sequence == NULL)
+        return NULL;
 
-    new_node = sllistnode_create(self->first,
-                                 arg,
-                                 (PyObject*)self);
-    /* setting head as new node */
-    self->first  = (PyObject*)new_node;
+    items = PySequence_Fast_ITEMS(sequence);
+    len = PySequence_Fast_GET_SIZE(sequence);
 
-    /* setting tail as new node (appending to empty list)*/
-    if(self->last == Py_None)
-        self->last = (PyObject*)new_node;
+    /* verify all nodes before removing any of them */
+    for (i = 0; i < len; ++i)
+    {
+        if (sllist_node_arg(self, items[i]) == NULL)
+        {
+            Py_DECREF(sequence);
+            return NULL;
+        }
+    }
 
-    ++self->size;
+    /* Cells to be removed are marked by detaching their nodes, which
+     * never happens to nodes of linked cells otherwise. Then all marked
+     * cells are removed in a single traversal. */
+    for (i = 0; i < len; ++i)
+    {
+        SLListNodeObject* node = (SLListNodeObject*)items[i];
 
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
-}
+        if (node->list != NULL)
+        {
+            node->list = NULL;
+            ++marked;
+        }
+    }
 
-static PyObject* sllist_appendright(SLListObject* self, PyObject* arg)
-{
-    SLListNodeObject* new_node;
+    cell = self->first;
 
-    if (PyObject_TypeCheck(arg, &SLListNodeType))
-        arg = ((SLListNodeObject*)arg)->value;
+    while (count < marked)
+    {
+        SLListCell* next = cell->next;
 
-    new_node = sllistnode_create(Py_None,
-                                 arg,
-                                 (PyObject*)self);
+        if (cell->node != NULL && cell->node->list == NULL)
+        {
+            sllist_unlink_cell(self, cell, prev);
+            ++count;
+        }
+        else
+            prev = cell;
 
-    /* appending to empty list */
-    if(self->first == Py_None)
-        self->first = (PyObject*)new_node;
-    /* setting next of last element as new node */
-    else
-        ((SLListNodeObject*)self->last)->next = (PyObject*)new_node;
+        cell = next;
+    }
 
-    /* allways set last node to new node */
-    self->last = (PyObject*)new_node;
+    Py_DECREF(sequence);
 
-    ++self->size;
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
+    return Py23Int_FromSsize_t(count);
 }
 
-static PyObject* sllist_insertafter(SLListObject* self, PyObject* arg)
+
+static PyObject* sllist_find(SLListObject* self, PyObject* value)
 {
+    SLListCell* cell;
 
-    PyObject* value = NULL;
-    PyObject* before = NULL;
-    PyObject* list_ref;
-    SLListNodeObject* new_node;
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        int match = sllist_cell_matches(self, cell, value, "find");
+        if (match == -1)
+            return NULL;
+
+        if (match)
+            return sllistnode_from_cell((PyObject*)self, cell);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* sllist_index(SLListObject* self, PyObject* args)
+{
+    PyObject* value;
+    SLListCell* cell;
+    Py_ssize_t start = 0;
+    Py_ssize_t stop = PY_SSIZE_T_MAX;
+    Py_ssize_t pos;
 
-    if (!PyArg_UnpackTuple(arg, "insertafter", 2, 2, &value, &before))
+    if (!PyArg_ParseTuple(args, "O|nn:index", &value, &start, &stop))
         return NULL;
 
-    if (!PyObject_TypeCheck(before, &SLListNodeType))
+    if (start < 0)
     {
-        PyErr_SetString(PyExc_TypeError, "Argument is not an sllistnode");
-        return NULL;
+        start += self->size;
+        if (start < 0)
+            start = 0;
     }
 
-    if (PyObject_TypeCheck(value, &SLListNodeType))
-        value = ((SLListNodeObject*)value)->value;
+    if (stop < 0)
+        stop += self->size;
 
-    if (((SLListNodeObject*)before)->list_weakref == Py_None)
+    if (stop > self->size)
+        stop = self->size;
+
+    if (start < stop)
     {
-        PyErr_SetString(PyExc_ValueError,
-            "sllistnode does not belong to a list");
-        return NULL;
+        cell = sllist_get_cell_internal(self, start);
+        assert(cell != NULL);
+
+        for (pos = start; pos < stop && cell != NULL; ++pos)
+        {
+            int match = sllist_cell_matches(self, cell, value, "index");
+            if (match == -1)
+                return NULL;
+
+            if (match)
+                return Py23Int_FromSsize_t(pos);
+
+            cell = cell->next;
+        }
     }
 
-    list_ref = PyWeakref_GetObject(
-        ((SLListNodeObject*)before)->list_weakref);
-    if (list_ref != (PyObject*)self)
+    PyErr_SetString(PyExc_ValueError, "Value not found");
+    return NULL;
+}
+
+static PyObject* sllist_count(SLListObject* self, PyObject* value)
+{
+    SLListCell* cell;
+    Py_ssize_t count = 0;
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
     {
-        PyErr_SetString(PyExc_ValueError,
-            "sllistnode belongs to another list");
-        return NULL;
+        int match = sllist_cell_matches(self, cell, value, "count");
+        if (match == -1)
+            return NULL;
+
+        count += match;
     }
 
-    new_node = sllistnode_create(Py_None,
-                                 value,
-                                 (PyObject*)self);
+    return Py23Int_FromSsize_t(count);
+}
 
-    /* putting new node in created gap */
-    new_node->next = ((SLListNodeObject*)before)->next;
-    ((SLListNodeObject*)before)->next = (PyObject*)new_node;
+/* Convenience function for raising RuntimeError if the list has been
+ * modified by code run while its elements were reduced. */
+static int sllist_check_reduce_state(SLListObject* self,
+                                     Py_ssize_t state,
+                                     const char* method)
+{
+    if (state == self->state)
+        return 1;
 
-    if (self->last == before)
-        self->last = (PyObject*)new_node;
+    PyErr_Format(PyExc_RuntimeError,
+        "sllist modified during %s()", method);
+    return 0;
+}
 
-    ++self->size;
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
+/* Convenience function for summing elements. The method name
+ * is used in error messages. */
+static PyObject* sllist_sum_internal(SLListObject* self, const char* method)
+{
+    SLListCell* cell;
+    Py_ssize_t state = self->state;
+    LListSum sum;
+
+    llist_sum_init(&sum);
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
+    {
+        if (!llist_sum_add(&sum, cell->value) ||
+            !sllist_check_reduce_state(self, state, method))
+        {
+            llist_sum_clear(&sum);
+            return NULL;
+        }
+    }
+
+    return llist_sum_result(&sum);
 }
 
-static PyObject* sllist_insertbefore(SLListObject* self, PyObject* arg)
+static PyObject* sllist_sum(SLListObject* self)
 {
+    return sllist_sum_internal(self, "sum");
+}
 
-    PyObject* value = NULL;
-    PyObject* after = NULL;
-    PyObject* list_ref;
+static PyObject* sllist_mean(SLListObject* self)
+{
+    Py_ssize_t count = self->size;
 
-    SLListNodeObject* new_node;
-    SLListNodeObject* prev;
+    return llist_mean(sllist_sum_internal(self, "mean"), count);
+}
 
-    if (!PyArg_UnpackTuple(arg, "insertbefore", 2, 2, &value, &after))
-        return NULL;
+/* Convenience function for finding the smallest (op == Py_LT)
+ * or the largest (op == Py_GT) element. */
+static PyObject* sllist_extremum(SLListObject* self,
+                                 int op,
+                                 const char* method)
+{
+    SLListCell* cell;
+    Py_ssize_t state = self->state;
+    LListExtremum ext;
 
-    if (!PyObject_TypeCheck(after, &SLListNodeType))
+    llist_extremum_init(&ext, op);
+
+    for (cell = self->first; cell != NULL; cell = cell->next)
     {
-        PyErr_SetString(PyExc_TypeError, "Argument is not an sllistnode");
+        if (!llist_extremum_update(&ext, cell->value) ||
+            !sllist_check_reduce_state(self, state, method))
+        {
+            llist_extremum_clear(&ext);
+            return NULL;
+        }
+    }
+
+    return llist_extremum_result(&ext);
+}
+
+static PyObject* sllist_min(SLListObject* self)
+{
+    return sllist_extremum(self, Py_LT, "min");
+}
+
+static PyObject* sllist_max(SLListObject* self)
+{
+    return sllist_extremum(self, Py_GT, "max");
+}
+
+static PyObject* sllist_rotate(SLListObject* self, PyObject* nObject)
+{
+    Py_ssize_t n;
+    Py_ssize_t split_idx;
+    Py_ssize_t n_mod;
+    SLListCell* new_first;
+    SLListCell* new_last;
+
+    if (self->size <= 1)
+        Py_RETURN_NONE;
+
+    if (!Py23Int_Check(nObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "n must be an integer");
         return NULL;
     }
-    if (PyObject_TypeCheck(value, &SLListNodeType))
-        value = ((SLListNodeObject*)value)->value;
 
-    if (after == Py_None)
+    n = Py23Int_AsSsize_t(nObject);
+    n_mod = (n >= 0 ? n : -n) % self->size;
+
+    if (n_mod == 0)
+        Py_RETURN_NONE; /* no-op */
+
+    if (n > 0)
+        split_idx = self->size - n_mod; /* rotate right */
+    else
+        split_idx = n_mod;  /* rotate left */
+
+    new_last = sllist_get_cell_internal(self, split_idx - 1);
+    assert(new_last != NULL);
+    new_first = new_last->next;
+
+    self->last->next = self->first;
+
+    new_last->next = NULL;
+
+    self->first = new_first;
+    self->last = new_last;
+    ++self->state;
+
+    if (self->last_accessed_cell != NULL)
+    {
+        self->last_accessed_idx =
+            (self->last_accessed_idx + self->size - split_idx) % self->size;
+    }
+
+    /* cells in the spine are no longer in list order */
+    self->spine_start = 0;
+    self->spine_end = 0;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* sllist_splice(SLListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* other_arg = NULL;
+    PyObject* before_arg = NULL;
+    SLListObject* other;
+    SLListCell* next = NULL;
+    SLListCell* first;
+    SLListCell* last;
+    SLListCell* cell;
+    Py_ssize_t count;
+
+    if (!Py23Args_Unpack("splice", Py23_FASTCALL_ARGS,
+                         1, 2, &other_arg, &before_arg))
+        return NULL;
+
+    if (!PyObject_TypeCheck(other_arg, &SLListType))
     {
-        PyErr_SetString(PyExc_ValueError,
-            "sllistnode does not belong to a list");
+        PyErr_SetString(PyExc_TypeError, "other argument must be an sllist");
         return NULL;
     }
 
-    list_ref = PyWeakref_GetObject(
-        ((SLListNodeObject*)after)->list_weakref);
-    if (list_ref != (PyObject*)self)
+    other = (SLListObject*)other_arg;
+
+    if (other == self)
     {
         PyErr_SetString(PyExc_ValueError,
-            "sllistnode belongs to another list");
+            "Cannot splice a list into itself");
         return NULL;
     }
-    new_node = sllistnode_create(Py_None,
-                                 value,
-                                 (PyObject*)self);
-
-    /* getting prev node for this from arg*/
-    prev = sllist_get_prev(self, (SLListNodeObject*)after);
 
-    /* putting new node in created gap, not first and exists */
-    if((PyObject*)prev != Py_None && prev != NULL)
+    if (before_arg != NULL && before_arg != Py_None)
     {
-        ((SLListNodeObject*)prev)->next = (PyObject*)new_node;
-        new_node->next = after;
+        next = sllist_node_arg(self, before_arg);
+        if (next == NULL)
+            return NULL;
     }
-    else
+
+    if (other->first == NULL)
+        Py_RETURN_NONE;
+
+    /* take all cells from the other list */
+    first = other->first;
+    last = other->last;
+    count = other->size;
+
+    other->first = NULL;
+    other->last = NULL;
+    other->size = 0;
+    ++other->state;
+    other->last_accessed_cell = NULL;
+    other->last_accessed_idx = -1;
+    other->spine_start = 0;
+    other->spine_end = 0;
+
+    for (cell = first; cell != NULL; cell = cell->next)
     {
-        new_node->next = after;
-        self->first = (PyObject*)new_node;
+        if (cell->node != NULL)
+            cell->node->list = (PyObject*)self;
     }
-    /* new_node->next = ((SLListNodeObject*)after)->next; */
-    /* ((SLListNodeObject*)before)->next = (PyObject*)new_node; */
-    ++self->size;
-    Py_INCREF((PyObject*)new_node);
-    return (PyObject*)new_node;
-}
 
+    if (next == NULL)
+    {
+        /* append at the end of the list */
+        if (self->last != NULL)
+            self->last->next = first;
+        else
+            self->first = first;
 
-static PyObject* sllist_extendleft(SLListObject* self, PyObject* sequence)
-{
-    Py_ssize_t i;
-    Py_ssize_t sequence_len;
+        self->last = last;
+    }
+    else if (next == self->first)
+    {
+        last->next = next;
+        self->first = first;
 
-    if (PyObject_TypeCheck(sequence, &SLListType))
+        if (self->last_accessed_cell != NULL)
+            self->last_accessed_idx += count;
+    }
+    else
     {
-        /* Special path for extending with a SLList.
-         * It's not strictly required but it will maintain
-         * the last accessed item. */
-        PyObject* iter_node_obj = ((SLListObject*)sequence)->first;
-        PyObject* last_node_obj = ((SLListObject*)sequence)->last;
+        /* The predecessor of next is unknown, so that next takes over
+         * contents of the first inserted cell and the first cell is
+         * moved behind the inserted range with contents of next. */
+        SLListCell* second = first->next;
+
+        sllist_swap_contents(next, first);
 
-        while (iter_node_obj != Py_None)
+        first->next = next->next;
+        if (second != NULL)
         {
-            SLListNodeObject* iter_node = (SLListNodeObject*)iter_node_obj;
-            PyObject* new_node;
+            next->next = second;
+            last->next = first;
+        }
+        else
+            next->next = first;
 
-            new_node = (PyObject*)sllistnode_create(
-                self->first, iter_node->value, (PyObject*)self);
+        if (self->last == next)
+            self->last = first;
 
-            self->first = new_node;
-            if (self->last == Py_None)
-                self->last = new_node;
+        /* indices of cells after next have changed */
+        self->last_accessed_cell = NULL;
+        self->last_accessed_idx = -1;
+    }
 
-            if (iter_node_obj == last_node_obj)
-            {
-                /* This is needed to terminate loop if self == sequence. */
-                break;
-            }
+    self->size += count;
+    ++self->state;
 
-            iter_node_obj = iter_node->next;
-        }
+    Py_RETURN_NONE;
+}
 
-        self->size += ((SLListObject*)sequence)->size;
+static PyObject* sllist_split_after(SLListObject* self, PyObject* arg)
+{
+    SLListObject* new_list;
+    SLListCell* prev;
+    SLListCell* cell;
+    Py_ssize_t count = 0;
 
-        Py_RETURN_NONE;
-    }
+    prev = sllist_node_arg(self, arg);
+    if (prev == NULL)
+        return NULL;
 
-    sequence_len = PySequence_Length(sequence);
-    if (sequence_len == -1)
-    {
-        PyErr_SetString(PyExc_ValueError, "Invalid sequence");
+    new_list = (SLListObject*)sllist_new(&SLListType, NULL, NULL);
+    if (new_list == NULL)
         return NULL;
-    }
 
-    for (i = 0; i < sequence_len; ++i)
+    if (prev->next == NULL)
+        return (PyObject*)new_list;
+
+    for (cell = prev->next; cell != NULL; cell = cell->next)
     {
-        PyObject* item;
-        PyObject* new_node;
+        if (cell->node != NULL)
+            cell->node->list = (PyObject*)new_list;
 
-        item = PySequence_GetItem(sequence, i);
-        if (item == NULL)
+        if (cell == self->last_accessed_cell)
         {
-            PyErr_SetString(PyExc_ValueError,
-                            "Failed to get element from sequence");
-            return NULL;
+            self->last_accessed_cell = NULL;
+            self->last_accessed_idx = -1;
         }
 
-        new_node = (PyObject*)sllistnode_create(self->first,
-                                                item,
-                                                (PyObject*)self);
+        ++count;
+    }
 
-        self->first = new_node;
-        if (self->last == Py_None)
-            self->last = new_node;
+    new_list->first = prev->next;
+    new_list->last = self->last;
+    new_list->size = count;
 
-        ++self->size;
+    prev->next = NULL;
+    self->last = prev;
+    self->size -= count;
+    ++self->state;
 
-        Py_DECREF(item);
-    }
+    /* spine might refer to cells of the tail */
+    self->spine_start = 0;
+    self->spine_end = 0;
 
-    Py_RETURN_NONE;
+    return (PyObject*)new_list;
 }
 
-
-static PyObject* sllist_extendright(SLListObject* self, PyObject* arg)
+/* Compares values of two cells for sort(). */
+static int sllistcell_less(void* a, void* b)
 {
-    if (!sllist_extend_internal(self, arg))
-        return NULL;
+    PyObject* x = ((SLListCell*)a)->value;
+    PyObject* y = ((SLListCell*)b)->value;
 
-    Py_RETURN_NONE;
+    /* values need not be protected, since nodes of a list being sorted
+     * cannot replace them */
+    return PyObject_RichCompareBool(x, y, Py_LT);
 }
 
-
-static SLListNodeObject* sllist_get_node_internal(SLListObject* self,
-                                                  Py_ssize_t pos)
+/* Compares original positions of two cells, which sort() stores
+ * in their spine slots. */
+static int sllistcell_less_pos(void* a, void* b)
 {
-    SLListNodeObject* node;
-    Py_ssize_t counter;
-
-    if (pos < 0 || pos >= self->size)
-    {
-        PyErr_SetString(PyExc_IndexError, "Index out of range");
-        return NULL;
-    }
-    /* taking head */
-    node = (SLListNodeObject*)self->first;
-    assert((PyObject*)node != Py_None);
-    /* iterate to given index */
-    for (counter = 0; counter < pos; ++counter)
-        node = (SLListNodeObject*)node->next;
-
-    return node;
+    return ((SLListCell*)a)->spine_pos < ((SLListCell*)b)->spine_pos;
 }
 
-
-static PyObject* sllist_node_at(PyObject* self, PyObject* indexObject)
+static PyObject* sllist_sort(SLListObject* self,
+                             PyObject* args,
+                             PyObject* kwds)
 {
-    SLListNodeObject* node;
-    Py_ssize_t index;
+    static char* kwlist[] = { "key", "reverse", NULL };
+    PyObject* key_func = NULL;
+    PyObject* reverse_arg = NULL;
+    PyObject** values = NULL;
+    LListSortChain chain;
+    SLListCell* added;
+    SLListCell* cell;
+    SLListCell* last = NULL;
+    void* head = self->first;
+    Py_ssize_t state = self->state;
+    Py_ssize_t size = self->size;
+    Py_ssize_t i;
+    int sorting = self->sorting;
+    int reverse = 0;
+    int modified;
+    int result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO:sort", kwlist,
+                                     &key_func, &reverse_arg))
+        return NULL;
 
-    if (!Py23Int_Check(indexObject))
+    if (key_func == Py_None)
+        key_func = NULL;
+
+    if (reverse_arg != NULL)
     {
-        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
-        return NULL;
+        reverse = PyObject_IsTrue(reverse_arg);
+        if (reverse == -1)
+            return NULL;
     }
 
-    index = Py23Int_AsSsize_t(indexObject);
+    if (size < 2)
+        Py_RETURN_NONE;
 
-    if (index < 0)
-        index = ((SLListObject*)self)->size + index;
+    if (key_func != NULL)
+    {
+        values = (PyObject**)PyMem_Malloc(size * sizeof(PyObject*));
+        if (values == NULL)
+            return PyErr_NoMemory();
 
-    node = sllist_get_node_internal((SLListObject*)self, index);
-    Py_XINCREF(node);
+        for (cell = self->first, i = 0; cell != NULL; cell = cell->next, ++i)
+        {
+            PyObject* value = cell->value;
+            PyObject* key;
 
-    return (PyObject*)node;
-}
+            Py_INCREF(value);
+            key = PyObject_CallFunctionObjArgs(key_func, value, NULL);
+            Py_DECREF(value);
 
+            if (key != NULL && state != self->state)
+            {
+                Py_DECREF(key);
+                key = NULL;
+                PyErr_SetString(PyExc_RuntimeError,
+                    "sllist modified during sort()");
+            }
 
-static PyObject* sllist_remove(SLListObject* self, PyObject* arg)
-{
-    SLListNodeObject* del_node;
-    SLListNodeObject* prev;
-    PyObject* list_ref;
-    PyObject* value;
+            if (key == NULL)
+            {
+                while (i > 0)
+                    Py_DECREF(values[--i]);
 
-    if (!PyObject_TypeCheck(arg, &SLListNodeType))
-    {
-        PyErr_SetString(PyExc_TypeError, "Argument is not an sllistnode");
-        return NULL;
-    }
+                PyMem_Free(values);
+                return NULL;
+            }
 
-    if (self->first == Py_None)
-    {
-        PyErr_SetString(PyExc_ValueError, "List is empty");
-        return NULL;
+            values[i] = key;
+        }
     }
 
-    del_node = (SLListNodeObject*)arg;
+    /* Cells are unlinked from the list while they are sorted, so that
+     * the list appears empty to user code run by comparisons. Their
+     * nodes cannot be used to modify the list or read values meanwhile
+     * (see sllist_check_node_list() and sllist_check_node_value()).
+     * Cells in the spine will no longer be in list order, so spine
+     * slots of cells are reused to store their original positions. */
+    self->first = NULL;
+    self->last = NULL;
+    self->last_accessed_cell = NULL;
+    self->last_accessed_idx = -1;
+    self->size = 0;
+    self->spine_start = 0;
+    self->spine_end = 0;
+    self->sorting = 1;
+    state = ++self->state;
 
-    if (del_node->list_weakref == Py_None)
+    for (cell = (SLListCell*)head, i = 0; cell != NULL; cell = cell->next, ++i)
     {
-        PyErr_SetString(PyExc_ValueError,
-            "sllistnode does not belong to a list");
-        return NULL;
+        cell->spine_pos = i;
+
+        /* cells hold keys while they are sorted and values are kept
+         * in the array */
+        if (values != NULL)
+        {
+            PyObject* key = values[i];
+
+            values[i] = cell->value;
+            cell->value = key;
+        }
     }
 
-    list_ref = PyWeakref_GetObject(del_node->list_weakref);
-    if (list_ref != (PyObject*)self)
+    chain.next_offset = offsetof(SLListCell, next);
+    chain.less = sllistcell_less;
+    chain.reverse = reverse;
+
+    result = llist_sort_chain(&chain, &head);
+
+    if (result == -1)
     {
-        PyErr_SetString(PyExc_ValueError,
-            "sllistnode belongs to another list");
-        return NULL;
+        /* restore the original order, which cannot fail */
+        chain.less = sllistcell_less_pos;
+        chain.reverse = 0;
+        llist_sort_chain(&chain, &head);
     }
 
-    /* remove first node case */
-    if(self->first == arg) {
-        self->first = del_node->next;
-        if (self->last == arg)
-            self->last = Py_None;
-    }
-    /* we are sure that we have more than 1 node */
-    else
+    for (cell = (SLListCell*)head; cell != NULL; cell = cell->next)
     {
-        /* making gap */
-        prev = sllist_get_prev(self, del_node);
-        prev->next = del_node->next;
+        /* put values back into cells, leaving keys in the array */
+        if (values != NULL)
+        {
+            PyObject* value = values[cell->spine_pos];
+
+            values[cell->spine_pos] = cell->value;
+            cell->value = value;
+        }
 
-        if (self->last == arg)
-            self->last = (PyObject*)prev;
+        cell->spine_pos = -1;
+        last = cell;
     }
 
-    --self->size;
+    /* elements added by user code are discarded once the list
+     * is restored */
+    modified = (state != self->state);
+    added = self->first;
+
+    self->first = (SLListCell*)head;
+    self->last = last;
+    self->last_accessed_cell = NULL;
+    self->last_accessed_idx = -1;
+    self->size = size;
+    self->spine_start = 0;
+    self->spine_end = 0;
+    self->sorting = sorting;
+    ++self->state;
+
+    while (added != NULL)
+    {
+        cell = added;
+        added = added->next;
+        sllistcell_delete(cell);
+    }
 
-    value = del_node->value;
-    Py_INCREF(value);
+    if (values != NULL)
+    {
+        for (i = 0; i < size; ++i)
+            Py_DECREF(values[i]);
 
-    /* unlink from parent list */
-    Py_DECREF(del_node->list_weakref);
-    Py_INCREF(Py_None);
-    del_node->list_weakref = Py_None;
+        PyMem_Free(values);
+    }
 
-    del_node->next = Py_None;
-    Py_DECREF(arg);
+    if (result == -1)
+        return NULL;
 
-    return value;
+    if (modified)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+            "sllist modified during sort()");
+        return NULL;
+    }
 
+    Py_RETURN_NONE;
 }
 
-
-static PyObject* sllist_rotate(SLListObject* self, PyObject* nObject)
+static PyObject* sllist_reverse(SLListObject* self)
 {
-    Py_ssize_t n;
-    Py_ssize_t split_idx;
-    Py_ssize_t n_mod;
-    SLListNodeObject* new_first;
-    SLListNodeObject* new_last;
+    SLListCell* cell = self->first;
+    SLListCell* prev = NULL;
 
     if (self->size <= 1)
         Py_RETURN_NONE;
 
-    if (!Py23Int_Check(nObject))
+    while (cell != NULL)
     {
-        PyErr_SetString(PyExc_TypeError, "n must be an integer");
-        return NULL;
-    }
-
-    n = Py23Int_AsSsize_t(nObject);
-    n_mod = (n >= 0 ? n : -n) % self->size;
-
-    if (n_mod == 0)
-        Py_RETURN_NONE; /* no-op */
-
-    if (n > 0)
-        split_idx = self->size - n_mod; /* rotate right */
-    else
-        split_idx = n_mod;  /* rotate left */
+        SLListCell* next = cell->next;
 
-    new_last = sllist_get_node_internal(self, split_idx - 1);
-    assert(new_last != NULL);
-    new_first = (SLListNodeObject*)new_last->next;
+        cell->next = prev;
+        prev = cell;
+        cell = next;
+    }
 
-    ((SLListNodeObject*)self->last)->next = self->first;
+    self->last = self->first;
+    self->first = prev;
+    ++self->state;
 
-    new_last->next = Py_None;
+    if (self->last_accessed_cell != NULL)
+        self->last_accessed_idx = self->size - 1 - self->last_accessed_idx;
 
-    self->first = (PyObject*)new_first;
-    self->last = (PyObject*)new_last;
+    /* cells in the spine are no longer in list order */
+    self->spine_start = 0;
+    self->spine_end = 0;
 
     Py_RETURN_NONE;
 }
 
-
 static PyObject* sllist_concat(PyObject* self, PyObject* other)
 {
     SLListObject* new_list;
 
-    new_list = (SLListObject*)PyObject_CallObject(
-        (PyObject*)&SLListType, NULL);
+    new_list = (SLListObject*)sllist_new(&SLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
 
-    if (!sllist_extend_internal(new_list, self) ||
-        !sllist_extend_internal(new_list, other))
+    if (!sllist_extend_internal(new_list, self, 0) ||
+        !sllist_extend_internal(new_list, other, 0))
     {
         Py_DECREF(new_list);
         return NULL;
@@ -976,7 +2176,7 @@ static PyObject* sllist_concat(PyObject* self, PyObject* other)
 
 static PyObject* sllist_inplace_concat(PyObject* self, PyObject* other)
 {
-    if (!sllist_extend_internal((SLListObject*)self, other))
+    if (!sllist_extend_internal((SLListObject*)self, other, 0))
         return NULL;
 
     Py_INCREF(self);
@@ -989,12 +2189,13 @@ static PyObject* sllist_repeat(PyObject* self, Py_ssize_t count)
     SLListObject* new_list;
     Py_ssize_t i;
 
-    new_list = (SLListObject*)PyObject_CallObject(
-        (PyObject*)&SLListType, NULL);
+    new_list = (SLListObject*)sllist_new(&SLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
 
     for (i = 0; i < count; ++i)
     {
-        if (!sllist_extend_internal(new_list, self))
+        if (!sllist_extend_internal(new_list, self, 0))
         {
             Py_DECREF(new_list);
             return NULL;
@@ -1007,12 +2208,12 @@ static PyObject* sllist_repeat(PyObject* self, Py_ssize_t count)
 
 static PyObject* sllist_get_item(PyObject* self, Py_ssize_t index)
 {
-    SLListNodeObject* node;
+    SLListCell* cell;
 
-    node = sllist_get_node_internal((SLListObject*)self, index);
-    if (node != NULL)
+    cell = sllist_get_cell_internal((SLListObject*)self, index);
+    if (cell != NULL)
     {
-        PyObject* value = node->value;
+        PyObject* value = cell->value;
 
         Py_XINCREF(value);
         return value;
@@ -1024,33 +2225,45 @@ static PyObject* sllist_get_item(PyObject* self, Py_ssize_t index)
 static int sllist_set_item(PyObject* self, Py_ssize_t index, PyObject* val)
 {
     SLListObject* list = (SLListObject*)self;
-    SLListNodeObject* node;
+    SLListCell* cell;
+    SLListCell* prev = NULL;
     PyObject* oldval;
 
+    if (val == NULL && index > 0)
+    {
+        /* deleting nth node needs the preceding cell, which is located
+         * first, so that the last accessed cell can be reused */
+        prev = sllist_get_cell_internal(list, index - 1);
+        cell = (prev != NULL) ? prev->next : NULL;
+    }
     /* setting fist node */
-    if(index==0)
-        node = (SLListNodeObject*)list->first;
+    else if(index==0)
+        cell = list->first;
     /* setting last node */
     else if(index==list->size-1)
-        node = (SLListNodeObject*)list->last;
+        cell = list->last;
     /* setting nth node,  */
     else
-        /* get_node_internal will rise error for index out of scale */
-        node = (SLListNodeObject*)sllist_get_node_internal(list, index);
+        /* get_cell_internal will rise error for index out of scale */
+        cell = sllist_get_cell_internal(list, index);
 
-    if (node == NULL)
+    if (cell == NULL)
+    {
+        if (!PyErr_Occurred())
+            PyErr_SetString(PyExc_IndexError, "Index out of range");
         return -1;
+    }
 
     /* Here is a tricky (and undocumented) part of sequence protocol.
      * Python will pass NULL as item value when item is deleted with:
      * del list[index] */
     if (val == NULL)
     {
-        PyObject* result = sllist_remove(list, (PyObject*)node);
+        PyObject* result = sllist_remove_cell(list, cell, prev);
 
-        Py_XDECREF(result);
+        Py_DECREF(result);
 
-        return (result != NULL) ? 0 : -1;
+        return 0;
     }
 
     /* The rest of this function handles normal assignment:
@@ -1061,12 +2274,12 @@ static int sllist_set_item(PyObject* self, Py_ssize_t index, PyObject* val)
     }
 
     /* nice played, migu :) */
-    val = ((SLListNodeObject*)val)->value;
+    val = ((SLListNodeObject*)val)->cell->value;
 
-    oldval = node->value;
+    oldval = cell->value;
 
     Py_INCREF(val);
-    node->value = val;
+    cell->value = val;
     Py_DECREF(oldval);
 
     return 0;
@@ -1074,218 +2287,522 @@ static int sllist_set_item(PyObject* self, Py_ssize_t index, PyObject* val)
 
 static PyObject* sllist_clear(SLListObject* self)
 {
-    PyObject* iter_node_obj = self->first;
+    SLListCell* iter_cell = self->first;
+
+    while (iter_cell != NULL)
+    {
+        SLListCell* cell = iter_cell;
+
+        iter_cell = iter_cell->next;
+        sllistcell_delete(cell);
+    }
+
+    self->first = NULL;
+    self->last = NULL;
+    self->last_accessed_cell = NULL;
+    self->last_accessed_idx = -1;
+    self->size = 0;
+    ++self->state;
+
+    PyMem_Free(self->spine);
+    self->spine = NULL;
+    self->spine_start = 0;
+    self->spine_end = 0;
+    self->spine_capacity = 0;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* sllist_popleft(SLListObject* self)
+{
+    if (self->first == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    /* setting the first node to next of removed one*/
+    return sllist_remove_cell(self, self->first, NULL);
+}
+
+
+static PyObject* sllist_popright(SLListObject* self)
+{
+    if (self->last == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    return sllist_remove_cell(self,
+                              self->last,
+                              sllist_get_prev_of_last(self));
+}
+
+
+static PyObject* sllist_iternodes(PyObject* self)
+{
+    return sllistiterator_create(&SLListIteratorType, self, 1);
+}
+
+static PyObject* sllist_iter(PyObject* self)
+{
+    return sllistiterator_create(&SLListIteratorType, self, 0);
+}
+
+
+
+static PyObject* sllist_to_string(SLListObject* self,
+                                  reprfunc fmt_func)
+{
+    PyObject* str = NULL;
+    PyObject* comma_str = NULL;
+    PyObject* tmp_str;
+    SLListCell* cell = self->first;
+
+    assert(fmt_func != NULL);
+
+    if (self->first == NULL)
+    {
+        str = Py23String_FromString("sllist()");
+        if (str == NULL)
+            goto str_alloc_error;
+        return str;
+    }
+
+    str = Py23String_FromString("sllist([");
+    if (str == NULL)
+        goto str_alloc_error;
+
+    comma_str = Py23String_FromString(", ");
+    if (comma_str == NULL)
+        goto str_alloc_error;
+
+    while (cell != NULL)
+    {
+        if (cell != self->first)
+            Py23String_Concat(&str, comma_str);
+
+        tmp_str = fmt_func(cell->value);
+        if (tmp_str == NULL)
+            goto str_alloc_error;
+        Py23String_ConcatAndDel(&str, tmp_str);
+
+        cell = cell->next;
+    }
+
+    Py_DECREF(comma_str);
+    comma_str = NULL;
+
+    tmp_str = Py23String_FromString("])");
+    if (tmp_str == NULL)
+        goto str_alloc_error;
+    Py23String_ConcatAndDel(&str, tmp_str);
+
+    return str;
+
+str_alloc_error:
+    Py_XDECREF(str);
+    Py_XDECREF(comma_str);
+    PyErr_SetString(PyExc_RuntimeError, "Failed to create string");
+    return NULL;
+}
+
+
+static PyObject* sllist_repr(SLListObject* self)
+{
+    return sllist_to_string(self, PyObject_Repr);
+}
+
+
+static PyObject* sllist_str(SLListObject* self)
+{
+    return sllist_to_string(self, PyObject_Str);
+}
+
+
+static Py_ssize_t sllist_len(PyObject* self)
+{
+    return ((SLListObject*)self)->size;
+}
+
+
+static int sllist_contains(PyObject* self, PyObject* value)
+{
+    SLListObject* list = (SLListObject*)self;
+    SLListCell* cell;
+
+    for (cell = list->first; cell != NULL; cell = cell->next)
+    {
+        int match = sllist_cell_matches(list, cell, value, "__contains__");
+        if (match != 0)
+            return match;
+    }
+
+    return 0;
+}
+
+
+static long sllist_hash(SLListObject* self)
+{
+    long hash = 0;
+    SLListCell* iter_cell = self->first;
+
+    while (iter_cell != NULL)
+    {
+        long obj_hash;
+
+        obj_hash = PyObject_Hash(iter_cell->value);
+        if (obj_hash == -1)
+            return -1;
+
+        hash ^= obj_hash;
+        iter_cell = iter_cell->next;
+    }
+
+    return hash;
+}
+
+
+static PyObject* sllist_get_slice(SLListObject* self,
+                                  Py_ssize_t start,
+                                  Py_ssize_t step,
+                                  Py_ssize_t slicelength)
+{
+    SLListObject* new_list;
+    SLListCell* cell;
+    Py_ssize_t i;
+    Py_ssize_t j;
+    int reverse = 0;
+
+    new_list = (SLListObject*)sllist_new(&SLListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
+
+    if (slicelength == 0)
+        return (PyObject*)new_list;
+
+    /* The list can only be walked forward, so that slices with negative
+     * step are collected from the lowest index and reversed on the fly. */
+    if (step < 0)
+    {
+        start += (slicelength - 1) * step;
+        step = -step;
+        reverse = 1;
+    }
+
+    /* locate the first cell once and walk the rest of the slice */
+    cell = sllist_get_cell_internal(self, start);
+    assert(cell != NULL);
 
-    while (iter_node_obj != Py_None)
+    for (i = 0; i < slicelength; ++i)
     {
-        SLListNodeObject* iter_node = (SLListNodeObject*)iter_node_obj;
+        SLListCell* new_cell;
+
+        new_cell = sllistcell_new(cell->value);
+        if (new_cell == NULL)
+        {
+            Py_DECREF(new_list);
+            return NULL;
+        }
+
+        sllist_link_cell(new_list, new_cell,
+                         reverse ? NULL : new_list->last);
+
+        if (i + 1 < slicelength)
+        {
+            for (j = 0; j < step; ++j)
+                cell = cell->next;
+        }
+    }
+
+    return (PyObject*)new_list;
+}
+
+
+/* Convenience function for unlinking cells of a slice with positive
+ * step. Cells represented by nodes are detached right away, other ones
+ * are chained through their next pointers and returned, so that their
+ * values are released by sllist_free_cells() only after the list is
+ * consistent again. The cell preceding start (or NULL) is stored
+ * in preceding. */
+static SLListCell* sllist_unlink_slice(SLListObject* self,
+                                       Py_ssize_t start,
+                                       Py_ssize_t step,
+                                       Py_ssize_t slicelength,
+                                       SLListCell** preceding)
+{
+    SLListCell* removed = NULL;
+    SLListCell* prev;
+    SLListCell* cell;
+    Py_ssize_t i;
+    Py_ssize_t j;
 
-        iter_node_obj = iter_node->next;
+    assert(step > 0);
 
-        iter_node->next = Py_None;
-        Py_DECREF((PyObject*)iter_node);
-    }
+    prev = (start > 0) ? sllist_get_cell_internal(self, start - 1) : NULL;
+    *preceding = prev;
 
-    self->first = Py_None;
-    self->last = Py_None;
-    self->size = 0;
+    if (slicelength == 0)
+        return NULL;
 
-    Py_RETURN_NONE;
-}
+    /* last accessed cell is not tracked across bulk removal */
+    self->last_accessed_cell = NULL;
+    self->last_accessed_idx = -1;
 
-static PyObject* sllist_popleft(SLListObject* self)
-{
-    SLListNodeObject* del_node;
-    PyObject* value;
+    cell = (prev != NULL) ? prev->next : self->first;
 
-    if (self->first == Py_None)
+    for (i = 0; i < slicelength; ++i)
     {
-        PyErr_SetString(PyExc_ValueError, "List is empty");
-        return NULL;
-    }
+        SLListCell* next = cell->next;
 
-    del_node = (SLListNodeObject*)self->first;
+        sllist_unlink_cell(self, cell, prev);
 
-    /* setting the first node to next of removed one*/
-    self->first = del_node->next;
-    /* removeing last node */
-    if (self->last == (PyObject*)del_node)
-        self->last = Py_None;
-
-    --self->size;
+        if (cell->node != NULL)
+            sllistcell_delete(cell);
+        else
+        {
+            cell->next = removed;
+            removed = cell;
+        }
 
-    Py_INCREF(del_node->value);
-    value = del_node->value;
+        cell = next;
 
-    del_node->next = Py_None;
-    Py_DECREF((PyObject*)del_node);
+        if (i + 1 < slicelength)
+        {
+            for (j = 1; j < step; ++j)
+            {
+                prev = cell;
+                cell = cell->next;
+            }
+        }
+    }
 
-    return value;
+    return removed;
 }
 
 
-static PyObject* sllist_popright(SLListObject* self)
+/* Convenience function for replacing a slice with step 1 by elements
+ * of a sequence. */
+static int sllist_replace_slice(SLListObject* self,
+                                Py_ssize_t start,
+                                Py_ssize_t slicelength,
+                                PyObject* sequence)
 {
-    SLListNodeObject* del_node;
-    SLListNodeObject* prev;
-    PyObject* value;
+    PyObject** items = PySequence_Fast_ITEMS(sequence);
+    Py_ssize_t n = PySequence_Fast_GET_SIZE(sequence);
+    SLListCell* new_cells = NULL;
+    SLListCell* removed;
+    SLListCell* prev;
+    Py_ssize_t i;
 
-    if (self->last == Py_None)
+    /* New cells are allocated up front, so that the list is left intact
+     * if allocation fails. */
+    for (i = n - 1; i >= 0; --i)
     {
-        PyErr_SetString(PyExc_ValueError, "List is empty");
-        return NULL;
-    }
+        SLListCell* new_cell = sllistcell_new(sllist_value_arg(items[i]));
 
-    del_node = (SLListNodeObject*)self->last;
-    /* only one node in list */
-    if (self->first == (PyObject*)del_node){
-        self->last = Py_None;
-        self->first = Py_None;
-    }
-    /* more than one node */
-    else
-    {
-        prev = sllist_get_prev(self, del_node);
-        prev->next = Py_None;
-        self->last = (PyObject*)prev;
+        if (new_cell == NULL)
+        {
+            sllist_free_cells(new_cells);
+            return -1;
+        }
+
+        new_cell->next = new_cells;
+        new_cells = new_cell;
     }
 
-    --self->size;
+    removed = sllist_unlink_slice(self, start, 1, slicelength, &prev);
+
+    while (new_cells != NULL)
+    {
+        SLListCell* new_cell = new_cells;
 
-    Py_INCREF(del_node->value);
-    value = del_node->value;
+        new_cells = new_cells->next;
+        sllist_link_cell(self, new_cell, prev);
+        prev = new_cell;
+    }
 
-    del_node->next = Py_None;
-    Py_DECREF((PyObject*)del_node);
+    sllist_free_cells(removed);
 
-    return value;
+    return 0;
 }
 
 
-static PyObject* sllist_iter(PyObject* self)
+/* Convenience function for assigning elements of a sequence to
+ * a slice with step other than 1. Sizes must match. */
+static int sllist_assign_extended_slice(SLListObject* self,
+                                        Py_ssize_t start,
+                                        Py_ssize_t step,
+                                        Py_ssize_t slicelength,
+                                        PyObject* sequence)
 {
-    PyObject* args;
-    PyObject* result;
+    PyObject** items = PySequence_Fast_ITEMS(sequence);
+    PyObject** old_values;
+    SLListCell* cell;
+    Py_ssize_t i;
+    Py_ssize_t j;
+    int reverse = 0;
 
-    args = PyTuple_New(1);
-    if (args == NULL)
+    if (PySequence_Fast_GET_SIZE(sequence) != slicelength)
     {
-        PyErr_SetString(PyExc_RuntimeError,
-            "Failed to create argument tuple");
-        return NULL;
+        PyErr_Format(PyExc_ValueError,
+            "attempt to assign sequence of size %zd "
+            "to extended slice of size %zd",
+            PySequence_Fast_GET_SIZE(sequence), slicelength);
+        return -1;
     }
 
-    Py_INCREF(self);
-    if (PyTuple_SetItem(args, 0, self) != 0)
+    if (slicelength == 0)
+        return 0;
+
+    old_values = (PyObject**)PyMem_Malloc(slicelength * sizeof(PyObject*));
+    if (old_values == NULL)
     {
-        PyErr_SetString(PyExc_RuntimeError,
-            "Failed to initialize argument tuple");
-        return NULL;
+        PyErr_NoMemory();
+        return -1;
     }
 
-    result = PyObject_CallObject((PyObject*)&SLListIteratorType, args);
+    /* slices with negative step are walked from the lowest index */
+    if (step < 0)
+    {
+        start += (slicelength - 1) * step;
+        step = -step;
+        reverse = 1;
+    }
 
-    Py_DECREF(args);
+    cell = sllist_get_cell_internal(self, start);
+    assert(cell != NULL);
 
-    return result;
-}
+    for (i = 0; i < slicelength; ++i)
+    {
+        PyObject* value = sllist_value_arg(
+            items[reverse ? slicelength - 1 - i : i]);
 
+        Py_INCREF(value);
+        old_values[i] = cell->value;
+        cell->value = value;
 
+        if (i + 1 < slicelength)
+        {
+            for (j = 0; j < step; ++j)
+                cell = cell->next;
+        }
+    }
 
-static PyObject* sllist_to_string(SLListObject* self,
-                                  reprfunc fmt_func)
-{
-    PyObject* str = NULL;
-    PyObject* comma_str = NULL;
-    PyObject* tmp_str;
-    SLListNodeObject* node = (SLListNodeObject*)self->first;
+    /* release old values once the list is consistent */
+    for (i = 0; i < slicelength; ++i)
+        Py_DECREF(old_values[i]);
 
-    assert(fmt_func != NULL);
+    PyMem_Free(old_values);
 
-    if (self->first == Py_None)
-    {
-        str = Py23String_FromString("sllist()");
-        if (str == NULL)
-            goto str_alloc_error;
-        return str;
-    }
+    return 0;
+}
 
-    str = Py23String_FromString("sllist([");
-    if (str == NULL)
-        goto str_alloc_error;
 
-    comma_str = Py23String_FromString(", ");
-    if (comma_str == NULL)
-        goto str_alloc_error;
+static PyObject* sllist_subscript(PyObject* self, PyObject* item)
+{
+    SLListObject* list = (SLListObject*)self;
+    Py_ssize_t start;
+    Py_ssize_t stop;
+    Py_ssize_t step;
+    Py_ssize_t slicelength;
 
-    while ((PyObject*)node != Py_None)
+    if (PyIndex_Check(item))
     {
-        if (node != (SLListNodeObject*)self->first)
-            Py23String_Concat(&str, comma_str);
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred())
+            return NULL;
 
-        tmp_str = fmt_func(node->value);
-        if (tmp_str == NULL)
-            goto str_alloc_error;
-        Py23String_ConcatAndDel(&str, tmp_str);
+        if (index < 0)
+            index += list->size;
 
-        node = (SLListNodeObject*)node->next;
+        return sllist_get_item(self, index);
     }
 
-    Py_DECREF(comma_str);
-    comma_str = NULL;
-
-    tmp_str = Py23String_FromString("])");
-    if (tmp_str == NULL)
-        goto str_alloc_error;
-    Py23String_ConcatAndDel(&str, tmp_str);
-
-    return str;
-
-str_alloc_error:
-    Py_XDECREF(str);
-    Py_XDECREF(comma_str);
-    PyErr_SetString(PyExc_RuntimeError, "Failed to create string");
-    return NULL;
-}
+    if (!PySlice_Check(item))
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "Indices must be integers or slices");
+        return NULL;
+    }
 
+    if (Py23Slice_GetIndicesEx(item, list->size,
+                               &start, &stop, &step, &slicelength) != 0)
+        return NULL;
 
-static PyObject* sllist_repr(SLListObject* self)
-{
-    return sllist_to_string(self, PyObject_Repr);
+    return sllist_get_slice(list, start, step, slicelength);
 }
 
 
-static PyObject* sllist_str(SLListObject* self)
+static int sllist_ass_subscript(PyObject* self,
+                                PyObject* item,
+                                PyObject* value)
 {
-    return sllist_to_string(self, PyObject_Str);
-}
+    SLListObject* list = (SLListObject*)self;
+    Py_ssize_t start;
+    Py_ssize_t stop;
+    Py_ssize_t step;
+    Py_ssize_t slicelength;
+    PyObject* sequence;
+    int result;
+
+    if (PyIndex_Check(item))
+    {
+        Py_ssize_t index = PyNumber_AsSsize_t(item, PyExc_IndexError);
+        if (index == -1 && PyErr_Occurred())
+            return -1;
 
+        if (index < 0)
+            index += list->size;
 
-static Py_ssize_t sllist_len(PyObject* self)
-{
-    return ((SLListObject*)self)->size;
-}
+        return sllist_set_item(self, index, value);
+    }
 
+    if (!PySlice_Check(item))
+    {
+        PyErr_SetString(PyExc_TypeError,
+            "Indices must be integers or slices");
+        return -1;
+    }
 
-static long sllist_hash(SLListObject* self)
-{
-    long hash = 0;
-    PyObject* iter_node_obj = self->first;
+    if (Py23Slice_GetIndicesEx(item, list->size,
+                               &start, &stop, &step, &slicelength) != 0)
+        return -1;
 
-    while (iter_node_obj != Py_None)
+    if (value == NULL)
     {
-        long obj_hash;
-        SLListNodeObject* iter_node = (SLListNodeObject*)iter_node_obj;
+        SLListCell* prev;
 
-        obj_hash = PyObject_Hash(iter_node->value);
-        if (obj_hash == -1)
-            return -1;
+        if (slicelength == 0)
+            return 0;
 
-        hash ^= obj_hash;
-        iter_node_obj = iter_node->next;
+        /* slices with negative step are deleted in forward direction */
+        if (step < 0)
+        {
+            start += (slicelength - 1) * step;
+            step = -step;
+        }
+
+        sllist_free_cells(sllist_unlink_slice(
+            list, start, step, slicelength, &prev));
+        return 0;
     }
 
-    return hash;
+    /* copying the sequence also handles assignment of list to itself */
+    sequence = PySequence_Fast(value, "can only assign an iterable");
+    if (sequence == NULL)
+        return -1;
+
+    if (step == 1)
+        result = sllist_replace_slice(list, start, slicelength, sequence);
+    else
+        result = sllist_assign_extended_slice(
+            list, start, step, slicelength, sequence);
+
+    Py_DECREF(sequence);
+
+    return result;
 }
 
 
@@ -1303,6 +2820,9 @@ static PyMethodDef SLListMethods[] =
     { "clear", (PyCFunction)sllist_clear, METH_NOARGS,
       "Remove all elements from the list" },
 
+    { "count", (PyCFunction)sllist_count, METH_O,
+      "Return number of occurrences of value" },
+
     { "extend", (PyCFunction)sllist_extendright, METH_O,
       "Append elements from iterable at the right side of the list" },
 
@@ -1312,12 +2832,30 @@ static PyMethodDef SLListMethods[] =
     { "extendright", (PyCFunction)sllist_extendright, METH_O,
       "Append elements from iterable at the right side of the list" },
 
-    { "insertafter", (PyCFunction)sllist_insertafter, METH_VARARGS,
+    { "find", (PyCFunction)sllist_find, METH_O,
+      "Return first node with value" },
+
+    { "index", (PyCFunction)sllist_index, METH_VARARGS,
+      "Return position of the first occurrence of value" },
+
+    { "insertafter", (PyCFunction)sllist_insertafter, Py23_METH_FASTCALL,
       "Inserts element after node" },
 
-    { "insertbefore", (PyCFunction)sllist_insertbefore, METH_VARARGS,
+    { "insertbefore", (PyCFunction)sllist_insertbefore, Py23_METH_FASTCALL,
       "Inserts element before node" },
 
+    { "iternodes", (PyCFunction)sllist_iternodes, METH_NOARGS,
+      "Return an iterator over nodes of the list" },
+
+    { "max", (PyCFunction)sllist_max, METH_NOARGS,
+      "Return the largest element of the list" },
+
+    { "mean", (PyCFunction)sllist_mean, METH_NOARGS,
+      "Return the arithmetic mean of elements of the list" },
+
+    { "min", (PyCFunction)sllist_min, METH_NOARGS,
+      "Return the smallest element of the list" },
+
     { "nodeat", (PyCFunction)sllist_node_at, METH_O,
       "Return node at index" },
 
@@ -1333,25 +2871,52 @@ static PyMethodDef SLListMethods[] =
     { "remove", (PyCFunction)sllist_remove, METH_O,
       "Remove element from the list" },
 
+    { "remove_if", (PyCFunction)sllist_remove_if, METH_O,
+      "Remove all elements, for which predicate returns true" },
+
+    { "remove_nodes", (PyCFunction)sllist_remove_nodes, METH_O,
+      "Remove all nodes from iterable" },
+
+    { "reverse", (PyCFunction)sllist_reverse, METH_NOARGS,
+      "Reverse the order of elements in place" },
+
     { "rotate", (PyCFunction)sllist_rotate, METH_O,
       "Rotate the list n steps to the right" },
 
+    { "sort", (PyCFunction)sllist_sort, METH_VARARGS | METH_KEYWORDS,
+      "Sort the list in place" },
+
+    { "splice", (PyCFunction)sllist_splice, Py23_METH_FASTCALL,
+      "Move nodes from another list before node" },
+
+    { "split_after", (PyCFunction)sllist_split_after, METH_O,
+      "Move all nodes following node to a new list" },
+
+    { "sum", (PyCFunction)sllist_sum, METH_NOARGS,
+      "Return the sum of elements of the list" },
+
     { NULL },   /* sentinel */
 };
 
 
 static PyMemberDef SLListMembers[] =
 {
-    { "first", T_OBJECT_EX, offsetof(SLListObject, first), READONLY,
-      "First node" },
-    { "last", T_OBJECT_EX, offsetof(SLListObject, last), READONLY,
-      "Next node" },
     { "size", T_INT, offsetof(SLListObject, size), READONLY,
       "size" },
 
     { NULL },   /* sentinel */
 };
 
+static PyGetSetDef SLListGetSetters[] =
+{
+    { "first", (getter)sllist_get_first, NULL,
+      "First node", NULL },
+    { "last", (getter)sllist_get_last, NULL,
+      "Next node", NULL },
+
+    { NULL },   /* sentinel */
+};
+
 static PySequenceMethods SLListSequenceMethods =
 {
     sllist_len,                  /* sq_length         */
@@ -1361,11 +2926,18 @@ static PySequenceMethods SLListSequenceMethods =
     0,                           /* sq_slice;         */
     sllist_set_item,             /* sq_ass_item       */
     0,                           /* sq_ass_slice      */
-    0,                           /* sq_contains       */
+    sllist_contains,             /* sq_contains       */
     sllist_inplace_concat,       /* sq_inplace_concat */
     0,                           /* sq_inplace_repeat */
 };
 
+static PyMappingMethods SLListMappingMethods =
+{
+    sllist_len,                  /* mp_length         */
+    sllist_subscript,            /* mp_subscript      */
+    sllist_ass_subscript,        /* mp_ass_subscript  */
+};
+
 static PyTypeObject SLListType =
 {
     PyVarObject_HEAD_INIT(NULL, 0)
@@ -1380,7 +2952,7 @@ static PyTypeObject SLListType =
     (reprfunc)sllist_repr,       /* tp_repr           */
     0,                           /* tp_as_number      */
     &SLListSequenceMethods,      /* tp_as_sequence    */
-    0,                           /* tp_as_mapping     */
+    &SLListMappingMethods,       /* tp_as_mapping     */
     (hashfunc)sllist_hash,       /* tp_hash           */
     0,                           /* tp_call           */
     (reprfunc)sllist_str,        /* tp_str            */
@@ -1399,7 +2971,7 @@ static PyTypeObject SLListType =
     0,                           /* tp_iternext       */
     SLListMethods,               /* tp_methods        */
     SLListMembers,               /* tp_members        */
-    0,                           /* tp_getset         */
+    SLListGetSetters,            /* tp_getset         */
     0,                           /* tp_base           */
     0,                           /* tp_dict           */
     0,                           /* tp_descr_get      */
@@ -1417,22 +2989,65 @@ typedef struct
 {
     PyObject_HEAD
     SLListObject* list;
-    PyObject* current_node;
+    SLListNodeObject* current_node; /* next node to visit (nodes only) */
+    SLListNodeObject* last_node;    /* node returned last (nodes only) */
+    SLListCell* current_cell;       /* next cell to visit (values only) */
+    Py_ssize_t state;   /* state of the list when iteration started
+                         * (or when the last node was returned) */
+    int nodes;      /* nonzero if nodes are returned instead of values */
 } SLListIteratorObject;
 
 static void sllistiterator_dealloc(SLListIteratorObject* self)
 {
     Py_XDECREF(self->current_node);
+    Py_XDECREF(self->last_node);
     Py_DECREF(self->list);
 
     PyObject_Del((PyObject*)self);
 }
 
+static PyObject* sllistiterator_create(PyTypeObject* type,
+                                       PyObject* owner_list,
+                                       int nodes)
+{
+    SLListIteratorObject* self;
+
+    self = (SLListIteratorObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->list = (SLListObject*)owner_list;
+    self->current_node = NULL;
+    self->last_node = NULL;
+    self->state = self->list->state;
+    self->nodes = nodes;
+
+    Py_INCREF(self->list);
+
+    /* Value iterators borrow the cell of the next element to visit,
+     * which stays valid for as long as the list is not modified. */
+    self->current_cell = nodes ? NULL : self->list->first;
+
+    /* Node iterators hold a node of the next element to visit,
+     * which keeps the element alive if it is removed from the list. */
+    if (nodes && self->list->first != NULL)
+    {
+        self->current_node = (SLListNodeObject*)sllistnode_from_cell(
+            owner_list, self->list->first);
+        if (self->current_node == NULL)
+        {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)self;
+}
+
 static PyObject* sllistiterator_new(PyTypeObject* type,
                                     PyObject* args,
                                     PyObject* kwds)
 {
-    SLListIteratorObject* self;
     PyObject* owner_list = NULL;
 
     if (!PyArg_UnpackTuple(args, "__new__", 1, 1, &owner_list))
@@ -1444,43 +3059,97 @@ static PyObject* sllistiterator_new(PyTypeObject* type,
         return NULL;
     }
 
-    self = (SLListIteratorObject*)type->tp_alloc(type, 0);
-    if (self == NULL)
-        return NULL;
+    return sllistiterator_create(type, owner_list, 0);
+}
 
-    self->list = (SLListObject*)owner_list;
-    self->current_node = self->list->first;
 
-    Py_INCREF(self->list);
-    Py_INCREF(self->current_node);
+/* Verifies that the list was not modified since the last node was
+ * returned by a node iterator, other than by removing that node.
+ * Otherwise the next node to visit might have been relinked. */
+static int sllistiterator_check_nodes(SLListIteratorObject* self)
+{
+    PyObject* list = (PyObject*)self->list;
 
-    return (PyObject*)self;
-}
+    if (self->current_node->list == list &&
+        (self->state == self->list->state ||
+         (self->state + 1 == self->list->state &&
+          self->last_node != NULL && self->last_node->list != list)))
+        return 1;
 
+    Py_CLEAR(self->current_node);
+    PyErr_SetString(PyExc_RuntimeError,
+        "sllist modified during iteration");
+
+    return 0;
+}
 
 static PyObject* sllistiterator_iternext(PyObject* self)
 {
     SLListIteratorObject* iter_self = (SLListIteratorObject*)self;
-    PyObject* value;
-    PyObject* next_node;
+    SLListNodeObject* node;
+    SLListNodeObject* last_node;
+    SLListCell* cell;
+    SLListCell* next_cell;
+
+    if (!iter_self->nodes)
+    {
+        cell = iter_self->current_cell;
+        if (cell == NULL)
+        {
+            PyErr_SetNone(PyExc_StopIteration);
+            return NULL;
+        }
+
+        if (iter_self->state != iter_self->list->state)
+        {
+            /* the borrowed cell may have been released */
+            iter_self->current_cell = NULL;
+            PyErr_SetString(PyExc_RuntimeError,
+                "sllist modified during iteration");
+            return NULL;
+        }
+
+        iter_self->current_cell = cell->next;
 
-    if (iter_self->current_node == NULL || iter_self->current_node == Py_None)
+        Py_INCREF(cell->value);
+        return cell->value;
+    }
+
+    node = iter_self->current_node;
+    if (node == NULL)
     {
-        Py_XDECREF(iter_self->current_node);
-        iter_self->current_node = NULL;
         PyErr_SetNone(PyExc_StopIteration);
         return NULL;
     }
 
-    value = ((SLListNodeObject*)iter_self->current_node)->value;
-    Py_INCREF(value);
+    if (!sllistiterator_check_nodes(iter_self))
+        return NULL;
 
-    next_node = ((SLListNodeObject*)iter_self->current_node)->next;
-    Py_INCREF(next_node);
-    Py_DECREF(iter_self->current_node);
-    iter_self->current_node = next_node;
+    next_cell = node->cell->next;
 
-    return value;
+    /* reference to the current node is passed over to the caller */
+    iter_self->current_node = NULL;
+
+    if (next_cell != NULL)
+    {
+        iter_self->current_node =
+            (SLListNodeObject*)sllistnode_from_cell(node->list, next_cell);
+        if (iter_self->current_node == NULL)
+        {
+            Py_DECREF(node);
+            return NULL;
+        }
+    }
+
+    /* the returned node is kept, so that its removal can be told
+     * apart from other modifications */
+    last_node = iter_self->last_node;
+    Py_INCREF(node);
+    iter_self->last_node = node;
+    iter_self->state = iter_self->list->state;
+    Py_XDECREF(last_node);
+
+    return (PyObject*)node;
 }
 
 
@@ -1512,7 +3181,7 @@ static PyTypeObject SLListIteratorType =
     0,                                  /* tp_clear          */
     0,                                  /* tp_richcompare    */
     0,                                  /* tp_weaklistoffset */
-    0,                                  /* tp_iter           */
+    PyObject_SelfIter,                  /* tp_iter           */
     sllistiterator_iternext,            /* tp_iternext       */
     0,                                  /* tp_methods        */
     0,                                  /* tp_members        */
@@ -1529,8 +3198,52 @@ static PyTypeObject SLListIteratorType =
 
 
 
+/* Releases cells and nodes above given number from the free lists. */
+static void sllist_shrink_freelist(Py_ssize_t max_free)
+{
+    while (sllistcell_num_free > max_free)
+    {
+        SLListCell* cell = sllistcell_free_list;
+
+        sllistcell_free_list = cell->next;
+        --sllistcell_num_free;
+        PyMem_Free(cell);
+    }
+
+    while (sllistnode_num_free > max_free)
+    {
+        SLListNodeObject* node = sllistnode_free_list;
+
+        sllistnode_free_list = (SLListNodeObject*)node->cell;
+        --sllistnode_num_free;
+        PyObject_Del((PyObject*)node);
+    }
+}
+
+Py_ssize_t sllist_trim_freelist(void)
+{
+    Py_ssize_t count = sllistcell_num_free + sllistnode_num_free;
+
+    sllist_shrink_freelist(0);
+
+    return count;
+}
+
+void sllist_set_freelist_limit(Py_ssize_t limit)
+{
+    sllist_max_free = limit;
+
+    /* release cells and nodes above the new high-water mark */
+    sllist_shrink_freelist(sllist_max_free);
+}
+
 int sllist_init_type(void)
 {
+#ifdef Py23_HAVE_VECTORCALL
+    SLListType.tp_vectorcall = sllist_vectorcall;
+    SLListNodeType.tp_vectorcall = sllistnode_vectorcall;
+#endif
+
     return
         ((PyType_Ready(&SLListType) == 0) &&
          (PyType_Ready(&SLListNodeType) == 0) &&
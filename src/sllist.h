@@ -5,7 +5,10 @@
 #ifndef SLLIST_H
 #define SLLIST_H
 
-int  sllist_init_type(void);
-void sllist_register(PyObject* module);
+int        sllist_init_type(void);
+void       sllist_register(PyObject* module);
+
+Py_ssize_t sllist_trim_freelist(void);
+void       sllist_set_freelist_limit(Py_ssize_t limit);
 
 #endif /* SLLIST_H */
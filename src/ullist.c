@@ -0,0 +1,1830 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#include <Python.h>
+#include <structmember.h>
+#include "py23macros.h"
+#include "llistreduce.h"
+
+#ifndef PyVarObject_HEAD_INIT
+    #define PyVarObject_HEAD_INIT(type, size) \
+        PyObject_HEAD_INIT(type) size,
+#endif
+
+/* Default number of elements stored in a single chunk */
+#define ULLIST_DEFAULT_CHUNKSIZE    64
+
+
+static PyTypeObject ULListType;
+static PyTypeObject ULListIteratorType;
+
+static PyObject* ullistiterator_create(PyTypeObject* type,
+                                       PyObject* owner_list);
+
+
+/* ULListChunk */
+
+/* Storage slot of a single element. Lists created with a typecode
+ * keep raw C values in the slots, other lists keep object references.
+ */
+typedef union
+{
+    PyObject* object;   /* typecode 0 */
+    PY_LONG_LONG q;     /* typecode 'q' */
+    double d;           /* typecode 'd' */
+} ULListItem;
+
+/* Chunks hold up to chunksize element slots in a contiguous array.
+ * Occupied slots are items[start] .. items[start + count - 1], so that
+ * elements can be added at both ends of a chunk without moving
+ * the other ones. Chunks are allocated with room for chunksize items.
+ */
+typedef struct ULListChunk
+{
+    struct ULListChunk* prev;
+    struct ULListChunk* next;
+    Py_ssize_t start;
+    Py_ssize_t count;
+    ULListItem items[1];
+} ULListChunk;
+
+
+/* ULList */
+
+typedef struct
+{
+    PyObject_HEAD
+    ULListChunk* first;
+    ULListChunk* last;
+    Py_ssize_t size;
+    Py_ssize_t chunksize;
+    Py_ssize_t state;   /* incremented when elements are moved */
+    char typecode;      /* 'q', 'd' or 0 for lists of objects */
+    PyObject* weakref_list;
+} ULListObject;
+
+static Py_ssize_t py_ssize_t_abs(Py_ssize_t x)
+{
+    return (x >= 0) ? x : -x;
+}
+
+/* Convenience function for converting a value to the storage format
+ * of the list. Object references are acquired by the item. Returns 0
+ * and sets an exception if the value does not fit in a typed list. */
+static int ullist_item_pack(ULListObject* self,
+                            PyObject* value,
+                            ULListItem* item)
+{
+    PyObject* index;
+
+    switch (self->typecode)
+    {
+    case 'q':
+        if (!PyIndex_Check(value))
+        {
+            PyErr_Format(PyExc_TypeError,
+                "Integer value expected, got '%.200s'",
+                Py_TYPE(value)->tp_name);
+            return 0;
+        }
+
+        index = PyNumber_Index(value);
+        if (index == NULL)
+            return 0;
+
+        item->q = PyLong_AsLongLong(index);
+        Py_DECREF(index);
+
+        return !(item->q == -1 && PyErr_Occurred());
+
+    case 'd':
+        item->d = PyFloat_AsDouble(value);
+
+        return !(item->d == -1.0 && PyErr_Occurred());
+
+    default:
+        Py_INCREF(value);
+        item->object = value;
+
+        return 1;
+    }
+}
+
+/* Convenience function for getting an element as an object.
+ * Returns a new reference; values of typed lists are boxed. */
+static PyObject* ullist_item_get(ULListObject* self, ULListItem item)
+{
+    switch (self->typecode)
+    {
+    case 'q':
+        return PyLong_FromLongLong(item.q);
+    case 'd':
+        return PyFloat_FromDouble(item.d);
+    default:
+        Py_INCREF(item.object);
+        return item.object;
+    }
+}
+
+/* Convenience function for releasing an element removed from
+ * the list. */
+static void ullist_item_release(ULListObject* self, ULListItem item)
+{
+    if (self->typecode == 0)
+        Py_DECREF(item.object);
+}
+
+/* Convenience function for converting an element removed from
+ * the list to an object. Reference owned by the item is passed
+ * to caller. */
+static PyObject* ullist_item_unpack(ULListObject* self, ULListItem item)
+{
+    if (self->typecode == 0)
+        return item.object;
+
+    return ullist_item_get(self, item);
+}
+
+/* Convenience function for allocating empty chunks.
+ * Elements added to the chunk will be placed starting at start. */
+static ULListChunk* ullistchunk_new(ULListObject* self, Py_ssize_t start)
+{
+    ULListChunk* chunk;
+
+    chunk = (ULListChunk*)PyMem_Malloc(sizeof(ULListChunk) +
+        (self->chunksize - 1) * sizeof(ULListItem));
+    if (chunk == NULL)
+    {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->start = start;
+    chunk->count = 0;
+
+    return chunk;
+}
+
+/* Convenience function for linking chunks into the list.
+ * The chunk is inserted after prev, or at the beginning of the list
+ * if prev is NULL. */
+static void ullist_link_chunk(ULListObject* self,
+                              ULListChunk* chunk,
+                              ULListChunk* prev)
+{
+    ULListChunk* next = (prev != NULL) ? prev->next : self->first;
+
+    chunk->prev = prev;
+    chunk->next = next;
+
+    if (prev != NULL)
+        prev->next = chunk;
+    else
+        self->first = chunk;
+
+    if (next != NULL)
+        next->prev = chunk;
+    else
+        self->last = chunk;
+}
+
+/* Convenience function for unlinking and releasing chunks.
+ * Elements still stored in the chunk are not released. */
+static void ullist_free_chunk(ULListObject* self, ULListChunk* chunk)
+{
+    if (chunk->prev != NULL)
+        chunk->prev->next = chunk->next;
+    else
+        self->first = chunk->next;
+
+    if (chunk->next != NULL)
+        chunk->next->prev = chunk->prev;
+    else
+        self->last = chunk->prev;
+
+    PyMem_Free(chunk);
+}
+
+/* Convenience function for locating list elements using index.
+ * Returns chunk containing the element and stores element position
+ * within the chunk (relative to chunk start) in pos. */
+static ULListChunk* ullist_locate(ULListObject* self,
+                                  Py_ssize_t index,
+                                  Py_ssize_t* pos)
+{
+    ULListChunk* chunk;
+
+    if (index >= self->size || index < 0)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        return NULL;
+    }
+
+    if (index <= self->size / 2)
+    {
+        /* forward scan */
+        chunk = self->first;
+        while (index >= chunk->count)
+        {
+            index -= chunk->count;
+            chunk = chunk->next;
+        }
+    }
+    else
+    {
+        /* backward scan */
+        index = self->size - 1 - index;
+        chunk = self->last;
+        while (index >= chunk->count)
+        {
+            index -= chunk->count;
+            chunk = chunk->prev;
+        }
+        index = chunk->count - 1 - index;
+    }
+
+    *pos = index;
+
+    return chunk;
+}
+
+/* Convenience function for advancing a cursor (chunk and position
+ * within the chunk) to the element at index, which must directly
+ * follow the element pointed by the cursor. If the list has been
+ * modified since state was recorded, the element is located again
+ * using its index. Returns NULL when there are no more elements.
+ */
+static ULListChunk* ullist_advance(ULListObject* self,
+                                   ULListChunk* chunk,
+                                   Py_ssize_t* pos,
+                                   Py_ssize_t index,
+                                   Py_ssize_t* state)
+{
+    if (*state != self->state)
+    {
+        *state = self->state;
+
+        if (index >= self->size)
+            return NULL;
+
+        return ullist_locate(self, index, pos);
+    }
+
+    if (++*pos == chunk->count)
+    {
+        chunk = chunk->next;
+        *pos = 0;
+    }
+
+    return chunk;
+}
+
+/* Convenience function for splitting full chunks in half.
+ * Upper half of the elements is moved to a new chunk, which is
+ * linked after the original one. */
+static ULListChunk* ullist_split_chunk(ULListObject* self, ULListChunk* chunk)
+{
+    ULListChunk* new_chunk;
+    Py_ssize_t keep = chunk->count / 2;
+
+    new_chunk = ullistchunk_new(self, 0);
+    if (new_chunk == NULL)
+        return NULL;
+
+    new_chunk->count = chunk->count - keep;
+    memcpy(new_chunk->items, chunk->items + chunk->start + keep,
+        new_chunk->count * sizeof(ULListItem));
+    chunk->count = keep;
+
+    ullist_link_chunk(self, new_chunk, chunk);
+
+    return new_chunk;
+}
+
+/* Convenience function for inserting an item at position pos
+ * (0 .. count) of a chunk, which must not be full. The smaller side
+ * of the chunk is moved to make room for the new element. */
+static void ullist_chunk_insert(ULListObject* self,
+                                ULListChunk* chunk,
+                                Py_ssize_t pos,
+                                ULListItem item)
+{
+    ULListItem* items = chunk->items + chunk->start;
+
+    assert(chunk->count < self->chunksize);
+
+    if (chunk->start > 0 &&
+        (chunk->start + chunk->count == self->chunksize ||
+         pos < chunk->count / 2))
+    {
+        /* move preceding elements down */
+        memmove(items - 1, items, pos * sizeof(ULListItem));
+        --chunk->start;
+        --items;
+    }
+    else
+    {
+        /* move following elements up */
+        memmove(items + pos + 1, items + pos,
+            (chunk->count - pos) * sizeof(ULListItem));
+    }
+
+    items[pos] = item;
+    ++chunk->count;
+    ++self->size;
+}
+
+/* Convenience function for inserting a value before element
+ * at given index (or at the end of the list if index == size). */
+static int ullist_insert_at(ULListObject* self,
+                            Py_ssize_t index,
+                            PyObject* value)
+{
+    ULListChunk* chunk;
+    Py_ssize_t pos;
+    ULListItem item;
+
+    /* Converting the value may run arbitrary code, so it is done
+     * before the insertion point is located. */
+    if (!ullist_item_pack(self, value, &item))
+        return 0;
+
+    if (index == self->size)
+    {
+        chunk = self->last;
+        pos = (chunk != NULL) ? chunk->count : 0;
+    }
+    else
+    {
+        chunk = ullist_locate(self, index, &pos);
+        if (chunk == NULL)
+        {
+            ullist_item_release(self, item);
+            return 0;
+        }
+    }
+
+    if (chunk == NULL || chunk->count == self->chunksize)
+    {
+        if (chunk != NULL && pos == chunk->count && chunk == self->last)
+        {
+            /* appending to full last chunk - start a new one */
+            chunk = NULL;
+        }
+
+        if (chunk == NULL)
+        {
+            chunk = ullistchunk_new(self, 0);
+            if (chunk == NULL)
+            {
+                ullist_item_release(self, item);
+                return 0;
+            }
+            ullist_link_chunk(self, chunk, self->last);
+            pos = 0;
+        }
+        else
+        {
+            ULListChunk* new_chunk = ullist_split_chunk(self, chunk);
+            if (new_chunk == NULL)
+            {
+                ullist_item_release(self, item);
+                return 0;
+            }
+
+            if (pos > chunk->count)
+            {
+                pos -= chunk->count;
+                chunk = new_chunk;
+            }
+        }
+    }
+
+    ++self->state;
+
+    ullist_chunk_insert(self, chunk, pos, item);
+
+    return 1;
+}
+
+/* Convenience function for inserting values at the beginning
+ * of the list. */
+static int ullist_insert_first(ULListObject* self, PyObject* value)
+{
+    ULListChunk* chunk;
+    ULListItem item;
+
+    if (!ullist_item_pack(self, value, &item))
+        return 0;
+
+    chunk = self->first;
+
+    if (chunk == NULL || chunk->count == self->chunksize)
+    {
+        /* fill new chunk from the end, so that following insertions
+         * at the beginning do not move elements */
+        chunk = ullistchunk_new(self, self->chunksize);
+        if (chunk == NULL)
+        {
+            ullist_item_release(self, item);
+            return 0;
+        }
+        ullist_link_chunk(self, chunk, NULL);
+    }
+
+    ++self->state;
+
+    if (chunk->start > 0)
+    {
+        --chunk->start;
+        chunk->items[chunk->start] = item;
+        ++chunk->count;
+        ++self->size;
+    }
+    else
+        ullist_chunk_insert(self, chunk, 0, item);
+
+    return 1;
+}
+
+/* Convenience function for inserting values at the end of the list. */
+static int ullist_insert_last(ULListObject* self, PyObject* value)
+{
+    ULListChunk* chunk;
+    ULListItem item;
+
+    if (!ullist_item_pack(self, value, &item))
+        return 0;
+
+    chunk = self->last;
+
+    if (chunk == NULL || chunk->count == self->chunksize)
+    {
+        chunk = ullistchunk_new(self, 0);
+        if (chunk == NULL)
+        {
+            ullist_item_release(self, item);
+            return 0;
+        }
+        ullist_link_chunk(self, chunk, self->last);
+    }
+
+    ++self->state;
+
+    if (chunk->start + chunk->count < self->chunksize)
+    {
+        chunk->items[chunk->start + chunk->count] = item;
+        ++chunk->count;
+        ++self->size;
+    }
+    else
+        ullist_chunk_insert(self, chunk, chunk->count, item);
+
+    return 1;
+}
+
+/* Convenience function for removing element at position pos
+ * of a chunk. Returns the removed item (reference owned by list
+ * is passed to caller). Chunks which become empty are released and
+ * sparse chunks are merged with their neighbours. */
+static ULListItem ullist_chunk_remove(ULListObject* self,
+                                      ULListChunk* chunk,
+                                      Py_ssize_t pos)
+{
+    ULListItem* items = chunk->items + chunk->start;
+    ULListItem item = items[pos];
+
+    if (pos < chunk->count / 2)
+    {
+        /* move preceding elements up */
+        memmove(items + 1, items, pos * sizeof(ULListItem));
+        ++chunk->start;
+    }
+    else
+    {
+        /* move following elements down */
+        memmove(items + pos, items + pos + 1,
+            (chunk->count - pos - 1) * sizeof(ULListItem));
+    }
+
+    --chunk->count;
+    --self->size;
+    ++self->state;
+
+    if (chunk->count == 0)
+    {
+        ullist_free_chunk(self, chunk);
+    }
+    else if (chunk->count < self->chunksize / 4)
+    {
+        /* try to merge sparse chunk with one of its neighbours */
+        ULListChunk* dst = NULL;
+        ULListChunk* src = NULL;
+
+        if (chunk->next != NULL &&
+            chunk->count + chunk->next->count <= self->chunksize)
+        {
+            dst = chunk;
+            src = chunk->next;
+        }
+        else if (chunk->prev != NULL &&
+                 chunk->count + chunk->prev->count <= self->chunksize)
+        {
+            dst = chunk->prev;
+            src = chunk;
+        }
+
+        if (dst != NULL)
+        {
+            /* compact destination chunk and append source elements */
+            memmove(dst->items, dst->items + dst->start,
+                dst->count * sizeof(ULListItem));
+            dst->start = 0;
+            memcpy(dst->items + dst->count, src->items + src->start,
+                src->count * sizeof(ULListItem));
+            dst->count += src->count;
+            ullist_free_chunk(self, src);
+        }
+    }
+
+    return item;
+}
+
+/* Convenience function for extending the list with elements
+ * from an iterable. Elements are inserted at the end of the list,
+ * or at the beginning (in reversed order) if left is nonzero.
+ * Iterables other than lists, tuples and the list itself are consumed
+ * through the iterator protocol without building a temporary sequence. */
+static int ullist_extend_internal(ULListObject* self,
+                                  PyObject* iterable,
+                                  int left)
+{
+    PyObject* fast;
+    PyObject** items;
+    Py_ssize_t len;
+    Py_ssize_t i;
+
+    if (iterable != (PyObject*)self &&
+        !PyList_Check(iterable) && !PyTuple_Check(iterable))
+    {
+        PyObject* iterator;
+        PyObject* item;
+
+        iterator = PyObject_GetIter(iterable);
+        if (iterator == NULL)
+            return 0;
+
+        while ((item = PyIter_Next(iterator)) != NULL)
+        {
+            int ok = left ?
+                ullist_insert_first(self, item) :
+                ullist_insert_last(self, item);
+
+            Py_DECREF(item);
+
+            if (!ok)
+                break;
+        }
+
+        Py_DECREF(iterator);
+
+        return !PyErr_Occurred();
+    }
+
+    /* PySequence_Fast makes a copy of the list if iterable is the same
+     * object, so the list does not change under the loop below. */
+    fast = PySequence_Fast(iterable, "Argument must be iterable");
+    if (fast == NULL)
+        return 0;
+
+    len = PySequence_Fast_GET_SIZE(fast);
+    items = PySequence_Fast_ITEMS(fast);
+
+    for (i = 0; i < len; ++i)
+    {
+        int ok = left ?
+            ullist_insert_first(self, items[i]) :
+            ullist_insert_last(self, items[i]);
+
+        if (!ok)
+        {
+            Py_DECREF(fast);
+            return 0;
+        }
+    }
+
+    Py_DECREF(fast);
+
+    return 1;
+}
+
+/* Convenience function for formatting list to a string.
+ * Pass PyObject_Repr or PyObject_Str in the fmt_func argument. */
+static PyObject* ullist_to_string(ULListObject* self,
+                                  reprfunc fmt_func)
+{
+    PyObject* str = NULL;
+    PyObject* comma_str = NULL;
+    PyObject* tmp_str;
+    PyObject* value;
+    ULListChunk* chunk = self->first;
+    Py_ssize_t pos = 0;
+    Py_ssize_t index = 0;
+    Py_ssize_t state = self->state;
+
+    assert(fmt_func != NULL);
+
+    if (self->first == NULL)
+    {
+        str = Py23String_FromString("ullist()");
+        if (str == NULL)
+            goto str_alloc_error;
+        return str;
+    }
+
+    str = Py23String_FromString("ullist([");
+    if (str == NULL)
+        goto str_alloc_error;
+
+    comma_str = Py23String_FromString(", ");
+    if (comma_str == NULL)
+        goto str_alloc_error;
+
+    /* Formatting may run arbitrary code, which might modify the list,
+     * so the cursor is advanced with ullist_advance(). */
+    while (chunk != NULL)
+    {
+        if (index > 0)
+            Py23String_Concat(&str, comma_str);
+
+        value = ullist_item_get(self, chunk->items[chunk->start + pos]);
+        if (value == NULL)
+            goto str_alloc_error;
+
+        tmp_str = fmt_func(value);
+        Py_DECREF(value);
+        if (tmp_str == NULL)
+            goto str_alloc_error;
+        Py23String_ConcatAndDel(&str, tmp_str);
+
+        chunk = ullist_advance(self, chunk, &pos, ++index, &state);
+    }
+
+    Py_DECREF(comma_str);
+    comma_str = NULL;
+
+    tmp_str = Py23String_FromString("])");
+    if (tmp_str == NULL)
+        goto str_alloc_error;
+    Py23String_ConcatAndDel(&str, tmp_str);
+
+    return str;
+
+str_alloc_error:
+    Py_XDECREF(str);
+    Py_XDECREF(comma_str);
+    PyErr_SetString(PyExc_RuntimeError, "Failed to create string");
+    return NULL;
+}
+
+/* Convenience function for releasing all chunks and elements. */
+static void ullist_clear_internal(ULListObject* self)
+{
+    ULListChunk* chunk = self->first;
+
+    self->first = NULL;
+    self->last = NULL;
+    self->size = 0;
+    ++self->state;
+
+    while (chunk != NULL)
+    {
+        ULListChunk* next_chunk = chunk->next;
+        Py_ssize_t i;
+
+        for (i = chunk->start; i < chunk->start + chunk->count; ++i)
+            ullist_item_release(self, chunk->items[i]);
+
+        PyMem_Free(chunk);
+        chunk = next_chunk;
+    }
+}
+
+static void ullist_dealloc(ULListObject* self)
+{
+    if (self->weakref_list != NULL)
+        PyObject_ClearWeakRefs((PyObject*)self);
+
+    ullist_clear_internal(self);
+
+    PyObject_Del((PyObject*)self);
+}
+
+static PyObject* ullist_new(PyTypeObject* type,
+                            PyObject* args,
+                            PyObject* kwds)
+{
+    ULListObject* self;
+
+    self = (ULListObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->first = NULL;
+    self->last = NULL;
+    self->size = 0;
+    self->chunksize = ULLIST_DEFAULT_CHUNKSIZE;
+    self->state = 0;
+    self->typecode = 0;
+    self->weakref_list = NULL;
+
+    return (PyObject*)self;
+}
+
+static int ullist_init(ULListObject* self, PyObject* args, PyObject* kwds)
+{
+    static char* kwlist[] = { "iterable", "chunksize", "typecode", NULL };
+    PyObject* iterable = NULL;
+    Py_ssize_t chunksize = ULLIST_DEFAULT_CHUNKSIZE;
+    const char* typecode_str = NULL;
+    char typecode = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|Onz:ullist", kwlist,
+                                     &iterable, &chunksize, &typecode_str))
+        return -1;
+
+    if (chunksize < 2)
+    {
+        PyErr_SetString(PyExc_ValueError, "Chunk size must be at least 2");
+        return -1;
+    }
+
+    if (typecode_str != NULL)
+    {
+        if (strcmp(typecode_str, "q") != 0 && strcmp(typecode_str, "d") != 0)
+        {
+            PyErr_SetString(PyExc_ValueError,
+                "Typecode must be 'q', 'd' or None");
+            return -1;
+        }
+
+        typecode = typecode_str[0];
+    }
+
+    if (self->first != NULL && chunksize != self->chunksize)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot change chunk size of a non-empty list");
+        return -1;
+    }
+
+    if (self->first != NULL && typecode != self->typecode)
+    {
+        PyErr_SetString(PyExc_ValueError,
+            "Cannot change typecode of a non-empty list");
+        return -1;
+    }
+
+    self->chunksize = chunksize;
+    self->typecode = typecode;
+
+    if (iterable == NULL || iterable == Py_None)
+        return 0;
+
+    /* initialize list using passed iterable */
+    return ullist_extend_internal(self, iterable, 0) ? 0 : -1;
+}
+
+#ifdef Py23_HAVE_VECTORCALL
+/* Fast path for constructing lists from positional arguments.
+ * Keyword arguments are handled by ullist_init(). */
+static PyObject* ullist_vectorcall(PyObject* type,
+                                 PyObject* const* args,
+                                 size_t nargsf,
+                                 PyObject* kwnames)
+{
+    Py_ssize_t nargs = PyVectorcall_NARGS(nargsf);
+    PyObject* self;
+
+    if (kwnames != NULL || nargs > 1)
+        return Py23Type_VectorcallFallback(type, args, nargsf, kwnames);
+
+    self = ullist_new((PyTypeObject*)type, NULL, NULL);
+    if (self == NULL)
+        return NULL;
+
+    if (nargs == 1 && args[0] != Py_None &&
+        !ullist_extend_internal((ULListObject*)self, args[0], 0))
+    {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    return self;
+}
+#endif
+
+static PyObject* ullist_repr(ULListObject* self)
+{
+    return ullist_to_string(self, PyObject_Repr);
+}
+
+static PyObject* ullist_str(ULListObject* self)
+{
+    return ullist_to_string(self, PyObject_Str);
+}
+
+static long ullist_hash(ULListObject* self)
+{
+    long hash = 0;
+    ULListChunk* chunk = self->first;
+
+    while (chunk != NULL)
+    {
+        Py_ssize_t i;
+
+        for (i = chunk->start; i < chunk->start + chunk->count; ++i)
+        {
+            long obj_hash;
+            Py_ssize_t state = self->state;
+            PyObject* value = ullist_item_get(self, chunk->items[i]);
+
+            if (value == NULL)
+                return -1;
+
+            obj_hash = PyObject_Hash(value);
+            Py_DECREF(value);
+            if (obj_hash == -1)
+                return -1;
+
+            if (state != self->state)
+            {
+                PyErr_SetString(PyExc_RuntimeError,
+                    "ullist modified during hashing");
+                return -1;
+            }
+
+            hash ^= obj_hash;
+        }
+
+        chunk = chunk->next;
+    }
+
+    return hash;
+}
+
+static PyObject* ullist_richcompare(ULListObject* self,
+                                    ULListObject* other,
+                                    int op)
+{
+    ULListChunk* self_chunk;
+    ULListChunk* other_chunk;
+    Py_ssize_t self_pos = 0;
+    Py_ssize_t other_pos = 0;
+    Py_ssize_t self_state;
+    Py_ssize_t other_state;
+    Py_ssize_t index = 0;
+    PyObject* self_value = NULL;
+    PyObject* other_value = NULL;
+    int satisfied = 1;
+
+    if (!PyObject_TypeCheck(other, &ULListType))
+    {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+
+    if (self == other &&
+        (op == Py_EQ || op == Py_LE || op == Py_GE))
+        Py_RETURN_TRUE;
+
+    if (self->size != other->size)
+    {
+        if (op == Py_EQ)
+            Py_RETURN_FALSE;
+        else if (op == Py_NE)
+            Py_RETURN_TRUE;
+    }
+
+    /* Scan through sequences' items as long as they are equal.
+     * Comparisons may run arbitrary code, which might modify the lists,
+     * so cursors are advanced with ullist_advance(). */
+    self_chunk = self->first;
+    other_chunk = other->first;
+    self_state = self->state;
+    other_state = other->state;
+
+    while (self_chunk != NULL && other_chunk != NULL)
+    {
+        self_value = ullist_item_get(
+            self, self_chunk->items[self_chunk->start + self_pos]);
+        if (self_value == NULL)
+            return NULL;
+
+        other_value = ullist_item_get(
+            other, other_chunk->items[other_chunk->start + other_pos]);
+        if (other_value == NULL)
+        {
+            Py_DECREF(self_value);
+            return NULL;
+        }
+
+        satisfied = PyObject_RichCompareBool(self_value, other_value, Py_EQ);
+
+        if (satisfied == 0)
+            break;
+
+        Py_DECREF(self_value);
+        Py_DECREF(other_value);
+
+        if (satisfied == -1)
+            return NULL;
+
+        ++index;
+        self_chunk = ullist_advance(
+            self, self_chunk, &self_pos, index, &self_state);
+        other_chunk = ullist_advance(
+            other, other_chunk, &other_pos, index, &other_state);
+    }
+
+    /* Compare last item */
+    if (satisfied)
+    {
+        /* At least one of operands has been fully traversed. */
+        int self_done = (self_chunk == NULL);
+        int other_done = (other_chunk == NULL);
+
+        switch (op)
+        {
+        case Py_EQ:
+            satisfied = (self_done && other_done);
+            break;
+        case Py_NE:
+            satisfied = !(self_done && other_done);
+            break;
+        case Py_LT:
+            satisfied = !other_done;
+            break;
+        case Py_GT:
+            satisfied = !self_done;
+            break;
+        case Py_LE:
+            satisfied = self_done;
+            break;
+        case Py_GE:
+            satisfied = other_done;
+            break;
+        default:
+            assert(0 && "Invalid rich compare operator");
+            PyErr_SetString(PyExc_ValueError, "Invalid rich compare operator");
+            return NULL;
+        }
+    }
+    else
+    {
+        /* Both values are valid, but not equal */
+        if (op != Py_EQ)
+            satisfied = PyObject_RichCompareBool(self_value, other_value, op);
+
+        Py_DECREF(self_value);
+        Py_DECREF(other_value);
+
+        if (satisfied == -1)
+            return NULL;
+    }
+
+    if (satisfied)
+        Py_RETURN_TRUE;
+    else
+        Py_RETURN_FALSE;
+}
+
+static PyObject* ullist_appendleft(ULListObject* self, PyObject* arg)
+{
+    if (!ullist_insert_first(self, arg))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* ullist_appendright(ULListObject* self, PyObject* arg)
+{
+    if (!ullist_insert_last(self, arg))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* ullist_insert(ULListObject* self, Py23_FASTCALL_PARAMS)
+{
+    PyObject* val = NULL;
+    PyObject* indexObject = NULL;
+    Py_ssize_t index;
+
+    if (!Py23Args_Unpack("insert", Py23_FASTCALL_ARGS,
+                         1, 2, &val, &indexObject))
+        return NULL;
+
+    if (indexObject == NULL || indexObject == Py_None)
+    {
+        /* append item at the end of the list */
+        if (!ullist_insert_last(self, val))
+            return NULL;
+
+        Py_RETURN_NONE;
+    }
+
+    if (!Py23Int_Check(indexObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "Index must be an integer");
+        return NULL;
+    }
+
+    index = Py23Int_AsSsize_t(indexObject);
+    if (index == -1 && PyErr_Occurred())
+        return NULL;
+
+    if (index < 0)
+        index = self->size + index;
+
+    if (index < 0 || index > self->size)
+    {
+        PyErr_SetString(PyExc_IndexError, "Index out of range");
+        return NULL;
+    }
+
+    if (!ullist_insert_at(self, index, val))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* ullist_extendleft(ULListObject* self, PyObject* arg)
+{
+    if (!ullist_extend_internal(self, arg, 1))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* ullist_extendright(ULListObject* self, PyObject* arg)
+{
+    if (!ullist_extend_internal(self, arg, 0))
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* ullist_clear(ULListObject* self)
+{
+    ullist_clear_internal(self);
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* ullist_popleft(ULListObject* self)
+{
+    if (self->first == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    return ullist_item_unpack(self,
+        ullist_chunk_remove(self, self->first, 0));
+}
+
+static PyObject* ullist_popright(ULListObject* self)
+{
+    if (self->last == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    return ullist_item_unpack(self,
+        ullist_chunk_remove(self, self->last, self->last->count - 1));
+}
+
+static PyObject* ullist_remove(ULListObject* self, PyObject* arg)
+{
+    ULListChunk* chunk = self->first;
+    Py_ssize_t state = self->state;
+
+    while (chunk != NULL)
+    {
+        Py_ssize_t pos;
+
+        for (pos = 0; pos < chunk->count; ++pos)
+        {
+            PyObject* value;
+            int equal;
+
+            value = ullist_item_get(self, chunk->items[chunk->start + pos]);
+            if (value == NULL)
+                return NULL;
+
+            equal = PyObject_RichCompareBool(value, arg, Py_EQ);
+            Py_DECREF(value);
+
+            if (equal == -1)
+                return NULL;
+
+            if (state != self->state)
+            {
+                PyErr_SetString(PyExc_RuntimeError,
+                    "ullist modified during remove");
+                return NULL;
+            }
+
+            if (equal)
+            {
+                ullist_item_release(self,
+                    ullist_chunk_remove(self, chunk, pos));
+                Py_RETURN_NONE;
+            }
+        }
+
+        chunk = chunk->next;
+    }
+
+    PyErr_SetString(PyExc_ValueError, "Value not found");
+    return NULL;
+}
+
+static PyObject* ullist_rotate(ULListObject* self, PyObject* nObject)
+{
+    Py_ssize_t n;
+    Py_ssize_t split_idx;
+    Py_ssize_t n_mod;
+    Py_ssize_t pos = 0;
+    ULListChunk* new_first;
+    ULListChunk* new_last;
+
+    if (self->size <= 1)
+        Py_RETURN_NONE;
+
+    if (!Py23Int_Check(nObject))
+    {
+        PyErr_SetString(PyExc_TypeError, "n must be an integer");
+        return NULL;
+    }
+
+    n = Py23Int_AsSsize_t(nObject);
+    n_mod = py_ssize_t_abs(n) % self->size;
+
+    if (n_mod == 0)
+        Py_RETURN_NONE; /* no-op */
+
+    if (n > 0)
+        split_idx = self->size - n_mod; /* rotate right */
+    else
+        split_idx = n_mod;  /* rotate left */
+
+    new_first = ullist_locate(self, split_idx, &pos);
+    assert(new_first != NULL);
+
+    if (pos > 0)
+    {
+        /* split chunk at the rotation point */
+        ULListChunk* tail = ullistchunk_new(self, 0);
+        if (tail == NULL)
+            return NULL;
+
+        tail->count = new_first->count - pos;
+        memcpy(tail->items, new_first->items + new_first->start + pos,
+            tail->count * sizeof(ULListItem));
+        new_first->count = pos;
+
+        ullist_link_chunk(self, tail, new_first);
+        new_first = tail;
+    }
+
+    new_last = new_first->prev;
+
+    /* relink chunks into a ring and cut it before new_first */
+    self->first->prev = self->last;
+    self->last->next = self->first;
+
+    new_first->prev = NULL;
+    new_last->next = NULL;
+
+    self->first = new_first;
+    self->last = new_last;
+
+    ++self->state;
+
+    Py_RETURN_NONE;
+}
+
+/* Convenience function for summing values of a 'd' list chunk.
+ * Independent accumulators let the additions overlap in the pipeline
+ * and be vectorized by the compiler. */
+static double ullist_chunk_sum_d(const ULListItem* items, Py_ssize_t count)
+{
+    double s0 = 0.0;
+    double s1 = 0.0;
+    double s2 = 0.0;
+    double s3 = 0.0;
+    Py_ssize_t i;
+
+    for (i = 0; i + 4 <= count; i += 4)
+    {
+        s0 += items[i].d;
+        s1 += items[i + 1].d;
+        s2 += items[i + 2].d;
+        s3 += items[i + 3].d;
+    }
+
+    for (; i < count; ++i)
+        s0 += items[i].d;
+
+    return (s0 + s1) + (s2 + s3);
+}
+
+/* Convenience function for summing values of a 'q' list chunk.
+ * Partial sums are passed to the accumulator before they overflow. */
+static int ullist_chunk_sum_q(const ULListItem* items,
+                              Py_ssize_t count,
+                              LListSum* sum)
+{
+    PY_LONG_LONG partial = 0;
+    Py_ssize_t i;
+
+    for (i = 0; i < count; ++i)
+    {
+        PY_LONG_LONG value = items[i].q;
+
+        if ((value > 0 && partial > PY_LLONG_MAX - value) ||
+            (value < 0 && partial < PY_LLONG_MIN - value))
+        {
+            if (!llist_sum_add_int64(sum, partial))
+                return 0;
+            partial = 0;
+        }
+
+        partial += value;
+    }
+
+    return llist_sum_add_int64(sum, partial);
+}
+
+/* Convenience function for summing elements. The method name
+ * is used in error messages. */
+static PyObject* ullist_sum_internal(ULListObject* self, const char* method)
+{
+    ULListChunk* chunk;
+    Py_ssize_t state = self->state;
+    LListSum sum;
+
+    llist_sum_init(&sum);
+
+    for (chunk = self->first; chunk != NULL; chunk = chunk->next)
+    {
+        ULListItem* items = chunk->items + chunk->start;
+        Py_ssize_t i;
+
+        if (self->typecode == 'd')
+        {
+            if (!llist_sum_add_double(&sum,
+                    ullist_chunk_sum_d(items, chunk->count)))
+                goto error;
+            continue;
+        }
+
+        if (self->typecode == 'q')
+        {
+            if (!ullist_chunk_sum_q(items, chunk->count, &sum))
+                goto error;
+            continue;
+        }
+
+        /* Adding objects may run arbitrary code, which might modify
+         * the list. */
+        for (i = 0; i < chunk->count; ++i)
+        {
+            if (!llist_sum_add(&sum, items[i].object))
+                goto error;
+
+            if (state != self->state)
+            {
+                PyErr_Format(PyExc_RuntimeError,
+                    "ullist modified during %s()", method);
+                goto error;
+            }
+        }
+    }
+
+    return llist_sum_result(&sum);
+
+error:
+    llist_sum_clear(&sum);
+    return NULL;
+}
+
+static PyObject* ullist_sum(ULListObject* self)
+{
+    return ullist_sum_internal(self, "sum");
+}
+
+static PyObject* ullist_mean(ULListObject* self)
+{
+    Py_ssize_t count = self->size;
+
+    return llist_mean(ullist_sum_internal(self, "mean"), count);
+}
+
+/* Convenience function for finding the smallest (op == Py_LT)
+ * or the largest (op == Py_GT) element. Values of typed lists
+ * are compared as C values. */
+static PyObject* ullist_extremum(ULListObject* self,
+                                 int op,
+                                 const char* method)
+{
+    ULListChunk* chunk;
+    Py_ssize_t state = self->state;
+    LListExtremum ext;
+    ULListItem best;
+
+    if (self->first == NULL)
+    {
+        PyErr_SetString(PyExc_ValueError, "List is empty");
+        return NULL;
+    }
+
+    best = self->first->items[self->first->start];
+
+    if (self->typecode == 'q' || self->typecode == 'd')
+    {
+        for (chunk = self->first; chunk != NULL; chunk = chunk->next)
+        {
+            ULListItem* items = chunk->items + chunk->start;
+            Py_ssize_t i;
+
+            if (self->typecode == 'q' && op == Py_LT)
+            {
+                for (i = 0; i < chunk->count; ++i)
+                    best.q = (items[i].q < best.q) ? items[i].q : best.q;
+            }
+            else if (self->typecode == 'q')
+            {
+                for (i = 0; i < chunk->count; ++i)
+                    best.q = (items[i].q > best.q) ? items[i].q : best.q;
+            }
+            else if (op == Py_LT)
+            {
+                for (i = 0; i < chunk->count; ++i)
+                    best.d = (items[i].d < best.d) ? items[i].d : best.d;
+            }
+            else
+            {
+                for (i = 0; i < chunk->count; ++i)
+                    best.d = (items[i].d > best.d) ? items[i].d : best.d;
+            }
+        }
+
+        return ullist_item_get(self, best);
+    }
+
+    llist_extremum_init(&ext, op);
+
+    for (chunk = self->first; chunk != NULL; chunk = chunk->next)
+    {
+        Py_ssize_t i;
+
+        /* Comparisons may run arbitrary code, which might modify
+         * the list. */
+        for (i = chunk->start; i < chunk->start + chunk->count; ++i)
+        {
+            if (!llist_extremum_update(&ext, chunk->items[i].object))
+            {
+                llist_extremum_clear(&ext);
+                return NULL;
+            }
+
+            if (state != self->state)
+            {
+                llist_extremum_clear(&ext);
+                PyErr_Format(PyExc_RuntimeError,
+                    "ullist modified during %s()", method);
+                return NULL;
+            }
+        }
+    }
+
+    return llist_extremum_result(&ext);
+}
+
+static PyObject* ullist_min(ULListObject* self)
+{
+    return ullist_extremum(self, Py_LT, "min");
+}
+
+static PyObject* ullist_max(ULListObject* self)
+{
+    return ullist_extremum(self, Py_GT, "max");
+}
+
+static PyObject* ullist_iter(PyObject* self)
+{
+    return ullistiterator_create(&ULListIteratorType, self);
+}
+
+static Py_ssize_t ullist_len(PyObject* self)
+{
+    ULListObject* list = (ULListObject*)self;
+    return list->size;
+}
+
+static PyObject* ullist_concat(PyObject* self, PyObject* other)
+{
+    ULListObject* new_list;
+
+    new_list = (ULListObject*)ullist_new(&ULListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
+
+    new_list->chunksize = ((ULListObject*)self)->chunksize;
+    new_list->typecode = ((ULListObject*)self)->typecode;
+
+    if (!ullist_extend_internal(new_list, self, 0) ||
+        !ullist_extend_internal(new_list, other, 0))
+    {
+        Py_DECREF(new_list);
+        return NULL;
+    }
+
+    return (PyObject*)new_list;
+}
+
+static PyObject* ullist_inplace_concat(PyObject* self, PyObject* other)
+{
+    if (!ullist_extend_internal((ULListObject*)self, other, 0))
+        return NULL;
+
+    Py_INCREF(self);
+    return self;
+}
+
+static PyObject* ullist_repeat(PyObject* self, Py_ssize_t count)
+{
+    ULListObject* new_list;
+    Py_ssize_t i;
+
+    new_list = (ULListObject*)ullist_new(&ULListType, NULL, NULL);
+    if (new_list == NULL)
+        return NULL;
+
+    new_list->chunksize = ((ULListObject*)self)->chunksize;
+    new_list->typecode = ((ULListObject*)self)->typecode;
+
+    for (i = 0; i < count; ++i)
+    {
+        if (!ullist_extend_internal(new_list, self, 0))
+        {
+            Py_DECREF(new_list);
+            return NULL;
+        }
+    }
+
+    return (PyObject*)new_list;
+}
+
+static PyObject* ullist_get_item(PyObject* self, Py_ssize_t index)
+{
+    ULListChunk* chunk;
+    Py_ssize_t pos;
+
+    chunk = ullist_locate((ULListObject*)self, index, &pos);
+    if (chunk == NULL)
+        return NULL;
+
+    return ullist_item_get((ULListObject*)self,
+        chunk->items[chunk->start + pos]);
+}
+
+static int ullist_set_item(PyObject* self, Py_ssize_t index, PyObject* val)
+{
+    ULListObject* list = (ULListObject*)self;
+    ULListChunk* chunk;
+    Py_ssize_t pos;
+    ULListItem item;
+    ULListItem olditem;
+
+    /* Here is a tricky (and undocumented) part of sequence protocol.
+     * Python will pass NULL as item value when item is deleted with:
+     * del list[index] */
+    if (val == NULL)
+    {
+        chunk = ullist_locate(list, index, &pos);
+        if (chunk == NULL)
+            return -1;
+
+        ullist_item_release(list, ullist_chunk_remove(list, chunk, pos));
+        return 0;
+    }
+
+    /* The rest of this function handles normal assignment:
+     * list[index] = item
+     * Converting the value may run arbitrary code, so it is done
+     * before the element is located. */
+    if (!ullist_item_pack(list, val, &item))
+        return -1;
+
+    chunk = ullist_locate(list, index, &pos);
+    if (chunk == NULL)
+    {
+        ullist_item_release(list, item);
+        return -1;
+    }
+
+    olditem = chunk->items[chunk->start + pos];
+    chunk->items[chunk->start + pos] = item;
+    ullist_item_release(list, olditem);
+
+    return 0;
+}
+
+static PyObject* ullist_get_typecode(ULListObject* self)
+{
+    char typecode[2];
+
+    if (self->typecode == 0)
+        Py_RETURN_NONE;
+
+    typecode[0] = self->typecode;
+    typecode[1] = '\0';
+
+    return Py23String_FromString(typecode);
+}
+
+static PyMethodDef ULListMethods[] =
+{
+    { "appendleft", (PyCFunction)ullist_appendleft, METH_O,
+      "Append element at the beginning of the list" },
+    { "append", (PyCFunction)ullist_appendright, METH_O,
+      "Append element at the end of the list" },
+    { "appendright", (PyCFunction)ullist_appendright, METH_O,
+      "Append element at the end of the list" },
+    { "clear", (PyCFunction)ullist_clear, METH_NOARGS,
+      "Remove all elements from the list" },
+    { "extend", (PyCFunction)ullist_extendright, METH_O,
+      "Append elements from iterable at the right side of the list" },
+    { "extendleft", (PyCFunction)ullist_extendleft, METH_O,
+      "Append elements from iterable at the left side of the list" },
+    { "extendright", (PyCFunction)ullist_extendright, METH_O,
+      "Append elements from iterable at the right side of the list" },
+    { "insert", (PyCFunction)ullist_insert, Py23_METH_FASTCALL,
+      "Inserts element before index" },
+    { "max", (PyCFunction)ullist_max, METH_NOARGS,
+      "Return the largest element of the list" },
+    { "mean", (PyCFunction)ullist_mean, METH_NOARGS,
+      "Return the arithmetic mean of elements of the list" },
+    { "min", (PyCFunction)ullist_min, METH_NOARGS,
+      "Return the smallest element of the list" },
+    { "popleft", (PyCFunction)ullist_popleft, METH_NOARGS,
+      "Remove first element from the list and return it" },
+    { "pop", (PyCFunction)ullist_popright, METH_NOARGS,
+      "Remove last element from the list and return it" },
+    { "popright", (PyCFunction)ullist_popright, METH_NOARGS,
+      "Remove last element from the list and return it" },
+    { "remove", (PyCFunction)ullist_remove, METH_O,
+      "Remove first occurrence of value from the list" },
+    { "rotate", (PyCFunction)ullist_rotate, METH_O,
+      "Rotate the list n steps to the right" },
+    { "sum", (PyCFunction)ullist_sum, METH_NOARGS,
+      "Return the sum of elements of the list" },
+    { NULL },   /* sentinel */
+};
+
+static PyMemberDef ULListMembers[] =
+{
+    { "size", T_PYSSIZET, offsetof(ULListObject, size), READONLY,
+      "Number of elements in the list" },
+    { "chunksize", T_PYSSIZET, offsetof(ULListObject, chunksize), READONLY,
+      "Maximum number of elements stored in a single chunk" },
+    { NULL },   /* sentinel */
+};
+
+static PyGetSetDef ULListGetSetters[] =
+{
+    { "typecode", (getter)ullist_get_typecode, NULL,
+      "Type of values stored in the list ('q', 'd' or None)", NULL },
+    { NULL },   /* sentinel */
+};
+
+static PySequenceMethods ULListSequenceMethods =
+{
+    ullist_len,                 /* sq_length */
+    ullist_concat,              /* sq_concat */
+    ullist_repeat,              /* sq_repeat */
+    ullist_get_item,            /* sq_item */
+    0,                          /* sq_slice */
+    ullist_set_item,            /* sq_ass_item */
+    0,                          /* sq_ass_slice */
+    0,                          /* sq_contains */
+    ullist_inplace_concat,      /* sq_inplace_concat */
+    0,                          /* sq_inplace_repeat */
+};
+
+static PyTypeObject ULListType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "llist.ullist",             /* tp_name */
+    sizeof(ULListObject),       /* tp_basicsize */
+    0,                          /* tp_itemsize */
+    (destructor)ullist_dealloc, /* tp_dealloc */
+    0,                          /* tp_print */
+    0,                          /* tp_getattr */
+    0,                          /* tp_setattr */
+    0,                          /* tp_compare */
+    (reprfunc)ullist_repr,      /* tp_repr */
+    0,                          /* tp_as_number */
+    &ULListSequenceMethods,     /* tp_as_sequence */
+    0,                          /* tp_as_mapping */
+    (hashfunc)ullist_hash,      /* tp_hash */
+    0,                          /* tp_call */
+    (reprfunc)ullist_str,       /* tp_str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+    0,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,         /* tp_flags */
+    "Unrolled linked list",     /* tp_doc */
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    (richcmpfunc)ullist_richcompare,
+                                /* tp_richcompare */
+    offsetof(ULListObject, weakref_list),
+                                /* tp_weaklistoffset */
+    ullist_iter,                /* tp_iter */
+    0,                          /* tp_iternext */
+    ULListMethods,              /* tp_methods */
+    ULListMembers,              /* tp_members */
+    ULListGetSetters,           /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    (initproc)ullist_init,      /* tp_init */
+    0,                          /* tp_alloc */
+    ullist_new,                 /* tp_new */
+};
+
+
+/* ULListIterator */
+
+typedef struct
+{
+    PyObject_HEAD
+    ULListObject* list;
+    ULListChunk* chunk;
+    Py_ssize_t pos;
+    Py_ssize_t index;
+    Py_ssize_t state;
+} ULListIteratorObject;
+
+static void ullistiterator_dealloc(ULListIteratorObject* self)
+{
+    Py_DECREF(self->list);
+
+    PyObject_Del((PyObject*)self);
+}
+
+static PyObject* ullistiterator_create(PyTypeObject* type,
+                                       PyObject* owner_list)
+{
+    ULListIteratorObject* self;
+
+    self = (ULListIteratorObject*)type->tp_alloc(type, 0);
+    if (self == NULL)
+        return NULL;
+
+    self->list = (ULListObject*)owner_list;
+    self->chunk = self->list->first;
+    self->pos = 0;
+    self->index = 0;
+    self->state = self->list->state;
+
+    Py_INCREF(self->list);
+
+    return (PyObject*)self;
+}
+
+static PyObject* ullistiterator_new(PyTypeObject* type,
+                                    PyObject* args,
+                                    PyObject* kwds)
+{
+    PyObject* owner_list = NULL;
+
+    if (!PyArg_UnpackTuple(args, "__new__", 1, 1, &owner_list))
+        return NULL;
+
+    if (!PyObject_TypeCheck(owner_list, &ULListType))
+    {
+        PyErr_SetString(PyExc_TypeError, "ullist argument expected");
+        return NULL;
+    }
+
+    return ullistiterator_create(type, owner_list);
+}
+
+static PyObject* ullistiterator_iternext(PyObject* self)
+{
+    ULListIteratorObject* iter_self = (ULListIteratorObject*)self;
+    ULListChunk* chunk = iter_self->chunk;
+    PyObject* value;
+
+    if (iter_self->state != iter_self->list->state)
+    {
+        /* Elements were moved since the last step.
+         * Find the next element again using its index. */
+        chunk = ullist_advance(iter_self->list, chunk, &iter_self->pos,
+            iter_self->index, &iter_self->state);
+    }
+
+    if (chunk == NULL)
+    {
+        iter_self->chunk = NULL;
+        PyErr_SetNone(PyExc_StopIteration);
+        return NULL;
+    }
+
+    value = ullist_item_get(iter_self->list,
+        chunk->items[chunk->start + iter_self->pos]);
+    if (value == NULL)
+        return NULL;
+
+    ++iter_self->index;
+    iter_self->chunk = ullist_advance(iter_self->list, chunk,
+        &iter_self->pos, iter_self->index, &iter_self->state);
+
+    return value;
+}
+
+static PyTypeObject ULListIteratorType =
+{
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "llist.ullistiterator",             /* tp_name */
+    sizeof(ULListIteratorObject),       /* tp_basicsize */
+    0,                                  /* tp_itemsize */
+    (destructor)ullistiterator_dealloc, /* tp_dealloc */
+    0,                                  /* tp_print */
+    0,                                  /* tp_getattr */
+    0,                                  /* tp_setattr */
+    0,                                  /* tp_compare */
+    0,                                  /* tp_repr */
+    0,                                  /* tp_as_number */
+    0,                                  /* tp_as_sequence */
+    0,                                  /* tp_as_mapping */
+    0,                                  /* tp_hash */
+    0,                                  /* tp_call */
+    0,                                  /* tp_str */
+    0,                                  /* tp_getattro */
+    0,                                  /* tp_setattro */
+    0,                                  /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                 /* tp_flags */
+    "Unrolled linked list iterator",    /* tp_doc */
+    0,                                  /* tp_traverse */
+    0,                                  /* tp_clear */
+    0,                                  /* tp_richcompare */
+    0,                                  /* tp_weaklistoffset */
+    PyObject_SelfIter,                  /* tp_iter */
+    ullistiterator_iternext,            /* tp_iternext */
+    0,                                  /* tp_methods */
+    0,                                  /* tp_members */
+    0,                                  /* tp_getset */
+    0,                                  /* tp_base */
+    0,                                  /* tp_dict */
+    0,                                  /* tp_descr_get */
+    0,                                  /* tp_descr_set */
+    0,                                  /* tp_dictoffset */
+    0,                                  /* tp_init */
+    0,                                  /* tp_alloc */
+    ullistiterator_new,                 /* tp_new */
+};
+
+
+int ullist_init_type(void)
+{
+#ifdef Py23_HAVE_VECTORCALL
+    ULListType.tp_vectorcall = ullist_vectorcall;
+#endif
+
+    return
+        ((PyType_Ready(&ULListType) == 0) &&
+         (PyType_Ready(&ULListIteratorType) == 0))
+        ? 1 : 0;
+}
+
+void ullist_register(PyObject* module)
+{
+    Py_INCREF(&ULListType);
+    Py_INCREF(&ULListIteratorType);
+
+    PyModule_AddObject(module, "ullist", (PyObject*)&ULListType);
+    PyModule_AddObject(module, "ullistiterator", (PyObject*)&ULListIteratorType);
+}
@@ -0,0 +1,11 @@
+/* Copyright (c) 2011-2013 Adam Jakubek, Rafał Gałczyński
+ * Released under the MIT license (see attached LICENSE file).
+ */
+
+#ifndef ULLIST_H
+#define ULLIST_H
+
+int        ullist_init_type(void);
+void       ullist_register(PyObject* module);
+
+#endif /* ULLIST_H */
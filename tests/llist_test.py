@@ -2,11 +2,15 @@
 # -*- coding: utf-8 -*-
 import gc
 import sys
+import time
 import unittest
+import llist
 from llist import sllist
 from llist import sllistnode
 from llist import dllist
 from llist import dllistnode
+from llist import ullist
+from llist import lrucache
 
 gc.set_debug(gc.DEBUG_UNCOLLECTABLE | gc.DEBUG_STATS)
 
@@ -58,12 +62,33 @@ class testsllist(unittest.TestCase):
         self.assertRaises(TypeError, sllist, 1)
         self.assertRaises(TypeError, sllist, 1.5)
 
+    def test_init_with_iterable(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(x for x in ref)
+        self.assertEqual(len(ll), len(ref))
+        self.assertEqual(list(ll), ref)
+        self.assertEqual(list(sllist(iter(ref))), ref)
+        self.assertEqual(list(sllist(tuple(ref))), ref)
+        self.assertEqual(list(sllist('abc')), ['a', 'b', 'c'])
+        self.assertEqual(sorted(sllist(set([1, 2, 3]))), [1, 2, 3])
+
     def test_str(self):
         a = sllist([])
         self.assertEqual(str(a), 'sllist()')
         b = sllist([None, 1, 'abc'])
         self.assertEqual(str(b), 'sllist([None, 1, abc])')
 
+    def test_call_arguments(self):
+        self.assertEqual(sllistnode(1).value, 1)
+        self.assertEqual(sllistnode().value, None)
+        self.assertRaises(TypeError, sllistnode, 1, 2)
+        self.assertRaises(TypeError, sllist, [1], 2, 3, 4)
+        ll = sllist([1, 2])
+        self.assertEqual(list(ll), [1, 2])
+        self.assertRaises(TypeError, ll.insertbefore)
+        self.assertRaises(TypeError, ll.insertbefore, 1, ll.first, 2)
+        self.assertRaises(TypeError, ll.splice)
+
     def test_repr(self):
         a = sllist([])
         self.assertEqual(repr(a), 'sllist()')
@@ -250,6 +275,26 @@ class testsllist(unittest.TestCase):
             idx += 1
         self.assertEqual(idx, len(ref))
 
+    def test_iter_with_modification(self):
+        ll = sllist(py23_range(0, 16))
+        result = []
+        for val in ll:
+            result.append(val)
+            if val == 5:
+                ll[10] = sllistnode('x')
+                ll.nodeat(11).value = 'y'
+        self.assertEqual(result, [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 'x', 'y',
+                                  12, 13, 14, 15])
+        it = iter(ll)
+        self.assertEqual(next(it), 0)
+        ll.appendleft(-1)
+        self.assertRaises(RuntimeError, next, it)
+        self.assertRaises(StopIteration, next, it)
+        it = iter(ll)
+        self.assertEqual(list(it), list(ll))
+        ll.clear()
+        self.assertRaises(StopIteration, next, it)
+
     def test_iter_empty(self):
         ll = sllist()
         count = 0
@@ -274,6 +319,62 @@ class testsllist(unittest.TestCase):
             count += 1
         self.assertEqual(count, 0)
 
+    def test_iternodes(self):
+        ref = py23_range(0, 100)
+        ll = sllist(ref)
+        nodes = list(ll.iternodes())
+        self.assertEqual([node.value for node in nodes], ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertTrue(nodes[idx] is ll.nodeat(idx))
+        for node in ll.iternodes():
+            if node.value % 2:
+                ll.remove(node)
+        self.assertEqual(list(ll), ref[::2])
+        self.assertEqual(list(sllist().iternodes()), [])
+
+    def test_iternodes_modified(self):
+        def iterate(ll, modify):
+            values = []
+            for node in ll.iternodes():
+                values.append(node.value)
+                if node.value == 2:
+                    modify(ll, node)
+            return values
+
+        # the returned node may be removed and values may be replaced
+        ll = sllist([1, 2, 3, 4])
+        self.assertEqual(iterate(ll, lambda ll, node: ll.remove(node)),
+                         [1, 2, 3, 4])
+        self.assertEqual(list(ll), [1, 3, 4])
+        ll = sllist([1, 2, 3, 4])
+        self.assertEqual(
+            iterate(ll, lambda ll, node: setattr(node.next, 'value', 30)),
+            [1, 2, 30, 4])
+
+        # other modifications are reported
+        ll = sllist([1, 2, 3, 4])
+        self.assertRaises(RuntimeError, iterate, ll,
+                          lambda ll, node: ll.remove(node.next))
+        self.assertEqual(list(ll), [1, 2, 4])
+        self.assertRaises(RuntimeError, iterate, sllist([1, 2, 3, 4]),
+                          lambda ll, node: ll.clear())
+        self.assertRaises(RuntimeError, iterate, sllist([1, 2, 3, 4]),
+                          lambda ll, node: ll.append(5))
+        self.assertRaises(RuntimeError, iterate, sllist([1, 2, 3, 4]),
+                          lambda ll, node: (ll.remove(node), ll.pop()))
+        other = sllist()
+        self.assertRaises(RuntimeError, iterate, sllist([1, 2, 3, 4]),
+                          lambda ll, node: other.splice(ll.split_after(node)))
+        self.assertEqual(list(other), [3, 4])
+
+        # iterator stays exhausted after an error
+        ll = sllist([1, 2, 3, 4])
+        it = ll.iternodes()
+        next(it)
+        ll.appendleft(0)
+        self.assertRaises(RuntimeError, next, it)
+        self.assertRaises(StopIteration, next, it)
+
     def test_append_left(self):
         ll = sllist([1, 2, 3, 4])
         ll.appendleft(5)
@@ -439,6 +540,27 @@ class testsllist(unittest.TestCase):
         self.assertEqual(a, sllist(a_ref + a_ref))
         self.assertEqual(len(a), len(a_ref) * 2)
 
+    def test_extend_with_iterable(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(ref)
+        ll.extend(x * 2 for x in ref)
+        ll.extendleft(iter('ab'))
+        ref = ['b', 'a'] + ref + [x * 2 for x in ref]
+        self.assertEqual(list(ll), ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+
+        def failing():
+            yield 1
+            yield 2
+            raise KeyError()
+        ll = sllist([0])
+        self.assertRaises(KeyError, ll.extend, failing())
+        self.assertEqual(list(ll), [0, 1, 2])
+        self.assertRaises(TypeError, ll.extend, 1)
+        self.assertRaises(TypeError, ll.extendleft, None)
+        self.assertEqual(list(ll), [0, 1, 2])
+
     def test_extend_empty(self):
         filled_ref = py23_range(0, 1024, 4)
         filled = sllist(filled_ref)
@@ -613,6 +735,55 @@ class testsllist(unittest.TestCase):
         ll.remove(node)
         self.assertRaises(ValueError, ll.remove, node)
 
+    def test_remove_popped_node(self):
+        ll = sllist([1, 2, 3, 4])
+        first = ll.first
+        last = ll.last
+        ll.popleft()
+        ll.popright()
+        self.assertRaises(ValueError, ll.remove, first)
+        self.assertRaises(ValueError, ll.remove, last)
+        self.assertEqual(list(ll), [2, 3])
+        ll.clear()
+        self.assertRaises(ValueError, ll.remove, first)
+
+    def test_remove_node_of_destroyed_list(self):
+        node = sllist([1, 2, 3]).nodeat(1)
+        self.assertEqual(node.value, 2)
+        self.assertEqual(node.next, None)
+        ll = sllist([1, 2, 3])
+        self.assertRaises(ValueError, ll.remove, node)
+        self.assertEqual(len(ll), 3)
+
+    def test_node_identity(self):
+        ll = sllist([1, 2, 3])
+        node = ll.nodeat(1)
+        self.assertTrue(ll.first is ll.first)
+        self.assertTrue(ll.first.next is node)
+        self.assertTrue(ll.nodeat(-2) is node)
+        self.assertTrue(node.next is ll.last)
+        node.value = 5
+        self.assertEqual(list(ll), [1, 5, 3])
+
+    def test_detached_node_keeps_value(self):
+        ll = sllist([1, 2, 3])
+        node = ll.nodeat(1)
+        del ll[1]
+        self.assertEqual(node.value, 2)
+        self.assertEqual(node.next, None)
+        node.value = 4
+        self.assertEqual(node(), 4)
+        ll.append(node)
+        self.assertEqual(list(ll), [1, 3, 4])
+        self.assertFalse(ll.last is node)
+
+    def test_remove_node_of_other_list(self):
+        ll = sllist([1, 2, 3])
+        other = sllist([1, 2, 3])
+        self.assertRaises(ValueError, ll.remove, other.first)
+        self.assertEqual(len(ll), 3)
+        self.assertEqual(len(other), 3)
+
     def test_rotate_left(self):
         for n in py23_xrange(128):
             ref = py23_range(32)
@@ -803,12 +974,402 @@ class testsllist(unittest.TestCase):
         ll = sllistnode()
         self.assertRaises(expected_error, setattr, ll, 'next', None)
 
+    def test_pop_and_remove_keep_nodes(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(ref)
+        nodes = [ll.nodeat(i) for i in py23_xrange(0, len(ref), 10)]
+        for i in py23_xrange(0, len(ref), 3):
+            ll.remove(ll.nodeat(i // 3))
+            del ref[i // 3]
+            node = ll.insertbefore('x', ll.nodeat(i // 2))
+            ref.insert(i // 2, 'x')
+            self.assertEqual(node.value, 'x')
+            self.assertEqual(node.next.value, ref[i // 2 + 1])
+            self.assertEqual(ll.pop(), ref.pop())
+            ll.append(-i - 1)
+            ref.append(-i - 1)
+        self.assertEqual(list(ll), ref)
+        for node in nodes:
+            if node.value in ref:
+                idx = ref.index(node.value)
+                self.assertTrue(ll.nodeat(idx) is node)
+        while ref:
+            self.assertEqual(ll.popright(), ref.pop())
+        self.assertEqual(len(ll), 0)
+
+    def test_pop_after_remove_is_constant_time(self):
+        def alternate(size):
+            ref = py23_range(0, size)
+            ll = sllist(ref)
+            ll.pop()
+            ref.pop()
+            popped = []
+            start = time.time()
+            for i in py23_xrange(500):
+                ll.remove(ll.nodeat(5))
+                del ll[7]
+                popped.append(ll.pop())
+            elapsed = time.time() - start
+            for i in py23_xrange(500):
+                del ref[5]
+                del ref[7]
+                self.assertEqual(popped[i], ref.pop())
+            self.assertEqual(list(ll), ref)
+            return elapsed
+        small = min(alternate(2000) for i in py23_xrange(3))
+        large = min(alternate(200000) for i in py23_xrange(3))
+        # a scan from the head of the list on each pop() makes the large
+        # list about 100 times slower
+        self.assertTrue(large < 20 * small + 0.01)
+
+    def test_sequential_access(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(ref)
+        for idx in py23_xrange(0, len(ref), 3):
+            self.assertEqual(ll[idx], ref[idx])
+            ll.insertafter(idx, ll.nodeat(idx))
+            ref.insert(idx + 1, idx)
+            ll.appendleft(-idx)
+            ref.insert(0, -idx)
+            self.assertEqual(ll.popleft(), ref.pop(0))
+            ll.append(idx)
+            ref.append(idx)
+            del ll[idx + 2]
+            del ref[idx + 2]
+        self.assertEqual(list(ll), ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        ll.remove(ll.nodeat(10))
+        del ref[10]
+        ll.insertbefore('abc', ll.nodeat(3))
+        ref.insert(3, 'abc')
+        ll.rotate(5)
+        ref = ref[-5:] + ref[:-5]
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+
+    def test_getitem_slice(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(ref)
+        for s in [slice(None), slice(10, 20), slice(-30, -5, 3),
+                  slice(None, None, -1), slice(200, 10, -7),
+                  slice(300, 400), slice(5, 5), slice(20, 10)]:
+            sl = ll[s]
+            self.assertTrue(isinstance(sl, sllist))
+            self.assertEqual(list(sl), ref[s])
+        self.assertEqual(list(ll), ref)
+        self.assertRaises(ValueError, ll.__getitem__, slice(0, 10, 0))
+
+    def test_delitem_slice(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(ref)
+        node = ll.nodeat(50)
+        for s in [slice(10, 20), slice(-30, -5, 3), slice(200, 10, -7),
+                  slice(5, 5), slice(0, 1), slice(1, 150)]:
+            del ll[s]
+            del ref[s]
+            self.assertEqual(list(ll), ref)
+        self.assertEqual(node.value, 200)
+        self.assertEqual(node.next, None)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        del ll[:]
+        self.assertEqual(len(ll), 0)
+
+    def test_setitem_slice(self):
+        ref = py23_range(0, 1024, 4)
+        ll = sllist(ref)
+        ll[10:20] = ['a', 'b']
+        ref[10:20] = ['a', 'b']
+        self.assertEqual(list(ll), ref)
+        ll[5:5] = sllist(['c', 'd', 'e'])
+        ref[5:5] = ['c', 'd', 'e']
+        self.assertEqual(list(ll), ref)
+        ll[::-5] = py23_range(len(ref[::-5]))
+        ref[::-5] = py23_range(len(ref[::-5]))
+        self.assertEqual(list(ll), ref)
+        ll[1:3] = ll
+        ref[1:3] = ref[:]
+        self.assertEqual(list(ll), ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        self.assertRaises(ValueError, ll.__setitem__,
+            slice(None, None, 2), [1, 2, 3])
+        self.assertRaises(TypeError, ll.__setitem__, slice(1, 2), None)
+
+    def test_splice(self):
+        a_ref = py23_range(0, 100)
+        b_ref = py23_range(100, 200)
+        a = sllist(a_ref)
+        b = sllist(b_ref)
+        nodes = [b.nodeat(i) for i in py23_xrange(0, 100, 9)]
+        before = a.nodeat(40)
+        a.splice(b, before)
+        a_ref[40:40] = b_ref
+        self.assertEqual(list(a), a_ref)
+        self.assertEqual(len(b), 0)
+        self.assertEqual(b.first, None)
+        self.assertEqual(before.value, 40)
+        self.assertEqual(a.nodeat(140), before)
+        for node in nodes:
+            self.assertTrue(a.nodeat(a_ref.index(node.value)) is node)
+        a.splice(sllist(['x']), a.first)
+        a.splice(sllist(['y', 'z']))
+        a.splice(sllist())
+        a_ref = ['x'] + a_ref + ['y', 'z']
+        self.assertEqual(list(a), a_ref)
+        self.assertEqual(a.last.value, 'z')
+        for idx in py23_xrange(len(a_ref)):
+            self.assertEqual(a[idx], a_ref[idx])
+        self.assertRaises(TypeError, a.splice, [1, 2])
+        self.assertRaises(ValueError, a.splice, a)
+        self.assertRaises(ValueError, a.splice, b, sllist([1]).first)
+
+    def test_split_after(self):
+        ref = py23_range(0, 100)
+        ll = sllist(ref)
+        nodes = [ll.nodeat(i) for i in py23_xrange(0, 100, 7)]
+        self.assertEqual(ll[80], 80)
+        tail = ll.split_after(ll.nodeat(39))
+        self.assertTrue(isinstance(tail, sllist))
+        self.assertEqual(list(ll), ref[:40])
+        self.assertEqual(list(tail), ref[40:])
+        self.assertEqual(ll.last.value, 39)
+        self.assertEqual(tail.last.value, 99)
+        for node in nodes:
+            if node.value < 40:
+                self.assertTrue(ll.nodeat(node.value) is node)
+            else:
+                self.assertTrue(tail.nodeat(node.value - 40) is node)
+        for idx in py23_xrange(len(tail)):
+            self.assertEqual(tail[idx], ref[40 + idx])
+        self.assertEqual(len(ll.split_after(ll.last)), 0)
+        ll.append(40)
+        self.assertEqual(list(ll), ref[:41])
+        self.assertRaises(TypeError, ll.split_after, 1)
+        self.assertRaises(ValueError, ll.split_after, tail.first)
+
+    def test_remove_if(self):
+        ref = py23_range(0, 1024)
+        ll = sllist(ref)
+        node = ll.nodeat(300)
+        self.assertEqual(ll.remove_if(lambda x: x % 3 == 0), 342)
+        ref = [x for x in ref if x % 3 != 0]
+        self.assertEqual(list(ll), ref)
+        self.assertEqual(node.value, 300)
+        self.assertEqual(node.next, None)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        self.assertEqual(ll.remove_if(lambda x: False), 0)
+
+        def modifying(x):
+            ll.appendleft(x)
+            return True
+        self.assertRaises(RuntimeError, ll.remove_if, modifying)
+        self.assertRaises(ZeroDivisionError, ll.remove_if, lambda x: 1 // 0)
+        self.assertEqual(ll.remove_if(lambda x: True), len(ref) + 1)
+        self.assertEqual(len(ll), 0)
+        self.assertEqual(ll.first, None)
+        self.assertEqual(ll.last, None)
+
+    def test_remove_nodes(self):
+        ref = py23_range(0, 1024)
+        ll = sllist(ref)
+        nodes = [ll.nodeat(i) for i in py23_xrange(0, 1024, 5)]
+        self.assertEqual(ll.remove_nodes(nodes + nodes[:3]), len(nodes))
+        ref = [x for x in ref if x % 5 != 0]
+        self.assertEqual(list(ll), ref)
+        for node in nodes:
+            self.assertEqual(node.next, None)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        self.assertEqual(ll.remove_nodes(iter([ll.last])), 1)
+        self.assertEqual(ll.last.value, ref[-2])
+        self.assertRaises(TypeError, ll.remove_nodes, [ll.first, 1])
+        self.assertRaises(ValueError, ll.remove_nodes, [ll.first, nodes[0]])
+        self.assertEqual(ll.first.value, ref[0])
+
+    def test_sort(self):
+        ref = [(x * 37) % 101 for x in py23_xrange(0, 1024)]
+        ll = sllist(ref)
+        node = ll.nodeat(10)
+        ll.sort()
+        self.assertEqual(list(ll), sorted(ref))
+        self.assertEqual(ll.last.value, 100)
+        self.assertEqual(ll.nodeat(len(ref) - 1), ll.last)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], sorted(ref)[idx])
+        self.assertEqual(node.value, ref[10])
+        ll = sllist(enumerate(ref))
+        ll.sort(key=lambda x: x[1] % 7, reverse=True)
+        self.assertEqual(list(ll), sorted(enumerate(ref),
+                         key=lambda x: x[1] % 7, reverse=True))
+        ll.sort(key=None)
+        self.assertEqual(list(ll), list(enumerate(ref)))
+        ll.append('x')
+        self.assertEqual(ll[-1], 'x')
+        self.assertRaises(TypeError, ll.sort)
+        self.assertEqual(ll[-1], 'x')
+        self.assertEqual(len(ll), len(ref) + 1)
+
+        def modifying(x):
+            ll.appendleft(x)
+            return x
+        self.assertRaises(RuntimeError, ll.sort, key=modifying)
+        ll = sllist()
+        ll.sort()
+        self.assertEqual(list(ll), [])
+
+    def test_sort_comparison_side_effects(self):
+        ref = [(x * 37) % 101 for x in py23_xrange(0, 100)]
+        events = []
+        limit = [len(ref) * 100]
+        grow = [False]
+
+        class Value(object):
+            def __init__(self, value):
+                self.value = value
+
+            def __lt__(self, other):
+                # list appears empty and its nodes cannot modify it
+                events.append(len(ll))
+                try:
+                    node.value = Value(-1)
+                except RuntimeError:
+                    events.append('locked')
+                try:
+                    ll.remove(node)
+                except RuntimeError:
+                    events.append('remove')
+                try:
+                    node.value
+                except RuntimeError:
+                    events.append('read')
+                if grow[0]:
+                    ll.append(Value(-1))
+                if len(events) > limit[0]:
+                    raise ValueError()
+                return self.value < other.value
+
+        ll = sllist(Value(x) for x in ref)
+        node = ll.nodeat(10)
+        ll.sort()
+        self.assertEqual([v.value for v in ll], sorted(ref))
+        self.assertEqual(set(events),
+                         set([0, 'locked', 'remove', 'read']))
+
+        # list is left unchanged if a comparison fails
+        ll = sllist(Value(x) for x in ref)
+        node = ll.nodeat(10)
+        limit[0] = len(events) + 300
+        self.assertRaises(ValueError, ll.sort)
+        self.assertEqual([v.value for v in ll], ref)
+        self.assertRaises(ValueError, ll.sort, key=lambda v: v, reverse=True)
+        self.assertEqual([v.value for v in ll], ref)
+        self.assertEqual(ll.last.value.value, ref[-1])
+        ll.remove(node)
+        self.assertEqual(len(ll), len(ref) - 1)
+
+        # elements added by comparisons are discarded
+        limit[0] = len(events) + len(ref) * 100
+        grow[0] = True
+        ll = sllist(Value(x) for x in ref)
+        node = ll.nodeat(10)
+        self.assertRaises(RuntimeError, ll.sort, key=lambda v: v)
+        self.assertEqual([v.value for v in ll], sorted(ref))
+        self.assertEqual(ll.last.value.value, max(ref))
+        self.assertEqual(ll[-1].value, max(ref))
+
+    def test_reverse(self):
+        ref = py23_range(0, 1024)
+        ll = sllist(ref)
+        node = ll.nodeat(10)
+        self.assertEqual(ll[700], 700)
+        ll.reverse()
+        ref = list(reversed(ref))
+        self.assertEqual(list(ll), ref)
+        self.assertEqual(ll.first.value, 1023)
+        self.assertEqual(ll.last.value, 0)
+        self.assertEqual(node.next.value, 9)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        ll.append(-1)
+        self.assertEqual(ll[-2], 0)
+        ll = sllist([1])
+        ll.reverse()
+        self.assertEqual(list(ll), [1])
+
+    def test_find(self):
+        ref = [x % 10 for x in py23_xrange(0, 100)]
+        ll = sllist(ref)
+        self.assertTrue(9 in ll)
+        self.assertFalse(10 in ll)
+        self.assertFalse('a' in ll)
+        self.assertTrue(9.0 in ll)
+        self.assertEqual(ll.count(3), 10)
+        self.assertEqual(ll.count(10), 0)
+        self.assertEqual(ll.index(3), 3)
+        self.assertEqual(ll.index(3, 4), 13)
+        self.assertEqual(ll.index(3, -7), 93)
+        self.assertEqual(ll.index(3, 13, 14), 13)
+        self.assertRaises(ValueError, ll.index, 3, 14, 23)
+        self.assertRaises(ValueError, ll.index, 3, 200)
+        self.assertRaises(ValueError, ll.index, 10)
+        self.assertEqual(ll.find(5), ll.nodeat(5))
+        self.assertEqual(ll.find(10), None)
+        value = object()
+        ll.append(value)
+        self.assertTrue(value in ll)
+        self.assertEqual(ll.find(value), ll.last)
+        self.assertFalse(1 in sllist())
+
+        class Modifying(object):
+            def __eq__(other, value):
+                ll.pop()
+                return False
+        ll.appendleft(Modifying())
+        self.assertRaises(RuntimeError, ll.count, 1)
+
     def test_list_hash(self):
         self.assertEqual(hash(sllist()), hash(sllist()))
         self.assertEqual(hash(sllist(py23_range(0, 1024, 4))),
             hash(sllist(py23_range(0, 1024, 4))))
         self.assertEqual(hash(sllist([0, 2])), hash(sllist([0.0, 2.0])))
 
+    def test_reductions(self):
+        ll = sllist(py23_range(1, 101))
+        self.assertEqual(ll.sum(), 5050)
+        self.assertEqual(ll.min(), 1)
+        self.assertEqual(ll.max(), 100)
+        self.assertEqual(ll.mean(), 50.5)
+        ll = sllist([3, 2 ** 63, -1.5, 2 ** 64])
+        self.assertEqual(ll.sum(), sum([3, 2 ** 63, -1.5, 2 ** 64]))
+        self.assertEqual(ll.min(), -1.5)
+        self.assertEqual(ll.max(), 2 ** 64)
+        ll = sllist([2 ** 62, 2 ** 62, 2 ** 62])
+        self.assertEqual(ll.sum(), 3 * 2 ** 62)
+        self.assertEqual(ll.mean(), 2.0 ** 62)
+        ll = sllist(['b', 'c', 'a'])
+        self.assertEqual(ll.min(), 'a')
+        self.assertEqual(ll.max(), 'c')
+        self.assertRaises(TypeError, ll.sum)
+        self.assertEqual(sllist().sum(), 0)
+        self.assertRaises(ValueError, sllist().min)
+        self.assertRaises(ValueError, sllist().max)
+        self.assertRaises(ValueError, sllist().mean)
+
+        class Modifying(object):
+            def __radd__(other, value):
+                ll.clear()
+                return value
+            def __lt__(other, value):
+                ll.clear()
+                return False
+        ll = sllist([1, Modifying(), 2])
+        self.assertRaises(RuntimeError, ll.sum)
+        ll = sllist([1, Modifying(), 2])
+        self.assertRaises(RuntimeError, ll.min)
+
 
 class testdllist(unittest.TestCase):
 
@@ -830,6 +1391,30 @@ class testdllist(unittest.TestCase):
         self.assertRaises(TypeError, dllist, 1);
         self.assertRaises(TypeError, dllist, 1.5);
 
+    def test_init_with_iterable(self):
+        ref = py23_range(0, 1024, 4)
+        ll = dllist(x for x in ref)
+        self.assertEqual(len(ll), len(ref))
+        self.assertEqual(list(ll), ref)
+        self.assertEqual(list(dllist(iter(ref))), ref)
+        self.assertEqual(list(dllist(tuple(ref))), ref)
+        self.assertEqual(list(dllist('abc')), ['a', 'b', 'c'])
+        self.assertEqual(sorted(dllist(set([1, 2, 3]))), [1, 2, 3])
+        ll = dllist((x for x in ref), indexed=True)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+
+    def test_call_arguments(self):
+        self.assertEqual(dllistnode(1).value, 1)
+        self.assertEqual(dllistnode().value, None)
+        self.assertRaises(TypeError, dllistnode, 1, 2)
+        self.assertRaises(TypeError, dllist, [1], 2, 3, 4)
+        ll = dllist(iterable=[1, 2])
+        self.assertEqual(list(ll), [1, 2])
+        self.assertRaises(TypeError, ll.insert)
+        self.assertRaises(TypeError, ll.insert, 1, ll.first, 2)
+        self.assertRaises(TypeError, ll.splice)
+
     def test_str(self):
         a = dllist([])
         self.assertEqual(str(a), 'dllist()')
@@ -1022,6 +1607,26 @@ class testdllist(unittest.TestCase):
             idx += 1
         self.assertEqual(idx, len(ref))
 
+    def test_iter_with_modification(self):
+        ll = dllist(py23_range(0, 16))
+        result = []
+        for val in ll:
+            result.append(val)
+            if val == 5:
+                ll[10] = 'x'
+                ll.nodeat(11).value = 'y'
+        self.assertEqual(result, [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 'x', 'y',
+                                  12, 13, 14, 15])
+        it = iter(ll)
+        self.assertEqual(next(it), 0)
+        ll.appendleft(-1)
+        self.assertRaises(RuntimeError, next, it)
+        self.assertRaises(StopIteration, next, it)
+        it = iter(ll)
+        self.assertEqual(list(it), list(ll))
+        ll.clear()
+        self.assertRaises(StopIteration, next, it)
+
     def test_iter_empty(self):
         ll = dllist()
         count = 0
@@ -1156,6 +1761,27 @@ class testdllist(unittest.TestCase):
         self.assertEqual(a, dllist(a_ref + a_ref))
         self.assertEqual(len(a), len(a_ref) * 2)
 
+    def test_extend_with_iterable(self):
+        ref = py23_range(0, 1024, 4)
+        ll = dllist(ref)
+        ll.extend(x * 2 for x in ref)
+        ll.extendleft(iter('ab'))
+        ref = ['b', 'a'] + ref + [x * 2 for x in ref]
+        self.assertEqual(list(ll), ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+
+        def failing():
+            yield 1
+            yield 2
+            raise KeyError()
+        ll = dllist([0])
+        self.assertRaises(KeyError, ll.extend, failing())
+        self.assertEqual(list(ll), [0, 1, 2])
+        self.assertRaises(TypeError, ll.extend, 1)
+        self.assertRaises(TypeError, ll.extendleft, None)
+        self.assertEqual(list(ll), [0, 1, 2])
+
     def test_extend_empty(self):
         filled_ref = py23_range(0, 1024, 4)
         filled = dllist(filled_ref)
@@ -1336,6 +1962,56 @@ class testdllist(unittest.TestCase):
         ll.remove(node)
         self.assertRaises(ValueError, ll.remove, node)
 
+    def test_remove_popped_node(self):
+        ll = dllist([1, 2, 3, 4])
+        first = ll.first
+        last = ll.last
+        ll.popleft()
+        ll.popright()
+        self.assertRaises(ValueError, ll.remove, first)
+        self.assertRaises(ValueError, ll.remove, last)
+        self.assertEqual(list(ll), [2, 3])
+        ll.clear()
+        self.assertRaises(ValueError, ll.remove, first)
+
+    def test_remove_node_of_destroyed_list(self):
+        node = dllist([1, 2, 3]).nodeat(1)
+        self.assertEqual(node.value, 2)
+        self.assertEqual(node.next, None)
+        ll = dllist([1, 2, 3])
+        self.assertRaises(ValueError, ll.remove, node)
+        self.assertEqual(len(ll), 3)
+
+    def test_node_identity(self):
+        ll = dllist([1, 2, 3])
+        node = ll.nodeat(1)
+        self.assertTrue(ll.first is ll.first)
+        self.assertTrue(ll.first.next is node)
+        self.assertTrue(ll.nodeat(-2) is node)
+        self.assertTrue(node.next is ll.last)
+        self.assertTrue(ll.last.prev is node)
+        node.value = 5
+        self.assertEqual(list(ll), [1, 5, 3])
+
+    def test_detached_node_keeps_value(self):
+        ll = dllist([1, 2, 3])
+        node = ll.nodeat(1)
+        del ll[1]
+        self.assertEqual(node.value, 2)
+        self.assertEqual(node.next, None)
+        node.value = 4
+        self.assertEqual(node(), 4)
+        ll.append(node)
+        self.assertEqual(list(ll), [1, 3, 4])
+        self.assertFalse(ll.last is node)
+
+    def test_remove_node_of_other_list(self):
+        ll = dllist([1, 2, 3])
+        other = dllist([1, 2, 3])
+        self.assertRaises(ValueError, ll.remove, other.first)
+        self.assertEqual(len(ll), 3)
+        self.assertEqual(len(other), 3)
+
     def test_rotate_left(self):
         for n in py23_xrange(128):
             ref = py23_range(32)
@@ -1543,17 +2219,1112 @@ class testdllist(unittest.TestCase):
         self.assertRaises(expected_error, setattr, ll, 'prev', None)
         self.assertRaises(expected_error, setattr, ll, 'next', None)
 
+    def test_access_fingers(self):
+        ref = py23_range(1000)
+        ll = dllist(ref)
+        read_pos = 100
+        write_pos = 700
+        for i in py23_xrange(100):
+            self.assertEqual(ll[read_pos], ref[read_pos])
+            read_pos += 1
+            ll.insert(-i, ll.nodeat(write_pos))
+            ref.insert(write_pos, -i)
+            del ll[write_pos + 2]
+            del ref[write_pos + 2]
+            ll.remove(ll.nodeat(read_pos + 3))
+            del ref[read_pos + 3]
+            ll.appendleft(i)
+            ref.insert(0, i)
+            read_pos += 1
+            write_pos += 3
+        self.assertEqual(list(ll), ref)
+        self.assertTrue(ll.fingerhits > 9 * ll.fingermisses)
+        ll.rotate(-333)
+        ref = ref[333:] + ref[:333]
+        for idx in [0, read_pos, write_pos - 1, 990, 5]:
+            self.assertEqual(ll[idx], ref[idx])
+        ll.remove(ll.nodeat(500).next)
+        del ref[501]
+        self.assertEqual(list(ll), ref)
+
+    def test_indexed_init(self):
+        ll = dllist(py23_range(10), indexed=True)
+        self.assertTrue(ll.indexed)
+        self.assertFalse(dllist().indexed)
+        self.assertEqual(list(ll), py23_range(10))
+        self.assertRaises(ValueError, ll.__init__, [], False)
+        ll.clear()
+        ll.__init__([1, 2], False)
+        self.assertFalse(ll.indexed)
+        self.assertTrue((dllist([1], indexed=True) + dllist([2])).indexed)
+        self.assertTrue((dllist([1], indexed=True) * 2).indexed)
+
+    def test_indexed_access(self):
+        ref = py23_range(0, 1024, 4)
+        ll = dllist(ref, indexed=True)
+        for idx in [0, 1, 100, 255, -1, -100, 37, 38, 36, 200]:
+            self.assertEqual(ll[idx], ref[idx])
+            self.assertEqual(ll.nodeat(idx).value, ref[idx])
+        for idx in py23_xrange(0, 100, 7):
+            del ll[idx]
+            del ref[idx]
+            ll.insert(idx, ll.nodeat(idx * 2))
+            ref.insert(idx * 2, idx)
+            ll.appendleft(-idx)
+            ref.insert(0, -idx)
+            ll.remove(ll.nodeat(-idx - 1))
+            del ref[-idx - 1]
+        ll.rotate(77)
+        ref = ref[-77:] + ref[:-77]
+        self.assertEqual(list(ll), ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+
+    def test_getitem_slice(self):
+        ref = py23_range(0, 1024, 4)
+        for indexed in [False, True]:
+            ll = dllist(ref, indexed=indexed)
+            for s in [slice(None), slice(10, 20), slice(-30, -5, 3),
+                      slice(None, None, -1), slice(200, 10, -7),
+                      slice(300, 400), slice(5, 5), slice(20, 10)]:
+                sl = ll[s]
+                self.assertTrue(isinstance(sl, dllist))
+                self.assertEqual(list(sl), ref[s])
+            self.assertEqual(list(ll), ref)
+            self.assertRaises(ValueError, ll.__getitem__, slice(0, 10, 0))
+
+    def test_delitem_slice(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 1024, 4)
+            ll = dllist(ref, indexed=indexed)
+            node = ll.nodeat(50)
+            for s in [slice(10, 20), slice(-30, -5, 3), slice(200, 10, -7),
+                      slice(5, 5), slice(0, 1), slice(1, 150)]:
+                del ll[s]
+                del ref[s]
+                self.assertEqual(list(ll), ref)
+            self.assertEqual(node.value, 200)
+            self.assertEqual(node.next, None)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            del ll[:]
+            self.assertEqual(len(ll), 0)
+
+    def test_setitem_slice(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 1024, 4)
+            ll = dllist(ref, indexed=indexed)
+            ll[10:20] = ['a', 'b']
+            ref[10:20] = ['a', 'b']
+            self.assertEqual(list(ll), ref)
+            ll[5:5] = dllist(['c', 'd', 'e'])
+            ref[5:5] = ['c', 'd', 'e']
+            self.assertEqual(list(ll), ref)
+            ll[::-5] = py23_range(len(ref[::-5]))
+            ref[::-5] = py23_range(len(ref[::-5]))
+            self.assertEqual(list(ll), ref)
+            ll[1:3] = ll
+            ref[1:3] = ref[:]
+            self.assertEqual(list(ll), ref)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            self.assertRaises(ValueError, ll.__setitem__,
+                slice(None, None, 2), [1, 2, 3])
+            self.assertRaises(TypeError, ll.__setitem__, slice(1, 2), None)
+
+    def test_splice(self):
+        for indexed in [False, True]:
+            a_ref = py23_range(0, 100)
+            b_ref = py23_range(100, 200)
+            a = dllist(a_ref, indexed=indexed)
+            b = dllist(b_ref, indexed=True)
+            nodes = [b.nodeat(i) for i in py23_xrange(0, 100, 9)]
+            a.splice(b, a.nodeat(40), b.nodeat(10), b.nodeat(19))
+            a_ref[40:40] = b_ref[10:20]
+            del b_ref[10:20]
+            self.assertEqual(list(a), a_ref)
+            self.assertEqual(list(b), b_ref)
+            a.splice(b, a.first)
+            a_ref[0:0] = b_ref
+            self.assertEqual(list(a), a_ref)
+            self.assertEqual(len(b), 0)
+            for node in nodes:
+                self.assertTrue(a.nodeat(a_ref.index(node.value)) is node)
+            a.splice(dllist(['x', 'y'], indexed=True))
+            a.splice(dllist())
+            a_ref += ['x', 'y']
+            self.assertEqual(list(a), a_ref)
+            self.assertEqual(a.last.prev.value, 'x')
+            for idx in py23_xrange(len(a_ref)):
+                self.assertEqual(a[idx], a_ref[idx])
+            self.assertRaises(TypeError, a.splice, [1, 2])
+            self.assertRaises(ValueError, a.splice, a)
+            b = dllist([1, 2, 3], indexed=True)
+            self.assertRaises(ValueError, a.splice, b, None, b.last, b.first)
+            self.assertRaises(ValueError, a.splice, b, b.first)
+        self.assertRaises(ValueError,
+            dllist(indexed=True).splice, dllist([1]))
+
+    def test_move(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 20)
+            ll = dllist(ref, indexed=indexed)
+            nodes = [ll.nodeat(i) for i in py23_xrange(0, 20)]
+            ll[15]
+            ll.move_to_front(nodes[10])
+            ll.move_to_back(nodes[0])
+            ll.move_before(nodes[5], nodes[2])
+            ll.move_after(nodes[19], nodes[3])
+            ll.move_after(nodes[7], nodes[7])
+            ll.move_before(nodes[1], nodes[2])
+            ll.move_to_front(nodes[10])
+            ref = [10, 5, 1, 2, 3, 19, 4, 6, 7, 8, 9, 11, 12, 13, 14, 15,
+                   16, 17, 18, 0]
+            self.assertEqual(list(ll), ref)
+            self.assertEqual(list(reversed(ll)),
+                             ref[::-1])
+            for idx in py23_xrange(len(ref)):
+                self.assertTrue(ll.nodeat(idx) is nodes[ref[idx]])
+                self.assertEqual(ll[-idx - 1], ref[-idx - 1])
+            other = dllist(['x', 'y'], indexed=True)
+            node = other.first
+            ll.move_after(node, nodes[4])
+            ll.move_to_front(other.first)
+            self.assertEqual(len(other), 0)
+            self.assertEqual(len(ll), 22)
+            self.assertEqual(node.prev.value, 4)
+            ref[0:0] = ['y']
+            ref.insert(ref.index(4) + 1, 'x')
+            self.assertEqual(list(ll), ref)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            other = dllist()
+            other.move_to_back(node)
+            self.assertEqual(list(other), ['x'])
+            self.assertEqual(list(ll), [x for x in ref if x != 'x'])
+            self.assertRaises(TypeError, ll.move_to_front, 1)
+            self.assertRaises(ValueError, ll.move_to_back, dllistnode(1))
+            self.assertRaises(ValueError, ll.move_before, nodes[0], node)
+            self.assertRaises(TypeError, ll.move_after, nodes[0], None)
+        self.assertRaises(ValueError,
+            dllist(indexed=True).move_to_back, dllist([1]).first)
+        ll = dllist([1, 2], unique_index=True)
+        other = dllist([2, 3], unique_index=True)
+        ll.move_to_front(ll.last)
+        self.assertEqual(ll.find(2), ll.first)
+        self.assertRaises(ValueError, ll.move_to_back, other.first)
+        ll.move_to_back(other.last)
+        self.assertEqual(list(ll), [2, 1, 3])
+        self.assertEqual(ll.find(3), ll.last)
+        self.assertEqual(other.find(3), None)
+
+    def test_split(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 100)
+            ll = dllist(ref, indexed=indexed)
+            nodes = [ll.nodeat(i) for i in py23_xrange(0, 100, 7)]
+            tail = ll.split(ll.nodeat(40))
+            self.assertTrue(isinstance(tail, dllist))
+            self.assertEqual(tail.indexed, indexed)
+            self.assertEqual(list(ll), ref[:40])
+            self.assertEqual(list(tail), ref[40:])
+            self.assertEqual(ll.last.next, None)
+            self.assertEqual(tail.first.prev, None)
+            for node in nodes:
+                if node.value < 40:
+                    self.assertTrue(ll.nodeat(node.value) is node)
+                else:
+                    self.assertTrue(tail.nodeat(node.value - 40) is node)
+            for idx in py23_xrange(len(tail)):
+                self.assertEqual(tail[idx], ref[40 + idx])
+            rest = ll.split(ll.first)
+            self.assertEqual(len(ll), 0)
+            self.assertEqual(list(rest), ref[:40])
+            ll.append(0)
+            self.assertEqual(list(ll), [0])
+            self.assertRaises(TypeError, ll.split, 1)
+            self.assertRaises(ValueError, ll.split, tail.first)
+
+    def test_remove_if(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 1024)
+            ll = dllist(ref, indexed=indexed)
+            node = ll.nodeat(300)
+            self.assertEqual(ll.remove_if(lambda x: x % 3 == 0), 342)
+            ref = [x for x in ref if x % 3 != 0]
+            self.assertEqual(list(ll), ref)
+            self.assertEqual(node.value, 300)
+            self.assertEqual(node.next, None)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            self.assertEqual(ll.remove_if(lambda x: False), 0)
+
+            def modifying(x):
+                ll.appendleft(x)
+                return True
+            self.assertRaises(RuntimeError, ll.remove_if, modifying)
+            self.assertRaises(ZeroDivisionError, ll.remove_if, lambda x: 1 // 0)
+            self.assertEqual(ll.remove_if(lambda x: True), len(ref) + 1)
+            self.assertEqual(len(ll), 0)
+            self.assertEqual(ll.first, None)
+            self.assertEqual(ll.last, None)
+
+    def test_remove_nodes(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 1024)
+            ll = dllist(ref, indexed=indexed)
+            nodes = [ll.nodeat(i) for i in py23_xrange(0, 1024, 5)]
+            self.assertEqual(ll.remove_nodes(nodes + nodes[:3]), len(nodes))
+            ref = [x for x in ref if x % 5 != 0]
+            self.assertEqual(list(ll), ref)
+            for node in nodes:
+                self.assertEqual(node.next, None)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            self.assertEqual(ll.remove_nodes(iter([ll.last])), 1)
+            self.assertEqual(ll.last.value, ref[-2])
+            self.assertRaises(TypeError, ll.remove_nodes, [ll.first, 1])
+            self.assertRaises(ValueError, ll.remove_nodes, [ll.first, nodes[0]])
+            self.assertEqual(ll.first.value, ref[0])
+
+    def test_sort(self):
+        for indexed in [False, True]:
+            ref = [(x * 37) % 101 for x in py23_xrange(0, 1024)]
+            ll = dllist(ref, indexed=indexed)
+            node = ll.nodeat(10)
+            ll.sort()
+            self.assertEqual(list(ll), sorted(ref))
+            self.assertEqual(list(reversed(ll)), sorted(ref, reverse=True))
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], sorted(ref)[idx])
+            self.assertEqual(node.value, ref[10])
+            ll = dllist(enumerate(ref), indexed=indexed)
+            ll.sort(key=lambda x: x[1] % 7, reverse=True)
+            self.assertEqual(list(ll), sorted(enumerate(ref),
+                             key=lambda x: x[1] % 7, reverse=True))
+            ll.sort(key=None)
+            self.assertEqual(list(ll), list(enumerate(ref)))
+            ll.append('x')
+            self.assertEqual(ll[-1], 'x')
+            self.assertRaises(TypeError, ll.sort)
+            self.assertEqual(ll[-1], 'x')
+            self.assertEqual(len(ll), len(ref) + 1)
+
+            def modifying(x):
+                ll.appendleft(x)
+                return x
+            self.assertRaises(RuntimeError, ll.sort, key=modifying)
+            ll = dllist(indexed=indexed)
+            ll.sort()
+            self.assertEqual(list(ll), [])
+
+    def test_sort_comparison_side_effects(self):
+        ref = [(x * 37) % 101 for x in py23_xrange(0, 100)]
+        events = []
+        limit = [len(ref) * 100]
+        grow = [False]
+
+        class Value(object):
+            def __init__(self, value):
+                self.value = value
+
+            def __lt__(self, other):
+                # list appears empty and its nodes cannot modify it
+                events.append(len(ll))
+                try:
+                    ll.remove(node)
+                except RuntimeError:
+                    events.append('remove')
+                try:
+                    node.value
+                except RuntimeError:
+                    events.append('read')
+                try:
+                    ll.move_to_front(node)
+                except RuntimeError:
+                    events.append('locked')
+                try:
+                    node.value = Value(-1)
+                except RuntimeError:
+                    events.append('locked')
+                if grow[0]:
+                    ll.append(Value(-1))
+                if len(events) > limit[0]:
+                    raise ValueError()
+                return self.value < other.value
+
+        for indexed in [False, True]:
+            for unique_index in [False, True]:
+                del events[:]
+                limit[0] = len(ref) * 100
+                grow[0] = False
+                ll = dllist((Value(x) for x in ref), indexed=indexed,
+                            unique_index=unique_index)
+                node = ll.nodeat(10)
+                ll.sort()
+                self.assertEqual([v.value for v in ll], sorted(ref))
+                self.assertEqual([v.value for v in reversed(ll)],
+                                 sorted(ref, reverse=True))
+                self.assertEqual(set(events),
+                                 set([0, 'locked', 'remove', 'read']))
+
+                # list is left unchanged if a comparison fails
+                ll = dllist((Value(x) for x in ref), indexed=indexed,
+                            unique_index=unique_index)
+                node = ll.nodeat(10)
+                limit[0] = len(events) + 300
+                self.assertRaises(ValueError, ll.sort)
+                self.assertEqual([v.value for v in ll], ref)
+                self.assertRaises(ValueError, ll.sort,
+                                  key=lambda v: v, reverse=True)
+                self.assertEqual([v.value for v in ll], ref)
+                self.assertEqual([v.value for v in reversed(ll)],
+                                 ref[::-1])
+                self.assertEqual(ll[50].value, ref[50])
+                ll.move_to_front(node)
+                self.assertEqual(ll.first.value.value, ref[10])
+
+                # elements added by comparisons are discarded
+                limit[0] = len(events) + len(ref) * 100
+                grow[0] = True
+                ll = dllist((Value(x) for x in ref), indexed=indexed,
+                            unique_index=unique_index)
+                node = ll.nodeat(10)
+                self.assertRaises(RuntimeError, ll.sort, key=lambda v: v)
+                self.assertEqual([v.value for v in ll], sorted(ref))
+                self.assertEqual([v.value for v in reversed(ll)],
+                                 sorted(ref, reverse=True))
+                self.assertEqual(ll[50].value, sorted(ref)[50])
+                if unique_index:
+                    self.assertEqual(ll.find(node.value), node)
+
+    def test_reverse(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 1024)
+            ll = dllist(ref, indexed=indexed)
+            node = ll.nodeat(10)
+            self.assertEqual(ll[700], 700)
+            ll.reverse()
+            ref = list(reversed(ref))
+            self.assertEqual(list(ll), ref)
+            self.assertEqual(ll.first.value, 1023)
+            self.assertEqual(ll.last.value, 0)
+            self.assertEqual(ll.first.prev, None)
+            self.assertEqual(node.next.value, 9)
+            self.assertEqual(node.prev.value, 11)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            ll.append(-1)
+            self.assertEqual(ll[-2], 0)
+            ll = dllist([1], indexed=indexed)
+            ll.reverse()
+            self.assertEqual(list(ll), [1])
+
+    def test_reversed(self):
+        ref = py23_range(0, 1024)
+        ll = dllist(ref)
+        self.assertEqual(list(reversed(ll)), list(reversed(ref)))
+        self.assertEqual(list(reversed(dllist())), [])
+        it = reversed(ll)
+        self.assertEqual(next(it), 1023)
+        self.assertEqual(next(iter(it)), 1022)
+        ll.popright()
+        self.assertRaises(RuntimeError, next, it)
+        self.assertRaises(StopIteration, next, it)
+
+    def test_iternodes(self):
+        ref = py23_range(0, 100)
+        ll = dllist(ref)
+        nodes = list(ll.iternodes())
+        self.assertEqual([node.value for node in nodes], ref)
+        for idx in py23_xrange(len(ref)):
+            self.assertTrue(nodes[idx] is ll.nodeat(idx))
+        for node in ll.iternodes():
+            if node.value % 2:
+                ll.remove(node)
+        self.assertEqual(list(ll), ref[::2])
+        self.assertEqual(list(dllist().iternodes()), [])
+
+    def test_iternodes_modified(self):
+        def iterate(ll, modify):
+            values = []
+            for node in ll.iternodes():
+                values.append(node.value)
+                if node.value == 2:
+                    modify(ll, node)
+            return values
+
+        # the returned node may be removed and values may be replaced
+        ll = dllist([1, 2, 3, 4])
+        self.assertEqual(iterate(ll, lambda ll, node: ll.remove(node)),
+                         [1, 2, 3, 4])
+        self.assertEqual(list(ll), [1, 3, 4])
+        ll = dllist([1, 2, 3, 4])
+        self.assertEqual(
+            iterate(ll, lambda ll, node: setattr(node.next, 'value', 30)),
+            [1, 2, 30, 4])
+
+        # other modifications are reported
+        ll = dllist([1, 2, 3, 4])
+        self.assertRaises(RuntimeError, iterate, ll,
+                          lambda ll, node: ll.remove(node.next))
+        self.assertEqual(list(ll), [1, 2, 4])
+        self.assertRaises(RuntimeError, iterate, dllist([1, 2, 3, 4]),
+                          lambda ll, node: ll.clear())
+        self.assertRaises(RuntimeError, iterate, dllist([1, 2, 3, 4]),
+                          lambda ll, node: ll.append(5))
+        self.assertRaises(RuntimeError, iterate, dllist([1, 2, 3, 4]),
+                          lambda ll, node: (ll.remove(node), ll.pop()))
+        other = dllist()
+        self.assertRaises(RuntimeError, iterate, dllist([1, 2, 3, 4]),
+                          lambda ll, node: other.move_to_back(node.next))
+        self.assertEqual(list(other), [3])
+        self.assertRaises(RuntimeError, iterate, dllist([1, 2, 3, 4]),
+                          lambda ll, node: ll.move_to_back(node))
+
+        # iterator stays exhausted after an error
+        ll = dllist([1, 2, 3, 4])
+        it = ll.iternodes()
+        next(it)
+        ll.appendleft(0)
+        self.assertRaises(RuntimeError, next, it)
+        self.assertRaises(StopIteration, next, it)
+
+    def test_cursor(self):
+        for indexed in [False, True]:
+            ref = py23_range(0, 10)
+            ll = dllist(ref, indexed=indexed)
+            cur = ll.cursor()
+            self.assertTrue(cur.node is ll.first)
+            removed = []
+            while cur.node is not None:
+                if cur.value % 3 == 0:
+                    removed.append(cur.remove())
+                else:
+                    cur.insert_after(cur.value * 10)
+                    self.assertEqual(cur.next().value, cur.prev().value * 10)
+                    cur.next()
+                    cur.next()
+            self.assertEqual(removed, [0, 3, 6, 9])
+            ref = [1, 10, 2, 20, 4, 40, 5, 50, 7, 70, 8, 80]
+            self.assertEqual(list(ll), ref)
+            for idx in py23_xrange(len(ref)):
+                self.assertEqual(ll[idx], ref[idx])
+            self.assertTrue(cur.peek() is ll.first)
+            self.assertTrue(cur.prev() is ll.last)
+            self.assertEqual(cur.next(), None)
+            self.assertRaises(ValueError, cur.remove)
+            self.assertRaises(ValueError, getattr, cur, 'value')
+            cur.insert_before('y')
+            cur.insert_after('x')
+            self.assertEqual(ll.first.value, 'x')
+            self.assertEqual(ll.last.value, 'y')
+            cur = ll.cursor(ll.nodeat(6))
+            self.assertEqual(cur.value, 40)
+            cur.insert_before(30)
+            self.assertEqual(cur.prev().value, 30)
+            self.assertEqual(cur.peek().value, 40)
+            ll.remove(cur.node)
+            self.assertRaises(RuntimeError, cur.next)
+            self.assertRaises(RuntimeError, cur.insert_after, 1)
+        self.assertEqual(dllist().cursor().next(), None)
+        self.assertRaises(ValueError, dllist().cursor, ll.first)
+        self.assertRaises(TypeError, ll.cursor, 1)
+
+    def test_find(self):
+        for indexed in [False, True]:
+            ref = [x % 10 for x in py23_xrange(0, 100)]
+            ll = dllist(ref, indexed=indexed)
+            self.assertTrue(9 in ll)
+            self.assertFalse(10 in ll)
+            self.assertFalse('a' in ll)
+            self.assertTrue(9.0 in ll)
+            self.assertEqual(ll.count(3), 10)
+            self.assertEqual(ll.count(10), 0)
+            self.assertEqual(ll.index(3), 3)
+            self.assertEqual(ll.index(3, 4), 13)
+            self.assertEqual(ll.index(3, -7), 93)
+            self.assertEqual(ll.index(3, 13, 14), 13)
+            self.assertRaises(ValueError, ll.index, 3, 14, 23)
+            self.assertRaises(ValueError, ll.index, 3, 200)
+            self.assertRaises(ValueError, ll.index, 10)
+            self.assertEqual(ll.find(5), ll.nodeat(5))
+            self.assertEqual(ll.find(10), None)
+            value = object()
+            ll.append(value)
+            self.assertTrue(value in ll)
+            self.assertEqual(ll.find(value), ll.last)
+            self.assertFalse(1 in dllist())
+
+            class Modifying(object):
+                def __eq__(other, value):
+                    ll.pop()
+                    return False
+            ll.appendleft(Modifying())
+            self.assertRaises(RuntimeError, ll.count, 1)
+
+    def test_remove_value(self):
+        for unique_index in [False, True]:
+            ref = py23_range(0, 1024)
+            ll = dllist(ref, unique_index=unique_index)
+            node = ll.nodeat(300)
+            self.assertEqual(ll.remove_value(300), 300)
+            self.assertEqual(node.next, None)
+            self.assertFalse(300 in ll)
+            self.assertEqual(ll.remove_value(1023.0), 1023)
+            self.assertRaises(ValueError, ll.remove_value, 300)
+            ref = [x for x in ref if x not in [300, 1023]]
+            self.assertEqual(list(ll), ref)
+            self.assertEqual(ll.last.value, 1022)
+
+    def test_unique_index(self):
+        for indexed in [False, True]:
+            ll = dllist(py23_range(0, 100), indexed=indexed, unique_index=True)
+            self.assertTrue(ll.unique_index)
+            self.assertFalse(dllist().unique_index)
+            node = ll.find(50)
+            self.assertEqual(node, ll.nodeat(50))
+            self.assertTrue(50.0 in ll)
+            self.assertEqual(ll.count(50), 1)
+            self.assertRaises(TypeError, ll.find, [])
+            self.assertRaises(ValueError, ll.append, 50)
+            self.assertRaises(ValueError, ll.insert, 50, ll.first)
+            self.assertRaises(ValueError, ll.extend, [100, 101, 0])
+            self.assertRaises(ValueError, ll.extend, [100, 100])
+            self.assertRaises(TypeError, ll.appendleft, [])
+            self.assertEqual(list(ll), py23_range(0, 100))
+
+            ll[0] = 0.0
+            ll.first.value = 1000
+            self.assertRaises(ValueError, ll.__setitem__, 1, 1000)
+            self.assertRaises(ValueError, setattr, node, 'value', 1000)
+            self.assertEqual(ll.find(0), None)
+            self.assertEqual(ll.find(1000), ll.first)
+            self.assertEqual(ll[1], 1)
+            ll[1:4] = [3, 2, 1]
+            ll[4:8:3] = [7, 4]
+            self.assertEqual(list(ll[:9]), [1000, 3, 2, 1, 7, 5, 6, 4, 8])
+            self.assertEqual(ll.find(4), ll.nodeat(7))
+            self.assertRaises(ValueError, ll.__setitem__, slice(0, 2), [5])
+            self.assertRaises(ValueError, ll.__setitem__, slice(0, 4, 2), [9, 9])
+            self.assertEqual(list(ll[:4]), [1000, 3, 2, 1])
+            self.assertFalse(ll[1:].unique_index)
+
+            ll.pop()
+            ll.popleft()
+            ll.remove(node)
+            for value in [99, 1000, 50]:
+                self.assertFalse(value in ll)
+            ll.append(50)
+            self.assertEqual(ll.find(50), ll.last)
+            self.assertNotEqual(node, ll.last)
+
+            other = dllist([200, 201], indexed=indexed, unique_index=True)
+            self.assertRaises(ValueError, ll.splice, dllist([1], indexed=True))
+            ll.splice(other, ll.first)
+            self.assertEqual(ll.find(201), ll.nodeat(1))
+            self.assertEqual(other.find(201), None)
+            tail = ll.split(ll.find(5))
+            self.assertTrue(tail.unique_index)
+            self.assertEqual(tail.find(5), tail.first)
+            self.assertFalse(5 in ll)
+            ll.clear()
+            self.assertFalse(200 in ll)
+            ll.append(200)
+            self.assertEqual(list(ll), [200])
+
     def test_list_hash(self):
         self.assertEqual(hash(dllist()), hash(dllist()))
         self.assertEqual(hash(dllist(py23_range(0, 1024, 4))),
             hash(dllist(py23_range(0, 1024, 4))))
         self.assertEqual(hash(dllist([0, 2])), hash(dllist([0.0, 2.0])))
 
+    def test_reductions(self):
+        ll = dllist(py23_range(1, 101))
+        self.assertEqual(ll.sum(), 5050)
+        self.assertEqual(ll.min(), 1)
+        self.assertEqual(ll.max(), 100)
+        self.assertEqual(ll.mean(), 50.5)
+        ll = dllist([3, 2 ** 63, -1.5, 2 ** 64])
+        self.assertEqual(ll.sum(), sum([3, 2 ** 63, -1.5, 2 ** 64]))
+        self.assertEqual(ll.min(), -1.5)
+        self.assertEqual(ll.max(), 2 ** 64)
+        ll = dllist([2 ** 62, 2 ** 62, 2 ** 62])
+        self.assertEqual(ll.sum(), 3 * 2 ** 62)
+        self.assertEqual(ll.mean(), 2.0 ** 62)
+        ll = dllist(['b', 'c', 'a'])
+        self.assertEqual(ll.min(), 'a')
+        self.assertEqual(ll.max(), 'c')
+        self.assertRaises(TypeError, ll.sum)
+        self.assertEqual(dllist().sum(), 0)
+        self.assertRaises(ValueError, dllist().min)
+        self.assertRaises(ValueError, dllist().max)
+        self.assertRaises(ValueError, dllist().mean)
+
+        class Modifying(object):
+            def __radd__(other, value):
+                ll.clear()
+                return value
+            def __lt__(other, value):
+                ll.clear()
+                return False
+        ll = dllist([1, Modifying(), 2])
+        self.assertRaises(RuntimeError, ll.sum)
+        ll = dllist([1, Modifying(), 2])
+        self.assertRaises(RuntimeError, ll.min)
+
+
+class testullist(unittest.TestCase):
+
+    def test_init_empty(self):
+        ll = ullist()
+        self.assertEqual(len(ll), 0)
+        self.assertEqual(ll.size, 0)
+        self.assertEqual(ll.chunksize, 64)
+        self.assertEqual(list(ll), [])
+
+    def test_init_with_sequence(self):
+        ref = py23_range(0, 1024, 4)
+        ll = ullist(ref, 4)
+        self.assertEqual(len(ll), len(ref))
+        self.assertEqual(ll.size, len(ref))
+        self.assertEqual(ll.chunksize, 4)
+        self.assertEqual(list(ll), ref)
+
+    def test_init_with_non_sequence(self):
+        self.assertRaises(TypeError, ullist, 1)
+        self.assertRaises(TypeError, ullist, 1.5)
+
+    def test_init_with_iterable(self):
+        ref = py23_range(0, 1024, 4)
+        ll = ullist(x for x in ref)
+        self.assertEqual(len(ll), len(ref))
+        self.assertEqual(list(ll), ref)
+        self.assertEqual(list(ullist(iter(ref))), ref)
+        self.assertEqual(list(ullist(tuple(ref))), ref)
+        self.assertEqual(list(ullist('abc')), ['a', 'b', 'c'])
+        self.assertEqual(sorted(ullist(set([1, 2, 3]))), [1, 2, 3])
+
+    def test_init_with_invalid_chunksize(self):
+        self.assertRaises(ValueError, ullist, [], 1)
+        self.assertRaises(ValueError, ullist, [], 0)
+        self.assertRaises(ValueError, ullist, chunksize=-4)
+        ll = ullist([1, 2], chunksize=2)
+        self.assertRaises(ValueError, ll.__init__, [], 8)
+
+    def test_str(self):
+        a = ullist([], 2)
+        self.assertEqual(str(a), 'ullist()')
+        b = ullist([None, 1, 'abc'], 2)
+        self.assertEqual(str(b), 'ullist([None, 1, abc])')
+
+    def test_repr(self):
+        a = ullist([], 2)
+        self.assertEqual(repr(a), 'ullist()')
+        b = ullist([None, 1, 'abc'], 2)
+        self.assertEqual(repr(b), 'ullist([None, 1, \'abc\'])')
+
+    def test_cmp(self):
+        a = ullist(py23_xrange(0, 1100), 8)
+        b = ullist(py23_xrange(0, 1101), 16)
+        c = ullist([1, 2, 3, 4], 2)
+        d = ullist([1, 2, 3, 5], 3)
+        e = ullist([1, 0, 0, 0], 4)
+        self.assertEqual(cmp(a, a), 0)
+        self.assertEqual(cmp(a, b), -1)
+        self.assertEqual(cmp(b, a), 1)
+        self.assertEqual(cmp(c, d), -1)
+        self.assertEqual(cmp(d, c), 1)
+        self.assertEqual(cmp(e, c), -1)
+        self.assertEqual(cmp(c, e), 1)
+        self.assertTrue(a == ullist(py23_xrange(0, 1100)))
+
+    def test_iter(self):
+        ref = py23_range(0, 1024, 4)
+        ll = ullist(ref, 3)
+        idx = 0
+        for val in ll:
+            self.assertEqual(val, ref[idx])
+            idx += 1
+        self.assertEqual(idx, len(ref))
+
+    def test_iter_with_modification(self):
+        ll = ullist(py23_range(16), 4)
+        result = []
+        for val in ll:
+            result.append(val)
+            if val == 5:
+                ll.remove(6)
+                ll.insert(100, 12)
+        self.assertEqual(result, [0, 1, 2, 3, 4, 5, 7, 8, 9, 10,
+                                  11, 12, 100, 13, 14, 15])
+
+    def test_append_and_pop(self):
+        ref = py23_range(100)
+        ll = ullist([], 4)
+        for val in ref:
+            ll.append(val)
+        ll.appendright(100)
+        ll.appendleft(-1)
+        self.assertEqual(list(ll), [-1] + ref + [100])
+        self.assertEqual(ll.pop(), 100)
+        self.assertEqual(ll.popright(), 99)
+        self.assertEqual(ll.popleft(), -1)
+        self.assertEqual(list(ll), ref[:-1])
+        ll.clear()
+        self.assertEqual(len(ll), 0)
+        self.assertRaises(ValueError, ll.pop)
+        self.assertRaises(ValueError, ll.popleft)
+        self.assertRaises(ValueError, ll.popright)
+
+    def test_insert(self):
+        ref = py23_range(0, 1024, 4)
+        ll = ullist(ref, 4)
+        ll.insert(-1, 0)
+        ref.insert(0, -1)
+        ll.insert(-2, 100)
+        ref.insert(100, -2)
+        ll.insert(-3, -1)
+        ref.insert(-1, -3)
+        ll.insert(-4)
+        ref.append(-4)
+        ll.insert(-5, len(ll))
+        ref.append(-5)
+        self.assertEqual(list(ll), ref)
+        self.assertEqual(ll.size, len(ref))
+
+    def test_insert_invalid_index(self):
+        ll = ullist(py23_range(10), 4)
+        self.assertRaises(IndexError, ll.insert, 0, 11)
+        self.assertRaises(IndexError, ll.insert, 0, -11)
+        self.assertRaises(TypeError, ll.insert, 0, 'abc')
+
+    def test_remove(self):
+        ref = py23_range(0, 1024, 4) * 2
+        ll = ullist(ref, 4)
+        for val in py23_range(0, 1024, 8):
+            ll.remove(val)
+            ref.remove(val)
+        self.assertEqual(list(ll), ref)
+        self.assertRaises(ValueError, ll.remove, 1)
+
+    def test_getitem(self):
+        ref = py23_range(0, 1024, 4)
+        ll = ullist(ref, 5)
+        for idx in py23_xrange(len(ref)):
+            self.assertEqual(ll[idx], ref[idx])
+        for idx in py23_xrange(-1, -len(ref) - 1, -1):
+            self.assertEqual(ll[idx], ref[idx])
+        self.assertRaises(IndexError, ll.__getitem__, len(ref))
+        self.assertRaises(TypeError, ll.__getitem__, None)
+
+    def test_setitem_and_delitem(self):
+        ref = py23_range(0, 1024, 4)
+        ll = ullist(ref, 5)
+        ll[10] = 'abc'
+        ref[10] = 'abc'
+        ll[-1] = 'def'
+        ref[-1] = 'def'
+        del ll[0]
+        del ref[0]
+        del ll[50]
+        del ref[50]
+        self.assertEqual(list(ll), ref)
+        self.assertRaises(IndexError, ll.__setitem__, len(ref), 0)
+        self.assertRaises(IndexError, ll.__delitem__, len(ref))
+
+    def test_extend(self):
+        a_ref = py23_range(0, 1024, 4)
+        b_ref = py23_range(8092, 8092 + 1024, 4)
+        ll = ullist(a_ref, 4)
+        ll.extend(b_ref)
+        self.assertEqual(list(ll), a_ref + b_ref)
+        ll = ullist(a_ref, 4)
+        ll.extendright(ullist(b_ref))
+        self.assertEqual(list(ll), a_ref + b_ref)
+        ll = ullist(a_ref, 4)
+        ll.extendleft(b_ref)
+        self.assertEqual(list(ll), list(reversed(b_ref)) + a_ref)
+        ll = ullist(a_ref, 4)
+        ll.extend(ll)
+        self.assertEqual(list(ll), a_ref + a_ref)
+        ll.extendleft(x for x in b_ref)
+        self.assertEqual(list(ll),
+                         list(reversed(b_ref)) + a_ref + a_ref)
+
+    def test_rotate(self):
+        ref = py23_range(0, 100)
+        for n in [0, 1, 3, 50, 99, 100, 101, -1, -7, -100, -250]:
+            ll = ullist(ref, 8)
+            ll.rotate(n)
+            k = n % len(ref)
+            self.assertEqual(list(ll), ref[-k:] + ref[:-k] if k else ref)
+        ll = ullist()
+        ll.rotate(10)
+        self.assertEqual(list(ll), [])
+
+    def test_concat_and_repeat(self):
+        a_ref = py23_range(0, 100)
+        b_ref = py23_range(100, 150)
+        a = ullist(a_ref, 8)
+        b = ullist(b_ref, 4)
+        c = a + b
+        self.assertEqual(list(c), a_ref + b_ref)
+        self.assertEqual(c.chunksize, 8)
+        a += b
+        self.assertEqual(list(a), a_ref + b_ref)
+        d = b * 3
+        self.assertEqual(list(d), b_ref * 3)
+        self.assertEqual(d.chunksize, 4)
+        self.assertEqual(list(b * 0), [])
+
+    def test_readonly_attributes(self):
+        if sys.hexversion >= 0x03000000:
+            expected_error = AttributeError
+        else:
+            expected_error = TypeError
+
+        ll = ullist()
+        self.assertRaises(expected_error, setattr, ll, 'size', 10)
+        self.assertRaises(expected_error, setattr, ll, 'chunksize', 10)
+
+    def test_list_hash(self):
+        self.assertEqual(hash(ullist()), hash(ullist()))
+        self.assertEqual(hash(ullist(py23_range(0, 1024, 4), 4)),
+            hash(ullist(py23_range(0, 1024, 4), 8)))
+        self.assertEqual(hash(ullist([0, 2])), hash(ullist([0.0, 2.0])))
+
+    def test_typecode(self):
+        self.assertEqual(ullist().typecode, None)
+        self.assertRaises(ValueError, ullist, typecode='x')
+        self.assertRaises(ValueError, ullist, typecode='qd')
+
+        ll = ullist(py23_range(0, 100), 4, 'q')
+        self.assertEqual(ll.typecode, 'q')
+        self.assertEqual(list(ll), py23_range(0, 100))
+        ll.append(2 ** 62)
+        ll.appendleft(-2 ** 62)
+        ll.insert(True, 50)
+        ll[1] = 7
+        self.assertEqual(ll.pop(), 2 ** 62)
+        self.assertEqual(ll.popleft(), -2 ** 62)
+        self.assertEqual(ll[0], 7)
+        self.assertEqual(ll[49], 1)
+        ll.remove(7)
+        del ll[48]
+        self.assertEqual(list(ll), py23_range(1, 100))
+        self.assertEqual(ll, ullist(py23_range(1, 100)))
+        self.assertRaises(OverflowError, ll.append, 2 ** 63)
+        self.assertRaises(TypeError, ll.append, 1.5)
+        self.assertRaises(TypeError, ll.__setitem__, 0, '1')
+        self.assertEqual(len(ll), 99)
+        self.assertEqual((ll + [5]).typecode, 'q')
+        self.assertEqual((ll * 2).typecode, 'q')
+        self.assertRaises(ValueError, ll.__init__, typecode='d')
+
+        ll = ullist([1, 2.5], typecode='d')
+        ll.extend([3, -0.5])
+        self.assertEqual(list(ll), [1.0, 2.5, 3.0, -0.5])
+        self.assertEqual(str(ll), 'ullist([1.0, 2.5, 3.0, -0.5])')
+        self.assertEqual(hash(ll), hash(ullist([1, 2.5, 3, -0.5])))
+        self.assertRaises(TypeError, ll.append, 'abc')
+        self.assertEqual(len(ll), 4)
+
+    def test_reductions(self):
+        ll = ullist(py23_range(1, 101))
+        self.assertEqual(ll.sum(), 5050)
+        self.assertEqual(ll.min(), 1)
+        self.assertEqual(ll.max(), 100)
+        self.assertEqual(ll.mean(), 50.5)
+        ll = ullist([3, 2 ** 63, -1.5, 2 ** 64])
+        self.assertEqual(ll.sum(), sum([3, 2 ** 63, -1.5, 2 ** 64]))
+        self.assertEqual(ll.min(), -1.5)
+        self.assertEqual(ll.max(), 2 ** 64)
+        ll = ullist([2 ** 62, 2 ** 62, 2 ** 62])
+        self.assertEqual(ll.sum(), 3 * 2 ** 62)
+        self.assertEqual(ll.mean(), 2.0 ** 62)
+        ll = ullist(['b', 'c', 'a'])
+        self.assertEqual(ll.min(), 'a')
+        self.assertEqual(ll.max(), 'c')
+        self.assertRaises(TypeError, ll.sum)
+        self.assertEqual(ullist().sum(), 0)
+        self.assertRaises(ValueError, ullist().min)
+        self.assertRaises(ValueError, ullist().max)
+        self.assertRaises(ValueError, ullist().mean)
+
+        class Modifying(object):
+            def __radd__(other, value):
+                ll.clear()
+                return value
+            def __lt__(other, value):
+                ll.clear()
+                return False
+        ll = ullist([1, Modifying(), 2])
+        self.assertRaises(RuntimeError, ll.sum)
+        ll = ullist([1, Modifying(), 2])
+        self.assertRaises(RuntimeError, ll.min)
+
+    def test_typed_reductions(self):
+        ll = ullist(py23_range(-50, 51), 4, 'q')
+        self.assertEqual(ll.sum(), 0)
+        self.assertEqual(ll.min(), -50)
+        self.assertEqual(ll.max(), 50)
+        self.assertEqual(ll.mean(), 0.0)
+        ll = ullist([2 ** 63 - 1] * 10, 4, 'q')
+        self.assertEqual(ll.sum(), (2 ** 63 - 1) * 10)
+        ll.extend([-2 ** 63] * 10)
+        self.assertEqual(ll.sum(), -10)
+        self.assertEqual(ll.min(), -2 ** 63)
+        ll = ullist([x / 4.0 for x in py23_range(0, 101)], 4, 'd')
+        self.assertEqual(ll.sum(), 1262.5)
+        self.assertEqual(ll.min(), 0.0)
+        self.assertEqual(ll.max(), 25.0)
+        self.assertEqual(ll.mean(), 12.5)
+        self.assertEqual(ullist(typecode='d').sum(), 0)
+        self.assertRaises(ValueError, ullist(typecode='q').min)
+        self.assertRaises(ValueError, ullist(typecode='d').mean)
+
+
+class testlrucache(unittest.TestCase):
+
+    def test_init(self):
+        cache = lrucache()
+        self.assertEqual(cache.maxsize, 128)
+        self.assertEqual(len(cache), 0)
+        self.assertEqual(lrucache(maxsize=2).maxsize, 2)
+        self.assertRaises(ValueError, lrucache, 0)
+        self.assertRaises(TypeError, lrucache, 2, 1)
+
+    def test_get_put(self):
+        cache = lrucache(3)
+        for key in py23_xrange(0, 3):
+            cache.put(key, str(key))
+        self.assertEqual(cache.items(), [(2, '2'), (1, '1'), (0, '0')])
+        self.assertEqual(cache.get(0), '0')
+        self.assertEqual(cache.get(5), None)
+        self.assertEqual(cache.get(5, 'x'), 'x')
+        self.assertEqual(cache.hits, 1)
+        self.assertEqual(cache.misses, 2)
+        cache.put(3, '3')
+        self.assertEqual(cache.items(), [(3, '3'), (0, '0'), (2, '2')])
+        cache.put(2, 'two')
+        self.assertEqual(cache.items(), [(2, 'two'), (3, '3'), (0, '0')])
+        self.assertRaises(TypeError, cache.put, [], 1)
+        self.assertRaises(TypeError, cache.get, [])
+        self.assertEqual(len(cache), 3)
+
+    def test_peek(self):
+        cache = lrucache(2)
+        cache.put(1, 'a')
+        cache.put(2, 'b')
+        self.assertEqual(cache.peek(1), 'a')
+        self.assertEqual(cache.peek(3, 'x'), 'x')
+        self.assertEqual(cache.items(), [(2, 'b'), (1, 'a')])
+        self.assertEqual(cache.hits, 0)
+        self.assertEqual(cache.misses, 0)
+        self.assertTrue(1 in cache)
+        self.assertFalse(3 in cache)
+
+    def test_pop(self):
+        cache = lrucache(4)
+        for key in py23_xrange(0, 4):
+            cache[key] = key * 10
+        self.assertEqual(cache.pop(2), 20)
+        self.assertEqual(cache.pop(2, None), None)
+        self.assertRaises(KeyError, cache.pop, 2)
+        del cache[0]
+        self.assertRaises(KeyError, cache.__delitem__, 0)
+        self.assertEqual(cache.items(), [(3, 30), (1, 10)])
+        self.assertEqual(cache[1], 10)
+        self.assertRaises(KeyError, cache.__getitem__, 0)
+        self.assertEqual(cache.items(), [(1, 10), (3, 30)])
+        cache.clear()
+        self.assertEqual(len(cache), 0)
+        self.assertEqual(cache.items(), [])
+
+    def test_eviction(self):
+        evicted = []
+        cache = lrucache(100, lambda key, value: evicted.append(key))
+        for key in py23_xrange(0, 1000):
+            cache.put(key, key)
+            cache.get(0)
+        self.assertEqual(len(cache), 100)
+        self.assertEqual(evicted, py23_range(1, 901))
+        self.assertEqual(cache.peek(0), 0)
+        for key in py23_xrange(901, 1000):
+            cache.pop(key)
+        self.assertEqual(cache.items(), [(0, 0)])
+
+    def test_modification_during_lookup(self):
+        cache = lrucache()
+
+        class Key(object):
+            def __hash__(self):
+                return 0
+
+            def __eq__(self, other):
+                cache.clear()
+                return False
+        cache.put(Key(), 1)
+        self.assertRaises(RuntimeError, cache.get, Key())
+
+
+class testfreelist(unittest.TestCase):
+
+    def setUp(self):
+        self.saved_limit = llist.getfreelistlimit()
+
+    def tearDown(self):
+        llist.setfreelistlimit(self.saved_limit)
+
+    def test_set_limit(self):
+        llist.setfreelistlimit(16)
+        self.assertEqual(llist.getfreelistlimit(), 16)
+        self.assertRaises(TypeError, llist.setfreelistlimit, None)
+        self.assertRaises(TypeError, llist.setfreelistlimit, 'abc')
+        self.assertRaises(ValueError, llist.setfreelistlimit, -1)
+        self.assertEqual(llist.getfreelistlimit(), 16)
+
+    def test_trim(self):
+        llist.setfreelistlimit(16)
+        llist.trimfreelists()
+        dllist(py23_xrange(100)).clear()
+        sllist(py23_xrange(100)).clear()
+        self.assertEqual(llist.trimfreelists(), 32)
+        self.assertEqual(llist.trimfreelists(), 0)
+
+    def test_zero_limit(self):
+        llist.setfreelistlimit(0)
+        dllist(py23_xrange(100)).clear()
+        sllist(py23_xrange(100)).clear()
+        self.assertEqual(llist.trimfreelists(), 0)
+
+    def test_reuse_nodes(self):
+        llist.setfreelistlimit(16)
+        ll = dllist(py23_xrange(16))
+        for i in py23_xrange(1024):
+            ll.append(ll.popleft())
+        self.assertEqual(list(ll), py23_range(16))
+        ll = sllist(py23_xrange(16))
+        for i in py23_xrange(1024):
+            ll.append(ll.popleft())
+        self.assertEqual(list(ll), py23_range(16))
+        node = dllistnode(10)
+        self.assertEqual(node.value, 10)
+        self.assertEqual(node.prev, None)
+        self.assertEqual(node.next, None)
+        node = sllistnode(10)
+        self.assertEqual(node.value, 10)
+        self.assertEqual(node.next, None)
+
 
 def suite():
     suite = unittest.TestSuite()
     suite.addTest(unittest.makeSuite(testsllist))
     suite.addTest(unittest.makeSuite(testdllist))
+    suite.addTest(unittest.makeSuite(testullist))
+    suite.addTest(unittest.makeSuite(testlrucache))
+    suite.addTest(unittest.makeSuite(testfreelist))
     return suite
 
 
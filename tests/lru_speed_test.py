@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+from collections import OrderedDict
+from llist import lrucache
+import functools
+import random
+import sys
+import time
+
+num = 100000
+if len(sys.argv) > 1:
+    num = int(sys.argv[1])
+
+maxsize = 1000
+random.seed(0)
+keys = [random.randint(0, 2 * maxsize) for i in range(num)]
+
+
+def compute(key):
+    return key
+
+
+def ordereddict_cache():
+    cache = OrderedDict()
+    for key in keys:
+        try:
+            value = cache[key]
+            cache.move_to_end(key)
+        except KeyError:
+            value = compute(key)
+            cache[key] = value
+            if len(cache) > maxsize:
+                cache.popitem(last=False)
+
+
+def functools_cache():
+    cached = functools.lru_cache(maxsize)(compute)
+    for key in keys:
+        cached(key)
+
+
+def llist_cache():
+    cache = lrucache(maxsize)
+    get = cache.get
+    put = cache.put
+    for key in keys:
+        value = get(key)
+        if value is None:
+            value = compute(key)
+            put(key, value)
+
+
+for operation in [ordereddict_cache, functools_cache, llist_cache]:
+    start = time.time()
+    operation()
+    elapsed = time.time() - start
+    print("Completed %s in \t\t%.8f seconds:\t %.1f ops/sec" % (
+        operation.__name__,
+        elapsed,
+        num / elapsed))
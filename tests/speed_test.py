@@ -1,12 +1,15 @@
 #!/usr/bin/env python
 # -*- coding: utf-8 -*-
 from collections import deque
-from llist import sllist, dllist
+from llist import sllist, dllist, ullist
+import sys
 import time
 # import gc
 # gc.set_debug(gc.DEBUG_UNCOLLECTABLE | gc.DEBUG_STATS)
 
 num = 10000
+if len(sys.argv) > 1:
+    num = int(sys.argv[1])
 
 
 def append(c):
@@ -19,18 +22,28 @@ def appendleft(c):
         c.appendleft(i)
 
 
+def extend(c):
+    c.extend(range(num))
+
+
 def pop(c):
     for i in range(num):
         c.pop()
 
 
 def popleft(c):
-    if isinstance(c, deque):
-        for i in range(num):
-            c.popleft()
-    else:
-        for i in range(num):
-            c.pop()
+    for i in range(num):
+        c.popleft()
+
+
+def iterate(c):
+    for x in c:
+        pass
+
+
+def getitem(c):
+    for i in range(num):
+        c[i]
 
 
 def remove(c):
@@ -41,14 +54,49 @@ def remove(c):
             pass
 
 
-for container in [deque, dllist, sllist]:
-    for operation in [append, appendleft, pop, popleft, remove]:
+def insert(c):
+    node = c.first
+    if isinstance(c, dllist):
+        insert_value = c.insert
+    else:
+        insert_value = c.insertbefore
+    for i in range(num):
+        insert_value(i, node)
+
+
+def create_iter(c):
+    short = type(c)([0])
+    for i in range(num):
+        iter(short)
+
+
+def create_node(c):
+    node_type = type(c.first)
+    for i in range(num):
+        node_type(i)
+
+
+for container in [deque, dllist, sllist, ullist]:
+    for operation in [append, appendleft, extend, pop, popleft, iterate,
+                      getitem, remove]:
+        c = container(range(num))
+        start = time.time()
+        operation(c)
+        elapsed = time.time() - start
+        print("Completed %s/%s in \t\t%.8f seconds:\t %.1f ops/sec" % (
+            container.__name__,
+            operation.__name__,
+            elapsed,
+            num / elapsed))
+
+for container in [dllist, sllist]:
+    for operation in [insert, create_iter, create_node]:
         c = container(range(num))
         start = time.time()
         operation(c)
         elapsed = time.time() - start
-        print "Completed %s/%s in \t\t%.8f seconds:\t %.1f ops/sec" % (
+        print("Completed %s/%s in \t\t%.8f seconds:\t %.1f ops/sec" % (
             container.__name__,
             operation.__name__,
             elapsed,
-            num / elapsed)
+            num / elapsed))